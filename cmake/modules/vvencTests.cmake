@@ -18,9 +18,15 @@ add_test( NAME Test_vvenclibtest-input_params            COMMAND vvenclibtest 3
 add_test( NAME Test_vvenclibtest-sdk_default             COMMAND vvenclibtest 4 )
 add_test( NAME Test_vvenclibtest-sdk_stringapi_interface COMMAND vvenclibtest 5 )
 add_test( NAME Test_vvenclibtest-timestamps              COMMAND vvenclibtest 6 )
+add_test( NAME Test_vvenclibtest-lent_input_buffers      COMMAND vvenclibtest 7 )
+add_test( NAME Test_vvenclibtest-segment_encoding        COMMAND vvenclibtest 8 )
+add_test( NAME Test_vvenclibtest-reconfig                COMMAND vvenclibtest 9 )
+add_test( NAME Test_vvenclibtest-async                   COMMAND vvenclibtest 10 )
+add_test( NAME Test_vvenclibtest-cpu_budget              COMMAND vvenclibtest 11 )
 
 if( NOT BUILD_SHARED_LIBS )
   add_test( NAME Test_vvenc_unit_test COMMAND vvenc_unit_test --fast )
+  add_test( NAME Test_vvenc_unit_test-bench COMMAND vvenc_unit_test --bench --bench-warmup 0 --bench-runs 1 --bench-format csv )
 endif()
 
 set( CLEANUP_TEST_FILES "" )
@@ -64,6 +70,36 @@ add_vvenc_test( vvencapp-medium       30 OUT_VVC   ""                       vven
 add_vvenc_test( vvencFFapp-medium     30 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 5 --Threads=-1 -b OUTPUT )
 add_vvenc_test( compare_output-medium 30 NO_OUTPUT "${OUT_VVC};${OUTF_VVC}" ${CMAKE_COMMAND} -E compare_files ${OUT_VVC} ${OUTF_VVC} )
 
+add_vvenc_test( vvencFFapp-medium_workstealing     30 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 5 --Threads=-1 --WorkStealing=1 -b OUTPUT )
+add_vvenc_test( compare_output-medium_workstealing 30 NO_OUTPUT "${OUT_VVC};${OUTF_VVC}" ${CMAKE_COMMAND} -E compare_files ${OUT_VVC} ${OUTF_VVC} )
+
+add_vvenc_test( vvencFFapp-medium_mmap_readahead     30 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 5 --Threads=-1 --mmap=1 --readahead=4 -b OUTPUT )
+add_vvenc_test( compare_output-medium_mmap_readahead 30 NO_OUTPUT "${OUT_VVC};${OUTF_VVC}" ${CMAKE_COMMAND} -E compare_files ${OUT_VVC} ${OUTF_VVC} )
+
+add_vvenc_test( vvencFFapp-medium_mctf_mvhints 30 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 9 --Threads=-1 --MCTFMvHints=1 -b OUTPUT )
+
+add_vvenc_test( vvencFFapp-medium_cutree      30 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 15 --Threads=-1 --CuTree=8 -b OUTPUT )
+
+add_vvenc_test( vvencFFapp-faster_fga         30 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_faster.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 15 --Threads=-1 --fga=1 -b OUTPUT )
+
+add_vvenc_test( vvencFFapp-faster_noalf            30 OUT_VVC   ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_faster.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 8 --Threads=-1 --WaveFrontSynchro=1 --ALF=0 --CCALF=0 -b OUTPUT )
+add_vvenc_test( vvencFFapp-faster_lowlatency       30 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_faster.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 8 --Threads=-1 --WaveFrontSynchro=1 --ALF=0 --CCALF=0 --LowLatencyOutput=1 -b OUTPUT )
+add_vvenc_test( compare_output-faster_lowlatency   30 NO_OUTPUT "${OUT_VVC};${OUTF_VVC}" ${CMAKE_COMMAND} -E compare_files ${OUT_VVC} ${OUTF_VVC} )
+
+add_vvenc_test( vvencFFapp-medium_hashme           30 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 9 --Threads=-1 --IFP=0 --HashME=2 -b OUTPUT )
+
+add_vvenc_test( vvencFFapp-medium_noifp            30 OUT_VVC   ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 5 --Threads=-1 --IFP=0 -b OUTPUT )
+add_vvenc_test( vvencFFapp-medium_subpelplanes     30 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 5 --Threads=-1 --IFP=0 --SubPelPlanes=2 -b OUTPUT )
+add_vvenc_test( compare_output-medium_subpelplanes 30 NO_OUTPUT "${OUT_VVC};${OUTF_VVC}" ${CMAKE_COMMAND} -E compare_files ${OUT_VVC} ${OUTF_VVC} )
+add_vvenc_test( vvencFFapp-medium_renditions      30 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 5 --Threads=-1 --IFP=0 --RenditionWidth=40,56 --RenditionHeight=22,32 --RenditionFilter=2 -b OUTPUT )
+add_vvenc_test( compare_output-medium_renditions  30 NO_OUTPUT "${OUT_VVC};${OUTF_VVC}" ${CMAKE_COMMAND} -E compare_files ${OUT_VVC} ${OUTF_VVC} )
+
+add_vvenc_test( vvencFFapp-faster_checkpoint_ref    30 OUT_VVC   ""                                   vvencFFapp -c ${CFG_DIR}/randomaccess_faster.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 15 --GOPSize=16 --IntraPeriod=8 --DecodingRefreshType=6 --Threads=-1 --ReconFile= -b OUTPUT )
+add_vvenc_test( vvencFFapp-faster_checkpoint        30 OUTF_VVC  ""                                   vvencFFapp -c ${CFG_DIR}/randomaccess_faster.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 15 --GOPSize=16 --IntraPeriod=8 --DecodingRefreshType=6 --Threads=-1 --ReconFile= --CheckpointFile=checkpoint.bin -b OUTPUT )
+add_vvenc_test( vvencFFapp-faster_checkpoint_resume 30 NO_OUTPUT "${OUTF_VVC}"                        vvencFFapp -c ${CFG_DIR}/randomaccess_faster.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 15 --GOPSize=16 --IntraPeriod=8 --DecodingRefreshType=6 --Threads=-1 --ReconFile= --CheckpointFile=checkpoint.bin --CheckpointResume=1 -b ${OUTF_VVC} )
+set_tests_properties( Test_vvencFFapp-faster_checkpoint_resume PROPERTIES FIXTURES_SETUP checkpoint_resume )
+add_vvenc_test( compare_output-faster_checkpoint    30 NO_OUTPUT "${OUT_VVC};${OUTF_VVC};checkpoint_resume" ${CMAKE_COMMAND} -E compare_files ${OUT_VVC} ${OUTF_VVC} )
+
 add_vvenc_test( vvencapp-slow       90 OUT_VVC   ""                       vvencapp --preset slow -s 80x44 -r 15 -i ${TEST_YUV} -ip 32 -f 3 --mtprofile 0 -o OUTPUT )
 add_vvenc_test( vvencFFapp-slow     90 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_slow.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 3 --Threads=-1 -b OUTPUT )
 add_vvenc_test( compare_output-slow 30 NO_OUTPUT "${OUT_VVC};${OUTF_VVC}" ${CMAKE_COMMAND} -E compare_files ${OUT_VVC} ${OUTF_VVC} )
@@ -82,9 +118,13 @@ add_vvenc_test( vvencFFapp-medium_rc2p_statsFile1_exp    30 OUTF_VVC  ""
 add_vvenc_test( vvencFFapp-medium_rc2p_statsFile2_exp    30 OUTF_VVC  "${OUTF_VVC}"            vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 5 --TargetBitrate=10000 --Pass=2 --RCStatsFile=stats_exp.json --Threads=-1 -b OUTPUT )
 add_vvenc_test( compare_output-medium_rc2p_statsFile_exp 30 NO_OUTPUT "${OUT_VVC};${OUTF_VVC}" ${CMAKE_COMMAND} -E compare_files ${OUT_VVC} ${OUTF_VVC} )
 
+add_vvenc_test( vvencFFapp-medium_rc2p_statsFile1_bin    30 OUTF_VVC  ""                       vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 5 --TargetBitrate=10000 --Pass=1 --RCStatsFile=stats_exp.bin --Threads=-1 -b OUTPUT )
+add_vvenc_test( vvencFFapp-medium_rc2p_statsFile2_bin    30 OUTF_VVC  "${OUTF_VVC}"            vvencFFapp -c ${CFG_DIR}/randomaccess_medium.cfg -c ${TEST_CFG} -i ${TEST_YUV} -f 5 --TargetBitrate=10000 --Pass=2 --RCStatsFile=stats_exp.bin --Threads=-1 -b OUTPUT )
+add_vvenc_test( compare_output-medium_rc2p_statsFile_bin 30 NO_OUTPUT "${OUT_VVC};${OUTF_VVC}" ${CMAKE_COMMAND} -E compare_files ${OUT_VVC} ${OUTF_VVC} )
+
 add_vvenc_test( vvencapp-medium_rc2p_statsFile1_easy      30 OUT_VVC   ""                       vvencapp --preset medium -s 80x44 -r 15 -i ${TEST_YUV} -ip 32 -f 5 --Bitrate=10000 --Pass=1 --RCStatsFile=stats_easy.json --mtprofile 0 -o OUTPUT )
 add_vvenc_test( vvencapp-medium_rc2p_statsFile2_easy      30 OUT_VVC   "${OUT_VVC}"             vvencapp --preset medium -s 80x44 -r 15 -i ${TEST_YUV} -ip 32 -f 5 --Bitrate=10000 --Pass=2 --RCStatsFile=stats_easy.json --mtprofile 0 -o OUTPUT )
 add_vvenc_test( compare_output-medium_rc2p_statsFile_easy 30 NO_OUTPUT "${OUT_VVC};${OUTF_VVC}" ${CMAKE_COMMAND} -E compare_files ${OUT_VVC} ${OUTF_VVC} )
 
-add_test( NAME Cleanup_remove_temp_files COMMAND ${CMAKE_COMMAND} -E remove -f ${CLEANUP_TEST_FILES} rec.yuv stats_exp.json stats_easy.json )
+add_test( NAME Cleanup_remove_temp_files COMMAND ${CMAKE_COMMAND} -E remove -f ${CLEANUP_TEST_FILES} out_vvencFFapp-medium_renditions_r1.vvc out_vvencFFapp-medium_renditions_r2.vvc rec.yuv stats_exp.json stats_exp.bin stats_easy.json checkpoint.bin )
 set_tests_properties( Cleanup_remove_temp_files PROPERTIES FIXTURES_CLEANUP cleanup )
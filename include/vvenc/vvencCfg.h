@@ -85,6 +85,7 @@ typedef void (*vvencLoggingCallback)(void*, int, const char*, va_list);
 #define VVENC_MAX_NUM_COMP                    3      // max number of components
 #define VVENC_MAX_QP_VALS_CHROMA              8      // max number qp vals in array
 #define VVENC_MAX_MCTF_FRAMES                 16
+#define VVENC_MAX_RENDITIONS                  4      // max. number of additional downscaled renditions encoded from the shared pre-analysis
 #define VVENC_MAX_STRING_LEN                  1024   // max length of string/filename
 #define VVENC_DEFAULT_QP                      32     // default base QP
 #define VVENC_AUTO_QP                        -1      // indicates to use default QP, or ignore if RC is used
@@ -787,6 +788,22 @@ typedef struct vvenc_config
   int                 m_minIntraDist;
   int8_t              m_numParallelGOPs;
   int8_t              m_maxDeltaQP;
+  bool                m_tpWorkStealing;                                                  // thread pool: use per-thread task queues with work stealing instead of a single shared task queue
+  bool                m_numaAware;                                                       // pin worker threads to NUMA nodes, keep picture encoders node local and interleave shared picture buffers (Linux only)
+  bool                m_mctfMvHints;                                                     // keep the MCTF motion field per picture and use it as start candidate for the integer motion search
+  int                 m_cuTree;                                                          // CU-tree QP propagation over a look-ahead window of this many frames, replaces the BIM QP offsets (0: off)
+  int                 m_hashME;                                                          // hash based motion search for exact block matches (0: off, 1: screen content pictures, 2: all pictures)
+  bool                m_lowLatencyOutput;                                                // write CTU lines inside the CTU tasks as soon as they are final and output access units without stage parallel hold-back (requires ALF off)
+  int                 m_subPelPlanes;                                                    // precomputed sub-pel planes of the reference pictures for the fractional motion search (0: off, 1: half-pel, 2: half- and quarter-pel)
+  int                 m_numRenditions;                                                   // number of additional downscaled renditions encoded from the shared pre-analysis stages (0: off)
+  int                 m_renditionWidth[ VVENC_MAX_RENDITIONS ];                          // source width of each rendition
+  int                 m_renditionHeight[ VVENC_MAX_RENDITIONS ];                         // source height of each rendition
+  int                 m_renditionQP[ VVENC_MAX_RENDITIONS ];                             // QP of each rendition (-1: use m_QP)
+  int                 m_renditionFilter;                                                 // resampling filter generating the renditions from the source (0: box, dyadic sizes only, 1: bicubic, 2: lanczos3)
+  char                m_checkpointFile[VVENC_MAX_STRING_LEN];                            // checkpoint file, written at each IDR picture in the final pass to allow resuming an interrupted encoding (empty: off)
+  bool                m_checkpointResume;                                                // resume encoding from the state stored in the checkpoint file
+  bool                m_adaptiveThreads;                                                 // adapt the number of active worker threads and parallel frames to the real-time frame rate, limited by the CPU budget
+  bool                m_qualityMetrics;                                                  // compute luma SSIM, MS-SSIM and the VMAF like features VIF and detail preservation of each picture in the CTU tasks
 
   int8_t              m_reservedInt8[2];
   double              m_reservedDouble[8];
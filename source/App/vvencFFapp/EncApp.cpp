@@ -222,7 +222,17 @@ int EncApp::encode()
     msgApp( VVENC_INFO, " trying to read from stdin" );
   }
 
-  if( ! openFileIO() )
+  // restart position, when resuming an interrupted encoding
+  vvencCheckpointInfo checkpointInfo;
+  vvenc_get_checkpoint_info( m_encCtx, &checkpointInfo );
+  if( vvencCfg.m_checkpointResume && ! appCfg.m_reconFileName.empty() )
+  {
+    msgApp( VVENC_ERROR, "reconstruction file not supported when resuming from a checkpoint\n" );
+    vvenc_encoder_close( m_encCtx );
+    return -1;
+  }
+
+  if( ! openFileIO( checkpointInfo ) )
   {
     vvenc_encoder_close( m_encCtx );
     return -1;
@@ -246,12 +256,13 @@ int EncApp::encode()
 
   // main loop
   int64_t framesRcvd  = 0;
-  const int start = vvencCfg.m_RCPass > 0 ? vvencCfg.m_RCPass - 1 : 0;
+  const int start = std::max( vvencCfg.m_RCPass > 0 ? vvencCfg.m_RCPass - 1 : 0, checkpointInfo.pass );
   const int end   = vvencCfg.m_RCPass > 0 ? vvencCfg.m_RCPass     : vvencCfg.m_RCNumPasses;
   for( int pass = start; pass < end; pass++ )
   {
     // open input YUV
-
+    m_yuvInputFile.setMemoryMapping( appCfg.m_mmapInput );
+    m_yuvInputFile.setReadAhead( appCfg.m_inputReadAhead );
     if( m_yuvInputFile.open( appCfg.m_inputFileName, false, vvencCfg.m_inputBitDepth[0], vvencCfg.m_MSBExtendedBitDepth[0], vvencCfg.m_internalBitDepth[0],
                              appCfg.m_inputFileChromaFormat, vvencCfg.m_internChromaFormat, appCfg.m_bClipInputVideoToRec709Range, appCfg.m_packedYUVInput,
                              appCfg.m_forceY4mInput, appCfg.m_logoFileName ))
@@ -264,7 +275,7 @@ int EncApp::encode()
       return -1;
     }
 
-    const int remSkipFrames = appCfg.m_FrameSkip - vvencCfg.m_leadFrames;
+    const int remSkipFrames = appCfg.m_FrameSkip - vvencCfg.m_leadFrames + checkpointInfo.firstInputFrame;
     if( remSkipFrames < 0 )
     {
       msgApp( VVENC_ERROR, "\nskip frames (%d) less than number of lead frames required (%d)\n", appCfg.m_FrameSkip, vvencCfg.m_leadFrames );
@@ -305,15 +316,16 @@ int EncApp::encode()
 
     apputils::Stats cStats;
     int64_t frameCount =  apputils::VVEncAppCfg::getFrameCount( appCfg.m_inputFileName, vvencCfg.m_SourceWidth, vvencCfg.m_SourceHeight, vvencCfg.m_internChromaFormat, vvencCfg.m_inputBitDepth[0], appCfg.m_packedYUVInput );
-    frameCount = std::max<int64_t>( 0, frameCount-appCfg.m_FrameSkip );
-    int64_t framesToEncode = (vvencCfg.m_framesToBeEncoded == 0 || vvencCfg.m_framesToBeEncoded >= frameCount) ? frameCount : vvencCfg.m_framesToBeEncoded;
+    frameCount = std::max<int64_t>( 0, frameCount-appCfg.m_FrameSkip-checkpointInfo.firstFrame );
+    const int64_t framesRemaining = vvencCfg.m_framesToBeEncoded - checkpointInfo.firstFrame;
+    int64_t framesToEncode = (vvencCfg.m_framesToBeEncoded == 0 || framesRemaining >= frameCount) ? frameCount : framesRemaining;
     cStats.init( vvencCfg.m_FrameRate, vvencCfg.m_FrameScale, (int)framesToEncode, vvencCfg.m_verbosity, "vvenc [info]: " );
     bool statsInfoReady = false;
 
     // loop over input YUV data
     bool inputDone  = false;
     bool encDone    = false;
-         framesRcvd = 0;
+         framesRcvd = checkpointInfo.firstInputFrame;
     while( ! inputDone || ! encDone )
     {
       // check for more input pictures
@@ -372,7 +384,7 @@ int EncApp::encode()
           return -1;
         }
 
-        if( appCfg.m_printStats )
+        if( appCfg.m_printStats && au.rendition == 0 )
         {
           cStats.addAU( &au, &statsInfoReady );
           if( statsInfoReady )
@@ -410,6 +422,17 @@ int EncApp::encode()
 
 int EncApp::outputAU( const vvencAccessUnit& au )
 {
+  if( au.rendition > 0 )
+  {
+    std::fstream& bitstream = m_renditionBitstreams[ au.rendition - 1 ];
+    if( bitstream.is_open() )
+    {
+      bitstream.write( reinterpret_cast<const char*>( au.payload ), au.payloadUsedSize );
+      bitstream.flush();
+    }
+    return bitstream.fail() ? -1 : 0;
+  }
+
   m_bitstream.write(reinterpret_cast<const char*>(au.payload), au.payloadUsedSize);
   if( m_bitstream.fail() )
   {
@@ -442,7 +465,7 @@ void EncApp::outputYuv( void* ctx, vvencYUVBuffer* yuvOutBuf )
 // protected member functions
 // ====================================================================================================================
 
-bool EncApp::openFileIO()
+bool EncApp::openFileIO( const vvencCheckpointInfo& checkpointInfo )
 {
   // output YUV
   if( ! m_cEncAppCfg.m_reconFileName.empty() )
@@ -458,12 +481,32 @@ bool EncApp::openFileIO()
   // output bitstream
   if ( !m_cEncAppCfg.m_bitstreamFileName.empty() )
   {
-    m_bitstream.open( m_cEncAppCfg.m_bitstreamFileName.c_str(), fstream::binary | fstream::out );
+    // a resumed encoding continues the bitstream of the interrupted encoding at the checkpoint position
+    const bool resume = m_vvenc_config.m_checkpointResume;
+    if( resume && ! apputils::FileIOHelper::truncateFile( m_cEncAppCfg.m_bitstreamFileName, checkpointInfo.bitstreamSize ) )
+    {
+      msgApp( VVENC_ERROR, "vvencFFapp [error]: bitstream file %s does not contain the data up to the checkpoint\n", m_cEncAppCfg.m_bitstreamFileName.c_str() );
+      return false;
+    }
+    m_totalBytes = (unsigned)checkpointInfo.bitstreamSize;
+    m_bitstream.open( m_cEncAppCfg.m_bitstreamFileName.c_str(), fstream::binary | fstream::out | ( resume ? fstream::app : fstream::openmode() ) );
     if( ! m_bitstream )
     {
       msgApp( VVENC_ERROR, "vvencFFapp [error]: open bitstream file failed\n" );
       return false;
     }
+
+    // additional renditions
+    for( int i = 0; i < m_vvenc_config.m_numRenditions; i++ )
+    {
+      const std::string fileName = apputils::FileIOHelper::getRenditionFileName( m_cEncAppCfg.m_bitstreamFileName, i + 1 );
+      m_renditionBitstreams[ i ].open( fileName.c_str(), fstream::binary | fstream::out );
+      if( ! m_renditionBitstreams[ i ] )
+      {
+        msgApp( VVENC_ERROR, "vvencFFapp [error]: open bitstream file %s failed\n", fileName.c_str() );
+        return false;
+      }
+    }
   }
 
   return true;
@@ -475,6 +518,10 @@ void EncApp::closeFileIO()
   if ( ! m_cEncAppCfg.m_reconFileName.empty() )
     m_yuvReconFile.close();
   m_bitstream.close();
+  for( auto& bitstream : m_renditionBitstreams )
+  {
+    bitstream.close();
+  }
 }
 
 void EncApp::printRateSummary( int64_t framesRcvd )
@@ -86,6 +86,7 @@ private:
   apputils::YuvFileIO   m_yuvInputFile;                   ///< input YUV file
   apputils::YuvFileIO   m_yuvReconFile;                   ///< output YUV reconstruction file
   std::fstream          m_bitstream;                      ///< output bitstream file
+  std::fstream          m_renditionBitstreams[ VVENC_MAX_RENDITIONS ]; ///< output bitstream files of the additional renditions
   unsigned              m_essentialBytes;
   unsigned              m_totalBytes;
 
@@ -117,7 +118,7 @@ public:
 
 private:
   // file I/O
-  bool openFileIO();
+  bool openFileIO( const vvencCheckpointInfo& checkpointInfo );
   void closeFileIO();
 
   // statistics
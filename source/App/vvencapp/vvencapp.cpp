@@ -269,6 +269,19 @@ int main( int argc, char* argv[] )
     }
   }
 
+  // open output files of the additional renditions
+  std::ofstream cRenditionBitstreams[ VVENC_MAX_RENDITIONS ];
+  for( int i = 0; i < vvenccfg.m_numRenditions && cOutBitstream.is_open(); i++ )
+  {
+    const std::string fileName = apputils::FileIOHelper::getRenditionFileName( vvencappCfg.m_bitstreamFileName, i + 1 );
+    cRenditionBitstreams[ i ].open( fileName, std::ios::out | std::ios::binary | std::ios::trunc );
+    if( ! cRenditionBitstreams[ i ].is_open() )
+    {
+      msgApp( nullptr, VVENC_ERROR, "vvencapp [error]: failed to open output file %s\n", fileName.c_str() );
+      return -1;
+    }
+  }
+
   // --- allocate memory for output packets
   vvencAccessUnit AU;
   vvenc_accessUnit_default( &AU );
@@ -306,6 +319,8 @@ int main( int argc, char* argv[] )
 
     // open the input file
     apputils::YuvFileIO cYuvFileInput;
+    cYuvFileInput.setMemoryMapping( vvencappCfg.m_mmapInput );
+    cYuvFileInput.setReadAhead( vvencappCfg.m_inputReadAhead );
     if( 0 != cYuvFileInput.open( vvencappCfg.m_inputFileName, false, vvenccfg.m_inputBitDepth[0], vvenccfg.m_MSBExtendedBitDepth[0], vvenccfg.m_internalBitDepth[0],
                                  vvencappCfg.m_inputFileChromaFormat, vvenccfg.m_internChromaFormat, vvencappCfg.m_bClipOutputVideoToRec709Range, vvencappCfg.m_packedYUVInput,
                                  vvencappCfg.m_forceY4mInput, vvencappCfg.m_logoFileName ) )
@@ -396,7 +411,23 @@ int main( int argc, char* argv[] )
         return iRet;
       }
 
-      if( AU.payloadUsedSize > 0 )
+      if( AU.payloadUsedSize > 0 && AU.rendition > 0 )
+      {
+        std::ofstream& cRenditionBitstream = cRenditionBitstreams[ AU.rendition - 1 ];
+        if( cRenditionBitstream.is_open() )
+        {
+          cRenditionBitstream.write( (const char*)AU.payload, AU.payloadUsedSize );
+          if( cRenditionBitstream.fail() )
+          {
+            msgApp( nullptr, VVENC_ERROR, "\nvvencapp [error]: write rendition bitstream file failed (disk full?)\n");
+            vvenc_YUVBuffer_free_buffer( &cYUVInputBuffer );
+            vvenc_accessUnit_free_payload( &AU );
+            vvenc_encoder_close( enc );
+            return VVENC_ERR_UNSPECIFIED;
+          }
+        }
+      }
+      else if( AU.payloadUsedSize > 0 )
       {
         if( vvencappCfg.m_printStats )
         {
@@ -446,6 +477,10 @@ int main( int argc, char* argv[] )
   {
     cOutBitstream.close();
   }
+  for( auto& cRenditionBitstream : cRenditionBitstreams )
+  {
+    cRenditionBitstream.close();
+  }
 
   vvenc_print_summary(enc);
 
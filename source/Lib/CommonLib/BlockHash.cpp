@@ -0,0 +1,249 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     BlockHash.cpp
+ *  \brief    block hash tables of a reconstructed picture for hash based motion search
+ */
+
+#include "BlockHash.h"
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+uint32_t BlockHash::combineHash( const uint32_t a, const uint32_t b, const uint32_t c, const uint32_t d )
+{
+  uint32_t h = a;
+  h = h * 0x9E3779B1u + b;
+  h = h * 0x9E3779B1u + c;
+  h = h * 0x9E3779B1u + d;
+  // final avalanche, the upper bits select the bucket
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+// blocks with constant rows or constant columns are not stored in the tables,
+// they are found by any regular search and would only produce long candidate lists
+static const uint8_t CONST_ROWS = 1;
+static const uint8_t CONST_COLS = 2;
+
+// the hash of a (2^sizeLog2)x(2^sizeLog2) block is combined from the hashes of its four sub-blocks a b / c d,
+// the update is done in place, since only positions to the right and below are read
+static void hashLevel( uint32_t* hashes, uint8_t* flags, const int stride, const int width, const int height, const int sizeLog2 )
+{
+  const int size = 1 << sizeLog2;
+  const int half = size >> 1;
+  const int offB = half * stride;
+
+  for( int y = 0; y + size <= height; y++ )
+  {
+    uint32_t* h = hashes + y * stride;
+    uint8_t*  f = flags ? flags + y * stride : nullptr;
+    for( int x = 0; x + size <= width; x++ )
+    {
+      const uint32_t a = h[x], b = h[x + half], c = h[x + offB], d = h[x + offB + half];
+      if( f )
+      {
+        const uint8_t subFlags = f[x] & f[x + half] & f[x + offB] & f[x + offB + half];
+        f[x] = ( a == b && c == d ? subFlags & CONST_ROWS : 0 ) | ( a == c && b == d ? subFlags & CONST_COLS : 0 );
+      }
+      h[x] = BlockHash::combineHash( a, b, c, d );
+    }
+  }
+}
+
+static void hashBaseLevel( const CPelBuf& buf, uint32_t* hashes, uint8_t* flags, const int stride )
+{
+  for( int y = 0; y + 1 < buf.height; y++ )
+  {
+    const Pel* p = buf.bufAt( 0, y );
+    uint32_t*  h = hashes + y * stride;
+    uint8_t*   f = flags ? flags + y * stride : nullptr;
+    for( int x = 0; x + 1 < buf.width; x++ )
+    {
+      const Pel a = p[x], b = p[x + 1], c = p[x + buf.stride], d = p[x + buf.stride + 1];
+      if( f )
+      {
+        f[x] = ( a == b && c == d ? CONST_ROWS : 0 ) | ( a == c && b == d ? CONST_COLS : 0 );
+      }
+      h[x] = BlockHash::combineHash( uint16_t( a ), uint16_t( b ), uint16_t( c ), uint16_t( d ) );
+    }
+  }
+}
+
+void BlockHash::generate( const CPelBuf& luma )
+{
+  const int width  = luma.width;
+  const int height = luma.height;
+
+  m_valid = false;
+  if( width < ( 1 << MIN_SIZE_LOG2 ) || height < ( 1 << MIN_SIZE_LOG2 ) )
+  {
+    return;
+  }
+  CHECK( width > INT16_MAX || height > INT16_MAX, "picture too large for block hash positions" );
+
+  std::vector<uint32_t> hashes( width * height );
+  std::vector<uint8_t>  flags ( width * height );
+
+  hashBaseLevel( luma, hashes.data(), flags.data(), width );
+
+  for( int sizeLog2 = 2; sizeLog2 <= MAX_SIZE_LOG2; sizeLog2++ )
+  {
+    const int size = 1 << sizeLog2;
+    if( size > width || size > height )
+    {
+      m_entries    [ sizeLog2 - MIN_SIZE_LOG2 ].clear();
+      m_bucketStart[ sizeLog2 - MIN_SIZE_LOG2 ].clear();
+      continue;
+    }
+
+    hashLevel( hashes.data(), flags.data(), width, width, height, sizeLog2 );
+
+    if( sizeLog2 < MIN_SIZE_LOG2 )
+    {
+      continue;
+    }
+
+    // counting sort of all positions by bucket
+    std::vector<Entry>&    entries     = m_entries    [ sizeLog2 - MIN_SIZE_LOG2 ];
+    std::vector<uint32_t>& bucketStart = m_bucketStart[ sizeLog2 - MIN_SIZE_LOG2 ];
+    bucketStart.assign( ( 1 << BUCKET_BITS ) + 1, 0 );
+
+    for( int y = 0; y + size <= height; y++ )
+    {
+      for( int x = 0; x + size <= width; x++ )
+      {
+        const int idx = y * width + x;
+        if( !flags[idx] )
+        {
+          bucketStart[ ( hashes[idx] >> ( 32 - BUCKET_BITS ) ) + 1 ]++;
+        }
+      }
+    }
+    for( int b = 0; b < ( 1 << BUCKET_BITS ); b++ )
+    {
+      bucketStart[b + 1] += bucketStart[b];
+    }
+
+    entries.resize( bucketStart.back() );
+    std::vector<uint32_t> fillPos( bucketStart.begin(), bucketStart.end() - 1 );
+    for( int y = 0; y + size <= height; y++ )
+    {
+      for( int x = 0; x + size <= width; x++ )
+      {
+        const int idx = y * width + x;
+        if( !flags[idx] )
+        {
+          Entry& e = entries[ fillPos[ hashes[idx] >> ( 32 - BUCKET_BITS ) ]++ ];
+          e.hash   = hashes[idx];
+          e.x      = int16_t( x );
+          e.y      = int16_t( y );
+        }
+      }
+    }
+  }
+
+  m_valid = true;
+}
+
+void BlockHash::getBucket( const uint32_t hash, const int sizeLog2, const Entry*& begin, const Entry*& end ) const
+{
+  const std::vector<uint32_t>& bucketStart = m_bucketStart[ sizeLog2 - MIN_SIZE_LOG2 ];
+  if( !m_valid || bucketStart.empty() )
+  {
+    begin = end = nullptr;
+    return;
+  }
+
+  const uint32_t bucket = hash >> ( 32 - BUCKET_BITS );
+  const Entry*   base   = m_entries[ sizeLog2 - MIN_SIZE_LOG2 ].data();
+  begin = base + bucketStart[ bucket ];
+  end   = base + bucketStart[ bucket + 1 ];
+}
+
+bool BlockHash::isSupported( const int width, const int height )
+{
+  return width == height && width >= ( 1 << MIN_SIZE_LOG2 ) && width <= ( 1 << MAX_SIZE_LOG2 );
+}
+
+uint32_t BlockHash::getBlockHash( const CPelBuf& blk )
+{
+  CHECKD( !isSupported( blk.width, blk.height ), "unsupported block size for block hash" );
+
+  // same hierarchy as for the picture tables, but only on the grid of the sub-blocks
+  uint32_t hashes[ ( 1 << ( MAX_SIZE_LOG2 - 1 ) ) * ( 1 << ( MAX_SIZE_LOG2 - 1 ) ) ];
+  int num = blk.width >> 1;
+
+  for( int y = 0; y < num; y++ )
+  {
+    const Pel* p = blk.bufAt( 0, y << 1 );
+    for( int x = 0; x < num; x++, p += 2 )
+    {
+      hashes[y * num + x] = combineHash( uint16_t( p[0] ), uint16_t( p[1] ), uint16_t( p[blk.stride] ), uint16_t( p[blk.stride + 1] ) );
+    }
+  }
+
+  while( num > 1 )
+  {
+    const int half = num >> 1;
+    for( int y = 0; y < half; y++ )
+    {
+      for( int x = 0; x < half; x++ )
+      {
+        const uint32_t* h = hashes + 2 * y * num + 2 * x;
+        hashes[y * half + x] = combineHash( h[0], h[1], h[num], h[num + 1] );
+      }
+    }
+    num = half;
+  }
+  return hashes[0];
+}
+
+} // namespace vvenc
+
+//! \}
+
@@ -0,0 +1,99 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     BlockHash.h
+ *  \brief    block hash tables of a reconstructed picture for hash based motion search
+ */
+
+#pragma once
+
+#include "CommonDef.h"
+#include "Common.h"
+#include "Unit.h"
+
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+/// hash tables of all square luma blocks (8x8 ... 64x64) at every sample position of a picture,
+/// used to find exact block matches before any SAD based motion search
+class BlockHash
+{
+public:
+  static const int MIN_SIZE_LOG2 = 3;
+  static const int MAX_SIZE_LOG2 = 6;
+  static const int NUM_SIZES     = MAX_SIZE_LOG2 - MIN_SIZE_LOG2 + 1;
+  static const int BUCKET_BITS   = 16;
+
+  struct Entry
+  {
+    uint32_t hash;
+    int16_t  x;
+    int16_t  y;
+  };
+
+  BlockHash() : m_valid( false ) {}
+
+  void         generate       ( const CPelBuf& luma );
+  void         clear          ()                          { m_valid = false; }
+  bool         isValid        ()                    const { return m_valid; }
+
+  // returns the range [begin, end) of all entries with the same bucket as the given hash, the hash values still have to be compared
+  void         getBucket      ( const uint32_t hash, const int sizeLog2, const Entry*& begin, const Entry*& end ) const;
+
+  static bool  isSupported    ( const int width, const int height );
+  static uint32_t getBlockHash( const CPelBuf& blk );
+  static uint32_t combineHash ( const uint32_t a, const uint32_t b, const uint32_t c, const uint32_t d );
+
+private:
+
+  bool                  m_valid;
+  std::vector<Entry>    m_entries[ NUM_SIZES ];
+  std::vector<uint32_t> m_bucketStart[ NUM_SIZES ];
+};
+
+} // namespace vvenc
+
+//! \}
+
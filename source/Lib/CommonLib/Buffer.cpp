@@ -51,6 +51,9 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "Unit.h"
 #include "Slice.h"
 #include "InterpolationFilter.h"
+#include "Utilities/NumaHelper.h"
+
+#include <cmath>
 
 //! \ingroup CommonLib
 //! \{
@@ -434,6 +437,95 @@ uint64_t AvgHighPassWithDownsamplingDiff2ndCore (const int width,const int heigh
   return (taAct);
 }
 
+void downsample2x2Core( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height )
+{
+  for( int y = 0; y < height; y++, src += 2 * srcStride, dst += dstStride )
+  {
+    const Pel* srcBelow = src + srcStride;
+    for( int x = 0; x < width; x++ )
+    {
+      dst[x] = ( src[2 * x] + src[2 * x + 1] + srcBelow[2 * x] + srcBelow[2 * x + 1] + 2 ) >> 2;
+    }
+  }
+}
+
+void resampleHorCore( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height, const int* srcOffsets, const int16_t* coeffs, const int numTaps, const int shift )
+{
+  const int offset = 1 << ( shift - 1 );
+  for( int y = 0; y < height; y++, src += srcStride, dst += dstStride )
+  {
+    const int16_t* coeff = coeffs;
+    for( int x = 0; x < width; x++, coeff += numTaps )
+    {
+      const Pel* s   = src + srcOffsets[x];
+      int        sum = 0;
+      for( int k = 0; k < numTaps; k++ )
+      {
+        sum += s[k] * coeff[k];
+      }
+      dst[x] = Pel( ( sum + offset ) >> shift );
+    }
+  }
+}
+
+void resampleVerCore( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height, const int* srcOffsets, const int16_t* coeffs, const int numTaps, const int shift, const ClpRng& clpRng )
+{
+  const int offset = 1 << ( shift - 1 );
+  for( int y = 0; y < height; y++, dst += dstStride, coeffs += numTaps )
+  {
+    const Pel* s = src + srcOffsets[y] * srcStride;
+    for( int x = 0; x < width; x++ )
+    {
+      int sum = 0;
+      for( int k = 0; k < numTaps; k++ )
+      {
+        sum += s[k * srcStride + x] * coeffs[k];
+      }
+      dst[x] = Pel( ClipPel<int>( ( sum + offset ) >> shift, clpRng ) );
+    }
+  }
+}
+
+uint64_t ssdCore( const Pel* src0, const int src0Stride, const Pel* src1, const int src1Stride, const int width, const int height )
+{
+  uint64_t ssd = 0;
+  for( int y = 0; y < height; y++, src0 += src0Stride, src1 += src1Stride )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int diff = src0[x] - src1[x];
+      ssd += uint64_t( diff * diff );
+    }
+  }
+  return ssd;
+}
+
+void ssimSums4x4Core( const Pel* src0, const int src0Stride, const Pel* src1, const int src1Stride, const int numBlocks, int* sums, const int sumsStride )
+{
+  for( int b = 0; b < numBlocks; b++, src0 += 4, src1 += 4 )
+  {
+    int sum0 = 0, sum1 = 0, sqr0 = 0, sqr1 = 0, prod = 0;
+    for( int y = 0; y < 4; y++ )
+    {
+      for( int x = 0; x < 4; x++ )
+      {
+        const int a = src0[y * src0Stride + x];
+        const int c = src1[y * src1Stride + x];
+        sum0 += a;
+        sum1 += c;
+        sqr0 += a * a;
+        sqr1 += c * c;
+        prod += a * c;
+      }
+    }
+    sums[ 0 * sumsStride + b ] = sum0;
+    sums[ 1 * sumsStride + b ] = sum1;
+    sums[ 2 * sumsStride + b ] = sqr0;
+    sums[ 3 * sumsStride + b ] = sqr1;
+    sums[ 4 * sumsStride + b ] = prod;
+  }
+}
+
 PelBufferOps::PelBufferOps()
 {
   addAvg            = addAvgCore<Pel>;
@@ -480,6 +572,11 @@ PelBufferOps::PelBufferOps()
   AvgHighPassWithDownsamplingDiff2nd = AvgHighPassWithDownsamplingDiff2ndCore;
   HDHighPass = HDHighPassCore;
   HDHighPass2 = HDHighPass2Core;
+  downsample2x2 = downsample2x2Core;
+  resampleHor = resampleHorCore;
+  resampleVer = resampleVerCore;
+  ssd = ssdCore;
+  ssimSums4x4 = ssimSums4x4Core;
 }
 
 void PelBufferOps::initPelBufOps( bool enableOpt )
@@ -1072,6 +1169,30 @@ void PelStorage::swap( PelStorage& other )
   }
 }
 
+void PelStorage::interleaveNumaNodes()
+{
+  if( bufs.empty() )
+  {
+    return;
+  }
+
+  if( !m_origin[1] )
+  {
+    // all components in one allocation
+    const PelBuf& last = bufs.back();
+    NumaHelper::interleaveMemory( m_origin[0], ( last.buf + (size_t) last.stride * last.height - m_origin[0] ) * sizeof( Pel ) );
+    return;
+  }
+
+  for( uint32_t i = 0; i < bufs.size(); i++ )
+  {
+    if( m_origin[i] )
+    {
+      NumaHelper::interleaveMemory( m_origin[i], ( bufs[i].buf + (size_t) bufs[i].stride * bufs[i].height - m_origin[i] ) * sizeof( Pel ) );
+    }
+  }
+}
+
 void PelStorage::destroy()
 {
   chromaFormat = NUM_CHROMA_FORMAT;
@@ -1267,6 +1388,204 @@ void copyPadToPelUnitBuf( PelUnitBuf pelUnitBuf, const vvencYUVBuffer& yuvBuffer
   }
 }
 
+// box filtered downscaling of the top left srcLumaSize area by 2^scaleLog2, the remaining destination area is padded by replication
+static void padRightBottom( PelBuf& dest, const int width, const int height )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    Pel* dst = dest.bufAt( 0, y );
+    for( int x = width; x < dest.width; x++ )
+    {
+      dst[ x ] = dst[ width - 1 ];
+    }
+  }
+  for( int y = height; y < dest.height; y++ )
+  {
+    ::memcpy( dest.bufAt( 0, y ), dest.bufAt( 0, height - 1 ), dest.width * sizeof( Pel ) );
+  }
+}
+
+void downscalePadPelUnitBuf( PelUnitBuf pelUnitBuf, const CPelUnitBuf& srcBuf, const Size& srcLumaSize, int scaleLog2 )
+{
+  CHECK( scaleLog2 < 1, "downscaling by at least a factor of 2 expected" );
+  const int numComp = getNumberValidComponents( pelUnitBuf.chromaFormat );
+  const int blkSize = 1 << scaleLog2;
+  const int shift   = 2 * scaleLog2;
+  const int offset  = 1 << ( shift - 1 );
+  for( int i = 0; i < numComp; i++ )
+  {
+    const ComponentID compID = ComponentID( i );
+    const CPelBuf&    src    = srcBuf.bufs[ i ];
+    PelBuf&           dest   = pelUnitBuf.bufs[ i ];
+    const int         width  = std::min<int>( dest.width,  ( srcLumaSize.width  >> getComponentScaleX( compID, pelUnitBuf.chromaFormat ) ) >> scaleLog2 );
+    const int         height = std::min<int>( dest.height, ( srcLumaSize.height >> getComponentScaleY( compID, pelUnitBuf.chromaFormat ) ) >> scaleLog2 );
+    CHECK( width <= 0 || height <= 0, "invalid downscaling size" );
+
+    for( int y = 0; y < height; y++ )
+    {
+      Pel* dst = dest.bufAt( 0, y );
+      for( int x = 0; x < width; x++ )
+      {
+        const Pel* blk = src.bufAt( x << scaleLog2, y << scaleLog2 );
+        int        sum = 0;
+        for( int k = 0; k < blkSize; k++, blk += src.stride )
+        {
+          for( int l = 0; l < blkSize; l++ )
+          {
+            sum += blk[ l ];
+          }
+        }
+        dst[ x ] = Pel( ( sum + offset ) >> shift );
+      }
+    }
+
+    padRightBottom( dest, width, height );
+  }
+}
+
+static double resampleKernel( const double pos, const int filter )
+{
+  const double x = std::abs( pos );
+  if( filter == PelResampler::FILTER_LANCZOS )
+  {
+    if( x < 1e-9 )
+    {
+      return 1.0;
+    }
+    if( x >= 3.0 )
+    {
+      return 0.0;
+    }
+    const double px = 3.14159265358979323846 * x;
+    return 3.0 * sin( px ) * sin( px / 3.0 ) / ( px * px );
+  }
+
+  // Catmull-Rom
+  if( x < 1.0 )
+  {
+    return ( 1.5 * x - 2.5 ) * x * x + 1.0;
+  }
+  if( x < 2.0 )
+  {
+    return ( ( -0.5 * x + 2.5 ) * x - 4.0 ) * x + 2.0;
+  }
+  return 0.0;
+}
+
+void PelResampler::xInitTaps( Taps& taps, const int srcLen, const int dstLen, const double ratio, const double phase, const int filter, const int tapAlign )
+{
+  // the kernel is stretched by the downscaling ratio to act as anti-aliasing filter
+  const double scale    = std::max( ratio, 1.0 );
+  const int    halfTaps = ( int ) ceil( ( filter == FILTER_LANCZOS ? 3.0 : 2.0 ) * scale );
+  const int    numTaps  = std::min( ( 2 * halfTaps + tapAlign - 1 ) / tapAlign * tapAlign, srcLen );
+
+  taps.numTaps = numTaps;
+  taps.offsets.resize( dstLen );
+  taps.coeffs.assign( dstLen * numTaps, 0 );
+
+  std::vector<double> weights( numTaps );
+  for( int i = 0; i < dstLen; i++ )
+  {
+    const double center = i * ratio + phase;
+    const int    first  = ( int ) floor( center ) - halfTaps + 1;
+    const int    start  = Clip3( 0, srcLen - numTaps, first );
+
+    // taps outside of the picture are folded onto the border samples
+    std::fill( weights.begin(), weights.end(), 0.0 );
+    double sum = 0.0;
+    for( int k = 0; k < 2 * halfTaps; k++ )
+    {
+      const double w = resampleKernel( ( first + k - center ) / scale, filter );
+      weights[ Clip3( 0, srcLen - 1, first + k ) - start ] += w;
+      sum += w;
+    }
+
+    int16_t* coeff = &taps.coeffs[ i * numTaps ];
+    int      total = 0;
+    int      peak  = 0;
+    for( int k = 0; k < numTaps; k++ )
+    {
+      coeff[ k ] = ( int16_t ) lround( weights[ k ] / sum * ( 1 << COEFF_BITS ) );
+      total     += coeff[ k ];
+      peak       = weights[ k ] > weights[ peak ] ? k : peak;
+    }
+    // keep the DC gain exact
+    coeff[ peak ] += ( 1 << COEFF_BITS ) - total;
+    taps.offsets[ i ] = start;
+  }
+}
+
+void PelResampler::init( const ChromaFormat chFmt, const Size& srcLumaSize, const Size& dstLumaSize, const int bitDepth, const int filter )
+{
+  CHECK( dstLumaSize.width > srcLumaSize.width || dstLumaSize.height > srcLumaSize.height, "PelResampler: only downscaling supported" );
+  CHECK( dstLumaSize.width * 8 < srcLumaSize.width || dstLumaSize.height * 8 < srcLumaSize.height, "PelResampler: downscaling ratio exceeds 8" );
+
+  m_chromaFormat = chFmt;
+  m_filter       = filter;
+  m_bitDepth     = bitDepth;
+  m_srcSize      = srcLumaSize;
+  m_dstSize      = dstLumaSize;
+  m_scaleLog2    = 0;
+
+  if( filter == FILTER_BOX )
+  {
+    while( ( srcLumaSize.width >> m_scaleLog2 ) > dstLumaSize.width )
+    {
+      m_scaleLog2++;
+    }
+    CHECK( m_scaleLog2 < 1 || ( srcLumaSize.width >> m_scaleLog2 ) != dstLumaSize.width || ( srcLumaSize.height >> m_scaleLog2 ) != dstLumaSize.height, "PelResampler: box filter requires dyadic downscaling" );
+    return;
+  }
+
+  const double ratioX  = double( srcLumaSize.width  ) / dstLumaSize.width;
+  const double ratioY  = double( srcLumaSize.height ) / dstLumaSize.height;
+  const int    numComp = getNumberValidComponents( chFmt );
+  size_t       tmpSize = 0;
+  for( int i = 0; i < numComp; i++ )
+  {
+    const ComponentID compID = ComponentID( i );
+    const int         sx     = getComponentScaleX( compID, chFmt );
+    const int         sy     = getComponentScaleY( compID, chFmt );
+    // horizontally subsampled chroma is co-sited with the even luma samples, everything else is centered
+    const double      phaseX = sx ? ( ratioX - 1.0 ) / 4.0 : ( ratioX - 1.0 ) / 2.0;
+    const double      phaseY = ( ratioY - 1.0 ) / 2.0;
+    // the horizontal pass is vectorized over the taps, the vertical pass over the samples of a line
+    xInitTaps( m_hor[ i ], srcLumaSize.width  >> sx, dstLumaSize.width  >> sx, ratioX, phaseX, filter, 8 );
+    xInitTaps( m_ver[ i ], srcLumaSize.height >> sy, dstLumaSize.height >> sy, ratioY, phaseY, filter, 2 );
+    tmpSize = std::max<size_t>( tmpSize, ( size_t ) ( dstLumaSize.width >> sx ) * ( srcLumaSize.height >> sy ) );
+  }
+  m_tmp.resize( tmpSize );
+}
+
+void PelResampler::resample( PelUnitBuf dstBuf, const CPelUnitBuf& srcBuf )
+{
+  if( m_filter == FILTER_BOX )
+  {
+    downscalePadPelUnitBuf( dstBuf, srcBuf, m_srcSize, m_scaleLog2 );
+    return;
+  }
+
+  // the horizontally filtered lines keep some extra precision
+  const int    extraBits = std::max( 0, COEFF_BITS - m_bitDepth );
+  const ClpRng clpRng    = { m_bitDepth };
+  const int    numComp   = getNumberValidComponents( m_chromaFormat );
+  for( int i = 0; i < numComp; i++ )
+  {
+    const ComponentID compID = ComponentID( i );
+    const CPelBuf&    src    = srcBuf.bufs[ i ];
+    PelBuf&           dest   = dstBuf.bufs[ i ];
+    const int         width  = ( int ) m_hor[ i ].offsets.size();
+    const int         height = ( int ) m_ver[ i ].offsets.size();
+    const int         srcH   = m_srcSize.height >> getComponentScaleY( compID, m_chromaFormat );
+    CHECK( width > dest.width || height > dest.height || srcH > src.height, "PelResampler: invalid buffer size" );
+
+    g_pelBufOP.resampleHor( src.buf, src.stride, m_tmp.data(), width, width, srcH, m_hor[ i ].offsets.data(), m_hor[ i ].coeffs.data(), m_hor[ i ].numTaps, COEFF_BITS - extraBits );
+    g_pelBufOP.resampleVer( m_tmp.data(), width, dest.buf, dest.stride, width, height, m_ver[ i ].offsets.data(), m_ver[ i ].coeffs.data(), m_ver[ i ].numTaps, COEFF_BITS + extraBits, clpRng );
+
+    padRightBottom( dest, width, height );
+  }
+}
+
 /*
 void setupPelUnitBuf( const YUVBuffer& yuvBuffer, PelUnitBuf& pelUnitBuf, const ChromaFormat& chFmt )
 {
@@ -126,6 +126,11 @@ struct PelBufferOps
   uint64_t ( *AvgHighPassWithDownsamplingDiff2nd) (const int width,const int height,const Pel* pSrc,const Pel* pSM1,const Pel* pS21,const int iSrcStride,const int iSM1Stride,const int iSM2Stride);
   uint64_t ( *HDHighPass) (const int width, const int height,const Pel*  pSrc,const Pel* pSM1,const int iSrcStride,const int iSM1Stride);
   uint64_t ( *HDHighPass2)  (const int width, const int height,const Pel*  pSrc,const Pel* pSM1,const Pel* pSM2,const int iSrcStride,const int iSM1Stride,const int iSM2Stride);
+  void ( *downsample2x2 ) ( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height ); // width and height of dst
+  void ( *resampleHor )   ( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height, const int* srcOffsets, const int16_t* coeffs, const int numTaps, const int shift );
+  void ( *resampleVer )   ( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height, const int* srcOffsets, const int16_t* coeffs, const int numTaps, const int shift, const ClpRng& clpRng );
+  uint64_t ( *ssd )       ( const Pel* src0, const int src0Stride, const Pel* src1, const int src1Stride, const int width, const int height );
+  void ( *ssimSums4x4 )   ( const Pel* src0, const int src0Stride, const Pel* src1, const int src1Stride, const int numBlocks, int* sums, const int sumsStride ); // planar sums of src0, src1, src0^2, src1^2, src0*src1 per 4x4 block
 
 private:
   bool isInitSIMDDone = false;
@@ -969,6 +974,7 @@ struct PelStorage : public PelUnitBuf
   void create( const ChromaFormat &_chromaFormat, const Area& _area, const unsigned _maxCUSize, const unsigned _margin = 0, const unsigned _alignment = 0, const bool _scaleChromaMargin = true );
   void destroy();
   void compactResize( const UnitArea& area );
+  void interleaveNumaNodes();
 
          PelBuf getBuf( const CompArea& blk );
   const CPelBuf getBuf( const CompArea& blk ) const;
@@ -1106,6 +1112,51 @@ private:
 struct Window;
 
 void copyPadToPelUnitBuf( PelUnitBuf pelUnitBuf, const vvencYUVBuffer& yuvBuffer, const ChromaFormat& chFmt );
+void downscalePadPelUnitBuf( PelUnitBuf pelUnitBuf, const CPelUnitBuf& srcBuf, const Size& srcLumaSize, int scaleLog2 );
+
+// separable polyphase resampler for downscaling pictures by arbitrary ratios (up to 1/8), the filter coefficients are precomputed per output position
+class PelResampler
+{
+public:
+  enum Filter
+  {
+    FILTER_BOX     = 0,   // box average, dyadic ratios only
+    FILTER_BICUBIC = 1,   // Catmull-Rom
+    FILTER_LANCZOS = 2,   // Lanczos with 3 lobes
+  };
+
+  static const int COEFF_BITS = 14;
+
+  PelResampler() : m_chromaFormat( CHROMA_420 ), m_filter( FILTER_BICUBIC ), m_bitDepth( 10 ), m_scaleLog2( 0 ) {}
+
+  void init    ( const ChromaFormat chFmt, const Size& srcLumaSize, const Size& dstLumaSize, const int bitDepth, const int filter );
+  // resample the source area into the top left destination area, the remaining destination area is padded
+  void resample( PelUnitBuf dstBuf, const CPelUnitBuf& srcBuf );
+
+  const Size& getSrcSize() const { return m_srcSize; }
+  const Size& getDstSize() const { return m_dstSize; }
+
+private:
+  struct Taps
+  {
+    int                  numTaps;
+    std::vector<int>     offsets;   // first source sample of each output sample
+    std::vector<int16_t> coeffs;    // numTaps coefficients of each output sample
+  };
+
+  static void xInitTaps( Taps& taps, const int srcLen, const int dstLen, const double ratio, const double phase, const int filter, const int tapAlign );
+
+  ChromaFormat     m_chromaFormat;
+  int              m_filter;
+  int              m_bitDepth;
+  int              m_scaleLog2;
+  Size             m_srcSize;
+  Size             m_dstSize;
+  Taps             m_hor[ MAX_NUM_COMP ];
+  Taps             m_ver[ MAX_NUM_COMP ];
+  std::vector<Pel> m_tmp;
+};
+
 //void setupPelUnitBuf( const YUVBuffer& yuvBuffer, PelUnitBuf& pelUnitBuf, const ChromaFormat& chFmt );
 void setupYuvBuffer ( const PelUnitBuf& pelUnitBuf, vvencYUVBuffer& yuvBuffer, const Window* confWindow );
 
@@ -518,6 +518,7 @@ static constexpr int FP_PREC =                                       11;
 static constexpr int CSCALE_FP_PREC =                                11;
 
 static constexpr int MCTF_PADDING         = 128;
+static constexpr int NUM_LUMA_PYR_LEVELS  = 3;   // half, quarter and eighth resolution luma of the input pictures
 
 static constexpr int SCALE_RATIO_BITS =                              14;
 static constexpr int DELTA_QP_ACT[4] =                  { -5, 1, 3, 1 };
@@ -581,14 +581,14 @@ MCTF::~MCTF()
 {
 }
 
-void MCTF::init( const VVEncCfg& encCfg, bool isFinalPass, NoMallocThreadPool* threadPool )
+void MCTF::init( const VVEncCfg& encCfg, bool isFinalPass, NoMallocThreadPool* threadPool, int startPoc )
 {
   CHECK( encCfg.m_vvencMCTF.numFrames != encCfg.m_vvencMCTF.numStrength, "should have been checked before" );
 
   m_encCfg      = &encCfg;
   m_threadPool  = threadPool;
   m_isFinalPass = isFinalPass;
-  m_filterPoc   = 0;
+  m_filterPoc   = startPoc;
   m_area        = Area( 0, 0, m_encCfg->m_PadSourceWidth, m_encCfg->m_PadSourceHeight );
 
   // TLayer (TL) dependent definition of drop frames: TL = 4,  TL = 3,  TL = 2,  TL = 1,  TL = 0
@@ -663,7 +663,7 @@ void MCTF::processPictures( const PicList& picList, AccessUnitList& auList, PicL
   m_filterPoc += 1;
 }
 
-void MCTF::motionEstimationMCTF(Picture* curPic, std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, const PelStorage& origBuf, PelStorage& origSubsampled2, PelStorage& origSubsampled4, PelStorage& origSubsampled8, std::vector<double> &mvErr, double &minError, bool addLevel, bool calcErr)
+void MCTF::motionEstimationMCTF(Picture* curPic, std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, const PelStorage& origBuf, PicShared* origShared, std::vector<double> &mvErr, double &minError, bool addLevel, bool calcErr)
 {
   srcFrameInfo.push_back(TemporalFilterSourcePicInfo());
   TemporalFilterSourcePicInfo& srcPic = srcFrameInfo.back();
@@ -674,6 +674,7 @@ void MCTF::motionEstimationMCTF(Picture* curPic, std::deque<TemporalFilterSource
   srcPic.picBuffer.createFromBuf(curPic->getOrigBuf());
   srcPic.mvs.allocate(wInBlks, hInBlks);
   srcPic.index = std::min(5, std::abs(curPic->poc - m_filterPoc) - 1);
+  srcPic.pocOffset = curPic->poc - m_filterPoc;
 
 
   {
@@ -683,17 +684,17 @@ void MCTF::motionEstimationMCTF(Picture* curPic, std::deque<TemporalFilterSource
     Array2D<MotionVector> mv_1(width / (m_mctfUnitSize * 4) + 1, height / (m_mctfUnitSize * 4) + 1);
     Array2D<MotionVector> mv_2(width / (m_mctfUnitSize * 2) + 1, height / (m_mctfUnitSize * 2) + 1);
 
-    PelStorage bufferSub2;
-    PelStorage bufferSub4;
-
-    subsampleLuma(srcPic.picBuffer, bufferSub2);
-    subsampleLuma(bufferSub2, bufferSub4);
+    // subsampled pictures are created once per picture and shared with the other pre-analysis stages
+    const PelStorage& origSubsampled2 = origShared->getLumaPyramid(0);
+    const PelStorage& origSubsampled4 = origShared->getLumaPyramid(1);
+    const PelStorage& bufferSub2      = curPic->m_picShared->getLumaPyramid(0);
+    const PelStorage& bufferSub4      = curPic->m_picShared->getLumaPyramid(1);
 
     if (addLevel)
     {
       Array2D<MotionVector> mv_m(width / (m_mctfUnitSize * 16) + 1, height / (m_mctfUnitSize * 16) + 1);
-      PelStorage bufferSub8;
-      subsampleLuma(bufferSub4, bufferSub8);
+      const PelStorage& origSubsampled8 = origShared->getLumaPyramid(2);
+      const PelStorage& bufferSub8      = curPic->m_picShared->getLumaPyramid(2);
       motionEstimationLuma(mv_m, origSubsampled8, bufferSub8, 2 * m_mctfUnitSize);
       motionEstimationLuma(mv_0, origSubsampled4, bufferSub4, 2 * m_mctfUnitSize, &mv_m, 2);
     }
@@ -772,17 +773,6 @@ void MCTF::filter( const std::deque<Picture*>& picFifo, int filterIdx )
     const PelStorage& origBuf = pic->getOrigBuffer();
           PelStorage& fltrBuf = pic->getFilteredOrigBuffer();
 
-    // subsample original picture so it only needs to be done once
-    PelStorage origSubsampled2;
-    PelStorage origSubsampled4;
-    PelStorage origSubsampled8;
-    subsampleLuma( origBuf,         origSubsampled2 );
-    subsampleLuma( origSubsampled2, origSubsampled4 );
-    if (condAddLevel)
-    {
-      subsampleLuma(origSubsampled4, origSubsampled8);
-    }
-
     // determine motion vectors
     std::deque<TemporalFilterSourcePicInfo> srcFrameInfo;
     for ( int i = dropFramesFront; i < picFifo.size() - dropFramesBack; i++ )
@@ -792,7 +782,7 @@ void MCTF::filter( const std::deque<Picture*>& picFifo, int filterIdx )
       {
         continue;
       }
-      motionEstimationMCTF(curPic, srcFrameInfo, origBuf, origSubsampled2, origSubsampled4, origSubsampled8 ,mvErr, minError, condAddLevel, useMCTFadaptation);
+      motionEstimationMCTF(curPic, srcFrameInfo, origBuf, pic->m_picShared, mvErr, minError, condAddLevel, useMCTFadaptation);
     }
 
     int lastIndexRefFr = -1;
@@ -829,7 +819,7 @@ void MCTF::filter( const std::deque<Picture*>& picFifo, int filterIdx )
           Picture* curPic = picFifo[i];
           if (curIdx == std::abs(curPic->poc - m_filterPoc))
           {
-            motionEstimationMCTF(curPic, srcFrameInfo, origBuf, origSubsampled2, origSubsampled4, origSubsampled8, mvErr, minError, condAddLevel, m_encCfg->m_vvencMCTF.MCTFSpeed == 4);
+            motionEstimationMCTF(curPic, srcFrameInfo, origBuf, pic->m_picShared, mvErr, minError, condAddLevel, m_encCfg->m_vvencMCTF.MCTFSpeed == 4);
             if (m_encCfg->m_vvencMCTF.MCTFSpeed == 4)
             {
               int nSize = (int(srcFrameInfo.size()) & 1) + int(srcFrameInfo.size());
@@ -859,6 +849,32 @@ void MCTF::filter( const std::deque<Picture*>& picFifo, int filterIdx )
       }
     }
 
+    // keep the motion field as motion search hints, MCTF vectors are in internal MV precision
+    if( m_encCfg->m_mctfMvHints )
+    {
+      static_assert( MV_FRACTIONAL_BITS_INTERNAL == 4 && m_motionVectorFactor == 16, "MCTF and internal MV precision differ" );
+      PicShared* picShared = pic->m_picShared;
+      picShared->m_mvHintBlkSize = m_mctfUnitSize;
+      picShared->m_mvHints.resize( srcFrameInfo.size() );
+      for( int i = 0; i < srcFrameInfo.size(); i++ )
+      {
+        const TemporalFilterSourcePicInfo& srcPic = srcFrameInfo[ i ];
+        MvHintField& field = picShared->m_mvHints[ i ];
+        field.pocOffset    = srcPic.pocOffset;
+        field.width        = srcPic.mvs.w();
+        field.height       = srcPic.mvs.h();
+        field.mvs.resize( field.width * field.height );
+        for( int y = 0; y < field.height; y++ )
+        {
+          for( int x = 0; x < field.width; x++ )
+          {
+            const MotionVector& mv = srcPic.mvs.get( x, y );
+            field.mvs[ y * field.width + x ] = Mv( mv.x, mv.y );
+          }
+        }
+      }
+    }
+
     // filter
     if( pic->useMCTF )
     {
@@ -1069,33 +1085,6 @@ void MCTF::filter( const std::deque<Picture*>& picFifo, int filterIdx )
 // Private member functions
 // ====================================================================================================================
 
-void MCTF::subsampleLuma(const PelStorage &input, PelStorage &output, const int factor) const
-{
-  const int newWidth = input.Y().width / factor;
-  const int newHeight = input.Y().height / factor;
-  output.create(CHROMA_400, Area(0, 0, newWidth, newHeight), 0, m_padding);
-
-  const Pel* srcRow = input.Y().buf;
-  const int srcStride = input.Y().stride;
-  Pel* dstRow = output.Y().buf;
-  const int dstStride = output.Y().stride;
-
-  for (int y = 0; y < newHeight; y++, srcRow+=factor*srcStride, dstRow+=dstStride)
-  {
-    const Pel* inRow      = srcRow;
-    const Pel* inRowBelow = srcRow+srcStride;
-    Pel* target     = dstRow;
-
-    for (int x = 0; x < newWidth; x++)
-    {
-      target[x] = (inRow[0] + inRowBelow[0] + inRow[1] + inRowBelow[1] + 2) >> 2;
-      inRow += 2;
-      inRowBelow += 2;
-    }
-  }
-  output.extendBorderPel(m_padding, m_padding);
-}
-
 int MCTF::motionErrorLuma(const PelStorage &orig,
   const PelStorage &buffer,
   const int x,
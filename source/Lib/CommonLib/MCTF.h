@@ -116,10 +116,11 @@ public:
 
 struct TemporalFilterSourcePicInfo
 {
-  TemporalFilterSourcePicInfo() : picBuffer(), mvs(), index(0) { }
+  TemporalFilterSourcePicInfo() : picBuffer(), mvs(), index(0), pocOffset(0) { }
   PelStorage            picBuffer;
   Array2D<MotionVector> mvs;
   int                   index;
+  int                   pocOffset;
 };
 // ====================================================================================================================
 // Class definition
@@ -133,7 +134,7 @@ public:
   MCTF( bool enableOpt = true );
   virtual ~MCTF();
 
-  void init( const VVEncCfg& encCfg, bool isFinalPass, NoMallocThreadPool* threadPool );
+  void init( const VVEncCfg& encCfg, bool isFinalPass, NoMallocThreadPool* threadPool, int startPoc );
 
 protected:
   virtual void initPicture    ( Picture* pic );
@@ -191,8 +192,6 @@ private:
   int                   m_searchPttrn     = 0;
   int                   m_mctfUnitSize;
 
-  void subsampleLuma    (const PelStorage &input, PelStorage &output, const int factor = 2) const;
-
   int motionErrorLuma   (const PelStorage &orig, const PelStorage &buffer, const int x, const int y, int dx, int dy, const int bs, const int besterror) const;
 
   bool estimateLumaLn   ( std::atomic_int& blockX, std::atomic_int* prevLineX, Array2D<MotionVector> &mvs, const PelStorage &orig, const PelStorage &buffer, const int blockSize,
@@ -205,7 +204,7 @@ private:
 
   void xFinalizeBlkLine (const PelStorage &orgPic, std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, PelStorage &newOrgPic, int yStart, const double sigmaSqCh[MAX_NUM_CH], double overallStrenght) const;
 
-  void motionEstimationMCTF(Picture* curPic, std::deque<TemporalFilterSourcePicInfo>& srcFrameInfo, const PelStorage& origBuf, PelStorage& origSubsampled2, PelStorage& origSubsampled4, PelStorage& origSubsampled8, std::vector<double>& mvErr, double& minError, bool addLevel, bool calcErr);
+  void motionEstimationMCTF(Picture* curPic, std::deque<TemporalFilterSourcePicInfo>& srcFrameInfo, const PelStorage& origBuf, PicShared* origShared, std::vector<double>& mvErr, double& minError, bool addLevel, bool calcErr);
 
 }; // END CLASS DEFINITION MCTF
 
@@ -43,6 +43,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include <sstream>
 #include <list>
+#include <vector>
 #include "vvenc/vvenc.h"
 
 //! \ingroup Interface
@@ -124,10 +125,12 @@ struct OutputNALUnit;
 
 /**
  * A single NALunit, with complete payload in EBSP format.
+ * The payload bytes are stored contiguously and can be accessed
+ * without any further copy.
  */
 struct NALUnitEBSP : public NALUnit
 {
-  std::ostringstream m_nalUnitData;
+  std::vector<uint8_t> m_nalUnitData;
 
   /**
    * convert the OutputNALUnit nalu into EBSP format by writing out
@@ -170,6 +173,13 @@ public:
     cts          = 0;
     dts          = 0;
     poc          = 0;
+    rendition     = 0;
+    qualityValid  = false;
+    psnr[0] = psnr[1] = psnr[2] = 0.0;
+    ssim          = 0.0;
+    msSsim        = 0.0;
+    vif           = 0.0;
+    detail        = 0.0;
     sliceType     = VVENC_NUMBER_OF_SLICE_TYPES;
     temporalLayer = 0;
     status        = 0;
@@ -179,6 +189,7 @@ public:
     refPic        = false;
     InfoString.clear();
     userData      = nullptr;
+    checkpointData.clear();
 
     for( AccessUnitList::iterator it = this->begin(); it != this->end(); it++ )
     {
@@ -195,6 +206,13 @@ public:
   int64_t         cts;                                   ///< composition time stamp
   int64_t         dts;                                   ///< decoding time stamp
   uint64_t        poc;                                   ///< picture order count
+  int             rendition;                              ///< 0: main stream, otherwise index of the additional rendition
+  bool            qualityValid;                           ///< quality metrics of the coded picture are valid
+  double          psnr[3];                                ///< PSNR of the Y, Cb and Cr reconstruction
+  double          ssim;
+  double          msSsim;
+  double          vif;
+  double          detail;
   vvencSliceType  sliceType;                              ///< slice type (I/P/B) */
   int             temporalLayer;                          ///< temporal layer
   int             status;
@@ -204,6 +222,7 @@ public:
   bool            refPic;                                 ///< reference picture
   std::string     InfoString;
   void*           userData;                               ///< user data passed in corresponding input YUV buffer
+  std::vector<uint8_t> checkpointData;                    ///< encoder state to be stored before this access unit is delivered
 };
 
 
@@ -163,6 +163,7 @@ Picture::Picture()
     , isFlush             ( false )
     , isInProcessList     ( false )
     , precedingDRAP       ( false )
+    , numaInterleave      ( false )
     , gopEntry            ( nullptr )
     , refCounter          ( 0 )
     , poc                 ( 0 )
@@ -253,6 +254,8 @@ void Picture::reset()
   picOutOffset         = 0;
 
   picVA.reset();
+  blockHash.clear();
+  subPelPlanes.clear();
 
   std::fill_n( m_sharedBufs, (int)NUM_PIC_TYPES, nullptr );
   std::fill_n( m_bufsOrigPrev, NUM_QPA_PREV_FRAMES, nullptr );
@@ -389,6 +392,11 @@ void Picture::finalInit( const VPS& _vps, const SPS& sps, const PPS& pps, PicHea
   if( !m_picBufs[PIC_RECONSTRUCTION].valid() )
   {
     m_picBufs[ PIC_RECONSTRUCTION ].create( chromaFormat, Area( lumaPos(), lumaSize() ), sps.CTUSize, margin, MEMORY_ALIGN_DEF_SIZE );
+    if( numaInterleave )
+    {
+      // reference pictures are read by the picture encoders of all nodes
+      m_picBufs[ PIC_RECONSTRUCTION ].interleaveNumaNodes();
+    }
   }
   if( !m_tileColsDone )
   {
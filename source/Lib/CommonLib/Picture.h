@@ -51,6 +51,8 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "Slice.h"
 #include "CodingStructure.h"
 #include "BitStream.h"
+#include "BlockHash.h"
+#include "SubPelPlanes.h"
 
 #include <deque>
 #include <chrono>
@@ -217,6 +219,8 @@ public:
   std::vector<const Slice*>     ctuSlice;
   SEIMessages                   SEIs;
   BlkStat                       picBlkStat;
+  BlockHash                     blockHash;
+  SubPelPlanes                  subPelPlanes;
   std::vector<OutputBitstream>  sliceDataStreams;
 
   bool                          isInitDone;
@@ -229,6 +233,7 @@ public:
   bool                          isFlush;
   bool                          isInProcessList;
   bool                          precedingDRAP; // preceding a DRAP picture in decoding order
+  bool                          numaInterleave; // interleave the reconstruction buffer across NUMA nodes
 
   const GOPEntry*               gopEntry;
 
@@ -264,6 +269,10 @@ public:
   PicVisAct                     picVA;
   double                        psnr[MAX_NUM_COMP];
   double                        mse [MAX_NUM_COMP];
+  double                        ssim;      // structural metrics of the reconstruction, only computed with QualityMetrics
+  double                        msSsim;
+  double                        vif;
+  double                        detail;
 
   StopClock                     encTime;
   bool                          isSccWeak;
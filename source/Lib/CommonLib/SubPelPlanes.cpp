@@ -0,0 +1,170 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     SubPelPlanes.cpp
+ *  \brief    sub-pel interpolated luma planes of a reconstructed picture for the fractional motion search
+ */
+
+#include "SubPelPlanes.h"
+#include "InterpolationFilter.h"
+
+#include <thread>
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+// the outermost samples of the margin are never addressed by a clipped motion vector (see InterSearch::xClipMvSearch),
+// they only serve as support of the interpolation filter
+static const int PLANE_BORDER = 8;
+
+enum RowState
+{
+  ROW_EMPTY    = 0,
+  ROW_BUILDING = 1,
+  ROW_DONE     = 2
+};
+
+void SubPelPlanes::init( const CPelBuf& reco, const int margin, const int ctuSizeLog2, const int mode, const int reduceTap )
+{
+  CHECK( mode < 1 || mode > 2, "invalid sub-pel planes mode" );
+  CHECK( margin < ( 1 << ctuSizeLog2 ) + 2 * PLANE_BORDER || ( ( reco.width + 2 * margin ) & 7 ) != 0, "picture geometry not supported by the sub-pel planes" );
+
+  m_reco         = reco;
+  m_mode         = mode;
+  m_margin       = margin;
+  m_ctuSizeLog2  = ctuSizeLog2;
+  m_reduceTap    = reduceTap;
+  m_originOffset = margin * reco.stride + margin;
+
+  const size_t planeSize = ( size_t ) reco.stride * ( reco.height + 2 * margin );
+  const int    fracStep  = mode == 2 ? 1 : 2;
+  for( int fracY = 0; fracY < 4; fracY += fracStep )
+  {
+    for( int fracX = 0; fracX < 4; fracX += fracStep )
+    {
+      if( fracY | fracX )
+      {
+        m_planes[ ( fracY << 2 ) + fracX ].resize( planeSize );
+      }
+    }
+  }
+
+  const size_t numRows = ( reco.height + ( 1 << ctuSizeLog2 ) - 1 ) >> ctuSizeLog2;
+  if( m_rowState.size() != numRows )
+  {
+    m_rowState = std::vector<std::atomic<int>>( numRows );
+  }
+  for( auto& state : m_rowState )
+  {
+    state.store( ROW_EMPTY, std::memory_order_relaxed );
+  }
+
+  m_valid = true;
+}
+
+void SubPelPlanes::prepareRows( InterpolationFilter& filter, const ClpRng& clpRng, const int yStart, const int yEnd ) const
+{
+  const int lastRow  = ( int ) m_rowState.size() - 1;
+  const int rowStart = Clip3( 0, lastRow, yStart >> m_ctuSizeLog2 );
+  const int rowEnd   = Clip3( 0, lastRow, yEnd   >> m_ctuSizeLog2 );
+
+  for( int row = rowStart; row <= rowEnd; row++ )
+  {
+    std::atomic<int>& state = m_rowState[ row ];
+    if( state.load( std::memory_order_acquire ) == ROW_DONE )
+    {
+      continue;
+    }
+
+    int expected = ROW_EMPTY;
+    if( state.compare_exchange_strong( expected, ROW_BUILDING ) )
+    {
+      xBuildRow( filter, clpRng, row );
+      state.store( ROW_DONE, std::memory_order_release );
+    }
+    else
+    {
+      while( state.load( std::memory_order_acquire ) != ROW_DONE )
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+}
+
+void SubPelPlanes::xBuildRow( InterpolationFilter& filter, const ClpRng& clpRng, const int row ) const
+{
+  const int lastRow        = ( int ) m_rowState.size() - 1;
+  const int yStart         = row == 0       ? -m_margin + PLANE_BORDER                 : row << m_ctuSizeLog2;
+  const int yEnd           = row == lastRow ? m_reco.height + m_margin - PLANE_BORDER : ( row + 1 ) << m_ctuSizeLog2;
+  const int xStart         = -m_margin + PLANE_BORDER;
+  const int width          = m_reco.width + 2 * ( m_margin - PLANE_BORDER );
+  const int height         = yEnd - yStart;
+  const int filterSize     = m_reduceTap == 1 ? NTAPS_AFFINE : ( m_reduceTap == 0 ? NTAPS_LUMA : NTAPS_CHROMA );
+  const int halfFilterSize = filterSize >> 1;
+  const int stride         = m_reco.stride;
+  const int fracStep       = m_mode == 2 ? 1 : 2;
+
+  // same separable filtering as the block based interpolation of the motion search, horizontal first
+  std::vector<Pel> tmp( ( height + filterSize - 1 ) * width );
+  const Pel* src    = m_reco.bufAt( xStart, yStart - halfFilterSize + 1 );
+  const Pel* tmpVer = tmp.data() + ( halfFilterSize - 1 ) * width;
+
+  for( int fracX = 0; fracX < 4; fracX += fracStep )
+  {
+    filter.filterHor( COMP_Y, src, stride, tmp.data(), width, width, height + filterSize - 1, fracX << MV_FRACTIONAL_BITS_DIFF, false, CHROMA_420, clpRng, false, 0, m_reduceTap );
+
+    for( int fracY = 0; fracY < 4; fracY += fracStep )
+    {
+      if( fracY | fracX )
+      {
+        Pel* dst = m_planes[ ( fracY << 2 ) + fracX ].data() + m_originOffset + yStart * stride + xStart;
+        filter.filterVer( COMP_Y, tmpVer, width, dst, stride, width, height, fracY << MV_FRACTIONAL_BITS_DIFF, false, true, CHROMA_420, clpRng, false, 0, m_reduceTap );
+      }
+    }
+  }
+}
+
+} // namespace vvenc
+
+//! \}
@@ -0,0 +1,101 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     SubPelPlanes.h
+ *  \brief    sub-pel interpolated luma planes of a reconstructed picture for the fractional motion search
+ */
+
+#pragma once
+
+#include "CommonDef.h"
+#include "Common.h"
+#include "Unit.h"
+
+#include <vector>
+#include <atomic>
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+class InterpolationFilter;
+
+/// luma planes of a reference picture interpolated at the half-pel phases (mode 1) or at all 15 sub-pel phases (mode 2),
+/// built lazily one CTU row at a time, the first thread needing a row builds it, all others wait for it
+class SubPelPlanes
+{
+public:
+  SubPelPlanes() : m_mode( 0 ), m_margin( 0 ), m_ctuSizeLog2( 0 ), m_reduceTap( 0 ), m_valid( false ) {}
+
+  void         init           ( const CPelBuf& reco, const int margin, const int ctuSizeLog2, const int mode, const int reduceTap );
+  void         clear          ()                          { m_valid = false; }
+  bool         isValid        ()                    const { return m_valid; }
+
+  // phase (0,0) is the reconstruction itself
+  bool         hasPhase       ( const int fracY, const int fracX ) const { return m_mode == 2 || ( ( fracY | fracX ) & 1 ) == 0; }
+  int          getStride      ()                    const { return m_reco.stride; }
+  const Pel*   getBuf         ( const int fracY, const int fracX, const int x, const int y ) const
+  {
+    const Pel* origin = ( fracY | fracX ) ? m_planes[ ( fracY << 2 ) + fracX ].data() + m_originOffset : m_reco.buf;
+    return origin + y * m_reco.stride + x;
+  }
+
+  // makes sure all CTU rows covering the sample rows [yStart, yEnd] are interpolated
+  void         prepareRows    ( InterpolationFilter& filter, const ClpRng& clpRng, const int yStart, const int yEnd ) const;
+
+private:
+  void         xBuildRow      ( InterpolationFilter& filter, const ClpRng& clpRng, const int row ) const;
+
+  CPelBuf                          m_reco;
+  int                              m_mode;
+  int                              m_margin;
+  int                              m_ctuSizeLog2;
+  int                              m_reduceTap;
+  int                              m_originOffset;
+  bool                             m_valid;
+  mutable std::vector<Pel>         m_planes[ 16 ];
+  mutable std::vector<std::atomic<int>> m_rowState;
+};
+
+} // namespace vvenc
+
+//! \}
@@ -2486,6 +2486,345 @@ uint64_t AvgHighPassWithDownsamplingDiff2nd_SIMD (const int width,const int heig
   return taAct ;
 }
 
+template<X86_VEXT vext>
+void downsample2x2_SIMD( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height )
+{
+  const __m128i vone = _mm_set1_epi16( 1 );
+  const __m128i vrnd = _mm_set1_epi32( 2 );
+#if USE_AVX2
+  const __m256i wone = _mm256_set1_epi16( 1 );
+  const __m256i wrnd = _mm256_set1_epi32( 2 );
+#endif
+
+  for( int y = 0; y < height; y++, src += 2 * srcStride, dst += dstStride )
+  {
+    const Pel* srcBelow = src + srcStride;
+    int x = 0;
+#if USE_AVX2
+    for( ; x + 16 <= width; x += 16 )
+    {
+      // pairwise horizontal sums of both rows in 32 bit, then round, shift and pack back to 16 bit
+      __m256i va = _mm256_add_epi32( _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) &src     [2 * x     ] ), wone ),
+                                     _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) &srcBelow[2 * x     ] ), wone ) );
+      __m256i vb = _mm256_add_epi32( _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) &src     [2 * x + 16] ), wone ),
+                                     _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) &srcBelow[2 * x + 16] ), wone ) );
+      va = _mm256_srai_epi32( _mm256_add_epi32( va, wrnd ), 2 );
+      vb = _mm256_srai_epi32( _mm256_add_epi32( vb, wrnd ), 2 );
+      _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_permute4x64_epi64( _mm256_packs_epi32( va, vb ), 0xd8 ) );
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      __m128i va = _mm_add_epi32( _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &src     [2 * x    ] ), vone ),
+                                  _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &srcBelow[2 * x    ] ), vone ) );
+      __m128i vb = _mm_add_epi32( _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &src     [2 * x + 8] ), vone ),
+                                  _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &srcBelow[2 * x + 8] ), vone ) );
+      va = _mm_srai_epi32( _mm_add_epi32( va, vrnd ), 2 );
+      vb = _mm_srai_epi32( _mm_add_epi32( vb, vrnd ), 2 );
+      _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_packs_epi32( va, vb ) );
+    }
+    for( ; x < width; x++ )
+    {
+      dst[x] = ( src[2 * x] + src[2 * x + 1] + srcBelow[2 * x] + srcBelow[2 * x + 1] + 2 ) >> 2;
+    }
+  }
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+}
+
+template<X86_VEXT vext>
+void resampleHor_SIMD( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height, const int* srcOffsets, const int16_t* coeffs, const int numTaps, const int shift )
+{
+  const int     offset  = 1 << ( shift - 1 );
+  const __m128i voffset = _mm_set1_epi32( offset );
+
+  for( int y = 0; y < height; y++, src += srcStride, dst += dstStride )
+  {
+    int x = 0;
+    // vectorized over the taps, the dot products of four output samples are reduced together
+    for( ; ( numTaps & 7 ) == 0 && x + 4 <= width; x += 4 )
+    {
+      __m128i vsum[4];
+      for( int j = 0; j < 4; j++ )
+      {
+        const Pel*     s     = src + srcOffsets[x + j];
+        const int16_t* coeff = coeffs + ( x + j ) * numTaps;
+        int            k     = 0;
+#if USE_AVX2
+        __m256i wacc = _mm256_setzero_si256();
+        for( ; k + 16 <= numTaps; k += 16 )
+        {
+          wacc = _mm256_add_epi32( wacc, _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) &s[k] ), _mm256_loadu_si256( ( const __m256i* ) &coeff[k] ) ) );
+        }
+        __m128i acc = _mm_add_epi32( _mm256_castsi256_si128( wacc ), _mm256_extracti128_si256( wacc, 1 ) );
+#else
+        __m128i acc = _mm_setzero_si128();
+#endif
+        for( ; k < numTaps; k += 8 )
+        {
+          acc = _mm_add_epi32( acc, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &s[k] ), _mm_loadu_si128( ( const __m128i* ) &coeff[k] ) ) );
+        }
+        vsum[j] = acc;
+      }
+      __m128i vres = _mm_hadd_epi32( _mm_hadd_epi32( vsum[0], vsum[1] ), _mm_hadd_epi32( vsum[2], vsum[3] ) );
+      vres = _mm_srai_epi32( _mm_add_epi32( vres, voffset ), shift );
+      _mm_storel_epi64( ( __m128i* ) &dst[x], _mm_packs_epi32( vres, vres ) );
+    }
+    for( ; x < width; x++ )
+    {
+      const Pel*     s     = src + srcOffsets[x];
+      const int16_t* coeff = coeffs + x * numTaps;
+      int            sum   = 0;
+      for( int k = 0; k < numTaps; k++ )
+      {
+        sum += s[k] * coeff[k];
+      }
+      dst[x] = Pel( ( sum + offset ) >> shift );
+    }
+  }
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+}
+
+template<X86_VEXT vext>
+void resampleVer_SIMD( const Pel* src, const int srcStride, Pel* dst, const int dstStride, const int width, const int height, const int* srcOffsets, const int16_t* coeffs, const int numTaps, const int shift, const ClpRng& clpRng )
+{
+  const int     offset  = 1 << ( shift - 1 );
+  const __m128i voffset = _mm_set1_epi32( offset );
+  const __m128i vzero   = _mm_setzero_si128();
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max() );
+#if USE_AVX2
+  const __m256i woffset = _mm256_set1_epi32( offset );
+  const __m256i wzero   = _mm256_setzero_si256();
+  const __m256i wmax    = _mm256_set1_epi16( clpRng.max() );
+#endif
+
+  for( int y = 0; y < height; y++, dst += dstStride, coeffs += numTaps )
+  {
+    const Pel* s = src + srcOffsets[y] * srcStride;
+    int x = 0;
+#if USE_AVX2
+    for( ; x + 16 <= width; x += 16 )
+    {
+      // two lines are interleaved to multiply-add them with a pair of coefficients
+      __m256i vlo = wzero;
+      __m256i vhi = wzero;
+      int     k   = 0;
+      for( ; k + 2 <= numTaps; k += 2 )
+      {
+        const __m256i vr0 = _mm256_loadu_si256( ( const __m256i* ) &s[  k       * srcStride + x] );
+        const __m256i vr1 = _mm256_loadu_si256( ( const __m256i* ) &s[( k + 1 ) * srcStride + x] );
+        const __m256i vc  = _mm256_set1_epi32( ( int ) ( ( uint32_t ) ( uint16_t ) coeffs[k + 1] << 16 | ( uint16_t ) coeffs[k] ) );
+        vlo = _mm256_add_epi32( vlo, _mm256_madd_epi16( _mm256_unpacklo_epi16( vr0, vr1 ), vc ) );
+        vhi = _mm256_add_epi32( vhi, _mm256_madd_epi16( _mm256_unpackhi_epi16( vr0, vr1 ), vc ) );
+      }
+      if( k < numTaps )
+      {
+        const __m256i vr0 = _mm256_loadu_si256( ( const __m256i* ) &s[k * srcStride + x] );
+        const __m256i vc  = _mm256_set1_epi32( ( uint16_t ) coeffs[k] );
+        vlo = _mm256_add_epi32( vlo, _mm256_madd_epi16( _mm256_unpacklo_epi16( vr0, wzero ), vc ) );
+        vhi = _mm256_add_epi32( vhi, _mm256_madd_epi16( _mm256_unpackhi_epi16( vr0, wzero ), vc ) );
+      }
+      vlo = _mm256_srai_epi32( _mm256_add_epi32( vlo, woffset ), shift );
+      vhi = _mm256_srai_epi32( _mm256_add_epi32( vhi, woffset ), shift );
+      const __m256i vres = _mm256_min_epi16( _mm256_max_epi16( _mm256_packs_epi32( vlo, vhi ), wzero ), wmax );
+      _mm256_storeu_si256( ( __m256i* ) &dst[x], vres );
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      __m128i vlo = vzero;
+      __m128i vhi = vzero;
+      int     k   = 0;
+      for( ; k + 2 <= numTaps; k += 2 )
+      {
+        const __m128i vr0 = _mm_loadu_si128( ( const __m128i* ) &s[  k       * srcStride + x] );
+        const __m128i vr1 = _mm_loadu_si128( ( const __m128i* ) &s[( k + 1 ) * srcStride + x] );
+        const __m128i vc  = _mm_set1_epi32( ( int ) ( ( uint32_t ) ( uint16_t ) coeffs[k + 1] << 16 | ( uint16_t ) coeffs[k] ) );
+        vlo = _mm_add_epi32( vlo, _mm_madd_epi16( _mm_unpacklo_epi16( vr0, vr1 ), vc ) );
+        vhi = _mm_add_epi32( vhi, _mm_madd_epi16( _mm_unpackhi_epi16( vr0, vr1 ), vc ) );
+      }
+      if( k < numTaps )
+      {
+        const __m128i vr0 = _mm_loadu_si128( ( const __m128i* ) &s[k * srcStride + x] );
+        const __m128i vc  = _mm_set1_epi32( ( uint16_t ) coeffs[k] );
+        vlo = _mm_add_epi32( vlo, _mm_madd_epi16( _mm_unpacklo_epi16( vr0, vzero ), vc ) );
+        vhi = _mm_add_epi32( vhi, _mm_madd_epi16( _mm_unpackhi_epi16( vr0, vzero ), vc ) );
+      }
+      vlo = _mm_srai_epi32( _mm_add_epi32( vlo, voffset ), shift );
+      vhi = _mm_srai_epi32( _mm_add_epi32( vhi, voffset ), shift );
+      const __m128i vres = _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( vlo, vhi ), vzero ), vmax );
+      _mm_storeu_si128( ( __m128i* ) &dst[x], vres );
+    }
+    for( ; x < width; x++ )
+    {
+      int sum = 0;
+      for( int k = 0; k < numTaps; k++ )
+      {
+        sum += s[k * srcStride + x] * coeffs[k];
+      }
+      dst[x] = Pel( ClipPel<int>( ( sum + offset ) >> shift, clpRng ) );
+    }
+  }
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+}
+
+template<X86_VEXT vext>
+uint64_t ssd_SIMD( const Pel* src0, const int src0Stride, const Pel* src1, const int src1Stride, const int width, const int height )
+{
+  // the squared differences are accumulated in 32 bit for at most 32 vectors, which cannot overflow up to 12 bit samples
+  const int     maxIter = 32;
+  const __m128i vzero   = _mm_setzero_si128();
+  __m128i       vsum64  = vzero;
+#if USE_AVX2
+  const __m256i wzero   = _mm256_setzero_si256();
+  __m256i       wsum64  = wzero;
+#endif
+  uint64_t ssd = 0;
+
+  for( int y = 0; y < height; y++, src0 += src0Stride, src1 += src1Stride )
+  {
+    int x = 0;
+#if USE_AVX2
+    while( x + 16 <= width )
+    {
+      __m256i wsum32 = wzero;
+      for( int n = 0; n < maxIter && x + 16 <= width; n++, x += 16 )
+      {
+        const __m256i wdiff = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) &src0[x] ), _mm256_loadu_si256( ( const __m256i* ) &src1[x] ) );
+        wsum32 = _mm256_add_epi32( wsum32, _mm256_madd_epi16( wdiff, wdiff ) );
+      }
+      wsum64 = _mm256_add_epi64( wsum64, _mm256_unpacklo_epi32( wsum32, wzero ) );
+      wsum64 = _mm256_add_epi64( wsum64, _mm256_unpackhi_epi32( wsum32, wzero ) );
+    }
+#endif
+    while( x + 8 <= width )
+    {
+      __m128i vsum32 = vzero;
+      for( int n = 0; n < maxIter && x + 8 <= width; n++, x += 8 )
+      {
+        const __m128i vdiff = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) &src0[x] ), _mm_loadu_si128( ( const __m128i* ) &src1[x] ) );
+        vsum32 = _mm_add_epi32( vsum32, _mm_madd_epi16( vdiff, vdiff ) );
+      }
+      vsum64 = _mm_add_epi64( vsum64, _mm_unpacklo_epi32( vsum32, vzero ) );
+      vsum64 = _mm_add_epi64( vsum64, _mm_unpackhi_epi32( vsum32, vzero ) );
+    }
+    for( ; x < width; x++ )
+    {
+      const int diff = src0[x] - src1[x];
+      ssd += uint64_t( diff * diff );
+    }
+  }
+
+#if USE_AVX2
+  vsum64 = _mm_add_epi64( vsum64, _mm_add_epi64( _mm256_castsi256_si128( wsum64 ), _mm256_extracti128_si256( wsum64, 1 ) ) );
+#endif
+  vsum64 = _mm_add_epi64( vsum64, _mm_unpackhi_epi64( vsum64, vsum64 ) );
+  uint64_t vssd;
+  _mm_storel_epi64( ( __m128i* ) &vssd, vsum64 );
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+  return ssd + vssd;
+}
+
+template<X86_VEXT vext>
+void ssimSums4x4_SIMD( const Pel* src0, const int src0Stride, const Pel* src1, const int src1Stride, const int numBlocks, int* sums, const int sumsStride )
+{
+  int* sum0 = sums;
+  int* sum1 = sums + 1 * sumsStride;
+  int* sqr0 = sums + 2 * sumsStride;
+  int* sqr1 = sums + 3 * sumsStride;
+  int* prod = sums + 4 * sumsStride;
+  int  b    = 0;
+
+#if USE_AVX2
+  const __m256i wone = _mm256_set1_epi16( 1 );
+  for( ; b + 4 <= numBlocks; b += 4 )
+  {
+    __m256i wsum0 = _mm256_setzero_si256();
+    __m256i wsum1 = _mm256_setzero_si256();
+    __m256i wsqr0 = _mm256_setzero_si256();
+    __m256i wsqr1 = _mm256_setzero_si256();
+    __m256i wprod = _mm256_setzero_si256();
+    for( int y = 0; y < 4; y++ )
+    {
+      const __m256i wa = _mm256_loadu_si256( ( const __m256i* ) &src0[y * src0Stride + 4 * b] );
+      const __m256i wc = _mm256_loadu_si256( ( const __m256i* ) &src1[y * src1Stride + 4 * b] );
+      wsum0 = _mm256_add_epi32( wsum0, _mm256_madd_epi16( wa, wone ) );
+      wsum1 = _mm256_add_epi32( wsum1, _mm256_madd_epi16( wc, wone ) );
+      wsqr0 = _mm256_add_epi32( wsqr0, _mm256_madd_epi16( wa, wa ) );
+      wsqr1 = _mm256_add_epi32( wsqr1, _mm256_madd_epi16( wc, wc ) );
+      wprod = _mm256_add_epi32( wprod, _mm256_madd_epi16( wa, wc ) );
+    }
+    // each pair of 32 bit lanes belongs to one block, reduce the pairs and bring the four blocks of each sum in order
+    const __m256i wsums = _mm256_permute4x64_epi64( _mm256_hadd_epi32( wsum0, wsum1 ), 0xd8 );
+    const __m256i wsqrs = _mm256_permute4x64_epi64( _mm256_hadd_epi32( wsqr0, wsqr1 ), 0xd8 );
+    const __m256i wprds = _mm256_permute4x64_epi64( _mm256_hadd_epi32( wprod, wprod ), 0xd8 );
+    _mm_storeu_si128( ( __m128i* ) &sum0[b], _mm256_castsi256_si128   ( wsums ) );
+    _mm_storeu_si128( ( __m128i* ) &sum1[b], _mm256_extracti128_si256( wsums, 1 ) );
+    _mm_storeu_si128( ( __m128i* ) &sqr0[b], _mm256_castsi256_si128   ( wsqrs ) );
+    _mm_storeu_si128( ( __m128i* ) &sqr1[b], _mm256_extracti128_si256( wsqrs, 1 ) );
+    _mm_storeu_si128( ( __m128i* ) &prod[b], _mm256_castsi256_si128   ( wprds ) );
+  }
+#endif
+
+  const __m128i vone = _mm_set1_epi16( 1 );
+  for( ; b < numBlocks; b += 2 )
+  {
+    // two blocks per iteration, a single remaining block is loaded with zeroed upper half
+    const bool pair  = b + 2 <= numBlocks;
+    __m128i    vsum0 = _mm_setzero_si128();
+    __m128i    vsum1 = _mm_setzero_si128();
+    __m128i    vsqr0 = _mm_setzero_si128();
+    __m128i    vsqr1 = _mm_setzero_si128();
+    __m128i    vprod = _mm_setzero_si128();
+    for( int y = 0; y < 4; y++ )
+    {
+      const Pel*    pa = &src0[y * src0Stride + 4 * b];
+      const Pel*    pc = &src1[y * src1Stride + 4 * b];
+      const __m128i va = pair ? _mm_loadu_si128( ( const __m128i* ) pa ) : _mm_loadl_epi64( ( const __m128i* ) pa );
+      const __m128i vc = pair ? _mm_loadu_si128( ( const __m128i* ) pc ) : _mm_loadl_epi64( ( const __m128i* ) pc );
+      vsum0 = _mm_add_epi32( vsum0, _mm_madd_epi16( va, vone ) );
+      vsum1 = _mm_add_epi32( vsum1, _mm_madd_epi16( vc, vone ) );
+      vsqr0 = _mm_add_epi32( vsqr0, _mm_madd_epi16( va, va ) );
+      vsqr1 = _mm_add_epi32( vsqr1, _mm_madd_epi16( vc, vc ) );
+      vprod = _mm_add_epi32( vprod, _mm_madd_epi16( va, vc ) );
+    }
+    const __m128i vsums = _mm_hadd_epi32( vsum0, vsum1 );
+    const __m128i vsqrs = _mm_hadd_epi32( vsqr0, vsqr1 );
+    const __m128i vprds = _mm_hadd_epi32( vprod, vprod );
+    if( pair )
+    {
+      _mm_storel_epi64( ( __m128i* ) &sum0[b], vsums );
+      _mm_storel_epi64( ( __m128i* ) &sum1[b], _mm_unpackhi_epi64( vsums, vsums ) );
+      _mm_storel_epi64( ( __m128i* ) &sqr0[b], vsqrs );
+      _mm_storel_epi64( ( __m128i* ) &sqr1[b], _mm_unpackhi_epi64( vsqrs, vsqrs ) );
+      _mm_storel_epi64( ( __m128i* ) &prod[b], vprds );
+    }
+    else
+    {
+      sum0[b] = _mm_cvtsi128_si32( vsums );
+      sum1[b] = _mm_extract_epi32( vsums, 2 );
+      sqr0[b] = _mm_cvtsi128_si32( vsqrs );
+      sqr1[b] = _mm_extract_epi32( vsqrs, 2 );
+      prod[b] = _mm_cvtsi128_si32( vprds );
+    }
+  }
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+}
+
 template<X86_VEXT vext>
 void PelBufferOps::_initPelBufOpsX86()
 {
@@ -2538,6 +2877,11 @@ void PelBufferOps::_initPelBufOpsX86()
   AvgHighPassWithDownsamplingDiff2nd = AvgHighPassWithDownsamplingDiff2nd_SIMD<vext>;
   HDHighPass = HDHighPass_SIMD<vext>;
   HDHighPass2 = HDHighPass2_SIMD<vext>;
+  downsample2x2 = downsample2x2_SIMD<vext>;
+  resampleHor = resampleHor_SIMD<vext>;
+  resampleVer = resampleVer_SIMD<vext>;
+  ssd = ssd_SIMD<vext>;
+  ssimSums4x4 = ssimSums4x4_SIMD<vext>;
 }
 
 template void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
@@ -72,6 +72,11 @@ private:
   double    m_dFrmRate; //--CFG_KDY
   double    m_MSEyuvframe[MAX_NUM_COMP]; // sum of MSEs
   uint32_t  m_uiLosslessFrames[MAX_NUM_COMP];
+  double    m_ssimSum;
+  double    m_msSsimSum;
+  double    m_vifSum;
+  double    m_detailSum;
+  uint32_t  m_uiNumQualityPic;
 
 public:
   virtual ~Analyze()  {}
@@ -99,6 +104,14 @@ public:
 
     m_uiNumPic++;
   }
+  void  addQualityResult( double ssim, double msSsim, double vif, double detail )
+  {
+    m_ssimSum   += ssim;
+    m_msSsimSum += msSsim;
+    m_vifSum    += vif;
+    m_detailSum += detail;
+    m_uiNumQualityPic++;
+  }
   double  getPsnr(ComponentID compID) const { return  m_dPSNRSum[compID];  }
   double  getBits()                   const { return  m_dAddBits;   }
   void    setBits(double numBits)     { m_dAddBits = numBits; }
@@ -117,6 +130,11 @@ public:
       m_uiLosslessFrames[i] = 0;
     }
     m_uiNumPic = 0;
+    m_ssimSum   = 0;
+    m_msSsimSum = 0;
+    m_vifSum    = 0;
+    m_detailSum = 0;
+    m_uiNumQualityPic = 0;
   }
 
 
@@ -443,6 +461,14 @@ public:
         info.append(prnt("vvenc [info]: Unknown format during print out\n"));
         break;
     }
+
+    if( m_uiNumQualityPic )
+    {
+      const double ssim = m_ssimSum / m_uiNumQualityPic;
+      info.append( prnt( "vvenc [info]:\t Y-SSIM %8.4lf (%7.4lf dB)  MS-SSIM %8.4lf  VIF %8.4lf  DLM %8.4lf\n",
+                         ssim, ssim < 1.0 ? -10.0 * log10( 1.0 - ssim ) : 99.9999,
+                         m_msSsimSum / m_uiNumQualityPic, m_vifSum / m_uiNumQualityPic, m_detailSum / m_uiNumQualityPic ) );
+    }
     return info;
   }
 
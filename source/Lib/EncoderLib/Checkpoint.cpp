@@ -0,0 +1,159 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     Checkpoint.cpp
+    \brief    serialization of the encoder state for checkpoint / restart
+*/
+
+
+#include "Checkpoint.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+static const char     CHECKPOINT_MAGIC[ 4 ]     = { 'V', 'V', 'C', 'P' };
+static const uint32_t CHECKPOINT_FORMAT_VERSION = 1;
+
+struct CheckpointFileHeader
+{
+  char     magic[ 4 ];
+  uint32_t formatVersion;
+  uint64_t cfgSignature;
+  int64_t  bitstreamSize;
+  uint64_t dataSize;
+};
+
+void CheckpointStream::writeBytes( const void* src, size_t size )
+{
+  const uint8_t* bytes = (const uint8_t*) src;
+  m_data.insert( m_data.end(), bytes, bytes + size );
+}
+
+void CheckpointStream::readBytes( void* dst, size_t size )
+{
+  CHECK( size > m_data.size() - m_readPos, "checkpoint data corrupted" );
+  memcpy( dst, m_data.data() + m_readPos, size );
+  m_readPos += size;
+}
+
+void CheckpointStream::writeStream( const CheckpointStream& stream )
+{
+  write<uint64_t>( stream.m_data.size() );
+  writeBytes( stream.m_data.data(), stream.m_data.size() );
+}
+
+void CheckpointStream::readStream( CheckpointStream& stream )
+{
+  const uint64_t size = read<uint64_t>();
+  CHECK( size > m_data.size() - m_readPos, "checkpoint data corrupted" );
+  stream.m_data.assign( m_data.begin() + m_readPos, m_data.begin() + m_readPos + size );
+  stream.m_readPos = 0;
+  m_readPos += size;
+}
+
+uint64_t getCheckpointSignature( const std::string& cfgString )
+{
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for( const char c : cfgString )
+  {
+    hash ^= (uint8_t) c;
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+void writeCheckpointFile( const std::string& fileName, uint64_t cfgSignature, int64_t bitstreamSize, const CheckpointStream& stream )
+{
+  CheckpointFileHeader header;
+  memset( &header, 0, sizeof( header ) );
+  std::copy( CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + sizeof( CHECKPOINT_MAGIC ), header.magic );
+  header.formatVersion = CHECKPOINT_FORMAT_VERSION;
+  header.cfgSignature  = cfgSignature;
+  header.bitstreamSize = bitstreamSize;
+  header.dataSize      = stream.data().size();
+
+  // write to a temporary file first, the last complete checkpoint survives an interruption while writing
+  const std::string tmpName = fileName + ".tmp";
+  {
+    std::ofstream file( tmpName, std::ios::binary | std::ios::trunc );
+    CHECK( ! file.is_open(), "unable to open checkpoint file " << tmpName );
+    file.write( (const char*) &header, sizeof( header ) );
+    file.write( (const char*) stream.data().data(), stream.data().size() );
+    file.flush();
+    CHECK( file.fail(), "unable to write checkpoint file " << tmpName );
+  }
+  std::remove( fileName.c_str() );
+  CHECK( std::rename( tmpName.c_str(), fileName.c_str() ) != 0, "unable to replace checkpoint file " << fileName );
+}
+
+void readCheckpointFile( const std::string& fileName, uint64_t cfgSignature, int64_t& bitstreamSize, CheckpointStream& stream )
+{
+  std::ifstream file( fileName, std::ios::binary );
+  CHECK( ! file.is_open(), "unable to open checkpoint file " << fileName );
+
+  CheckpointFileHeader header;
+  file.read( (char*) &header, sizeof( header ) );
+  CHECK( file.fail(), "unable to read header from checkpoint file" );
+  if( memcmp( header.magic, CHECKPOINT_MAGIC, sizeof( CHECKPOINT_MAGIC ) ) || header.formatVersion != CHECKPOINT_FORMAT_VERSION )
+  {
+    THROW( "header in checkpoint file not recognized" );
+  }
+  CHECK( header.cfgSignature != cfgSignature, "checkpoint file has been written with a different encoder configuration" );
+
+  std::vector<uint8_t> data( header.dataSize );
+  file.read( (char*) data.data(), data.size() );
+  CHECK( file.fail(), "checkpoint file is incomplete" );
+
+  bitstreamSize = header.bitstreamSize;
+  stream.assign( data );
+}
+
+} // namespace vvenc
+
+//! \}
+
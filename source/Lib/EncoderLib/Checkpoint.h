@@ -0,0 +1,144 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     Checkpoint.h
+    \brief    serialization of the encoder state for checkpoint / restart (header)
+*/
+
+
+#pragma once
+
+#include "CommonLib/CommonDef.h"
+
+#include <deque>
+#include <list>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+// ====================================================================================================================
+
+// byte stream holding the serialized state of the encoder components, read back in the order it was written
+class CheckpointStream
+{
+  private:
+    std::vector<uint8_t> m_data;
+    size_t               m_readPos;
+
+  public:
+    CheckpointStream() : m_readPos( 0 ) {}
+
+    const std::vector<uint8_t>& data() const { return m_data; }
+    bool                        empty() const { return m_data.empty(); }
+    bool                        atEnd() const { return m_readPos >= m_data.size(); }
+
+    void clear()                                   { m_data.clear(); m_readPos = 0; }
+    void assign( const std::vector<uint8_t>& data ) { m_data = data; m_readPos = 0; }
+
+    void writeBytes( const void* src, size_t size );
+    void readBytes ( void* dst, size_t size );
+
+    template<typename T>
+    void write( const T& val )
+    {
+      static_assert( std::is_trivially_copyable<T>::value, "only trivially copyable types can be serialized" );
+      writeBytes( &val, sizeof( T ) );
+    }
+
+    template<typename T>
+    void read( T& val )
+    {
+      static_assert( std::is_trivially_copyable<T>::value, "only trivially copyable types can be serialized" );
+      readBytes( &val, sizeof( T ) );
+    }
+
+    template<typename T>
+    T read()
+    {
+      T val;
+      read( val );
+      return val;
+    }
+
+    template<typename C>
+    void writeRange( const C& c )
+    {
+      write<uint32_t>( (uint32_t) c.size() );
+      for( const auto& val : c )
+      {
+        write( val );
+      }
+    }
+
+    template<typename C>
+    void readRange( C& c )
+    {
+      const uint32_t size = read<uint32_t>();
+      CHECK( size > m_data.size() - m_readPos, "checkpoint data corrupted" );
+      c.clear();
+      for( uint32_t i = 0; i < size; i++ )
+      {
+        typename C::value_type val;
+        read( val );
+        c.push_back( val );
+      }
+    }
+
+    void writeStream( const CheckpointStream& stream );
+    void readStream ( CheckpointStream& stream );
+};
+
+// signature of the encoder configuration, a checkpoint can only be resumed with the same configuration
+uint64_t getCheckpointSignature( const std::string& cfgString );
+
+// checkpoint file: header with the configuration signature and the bitstream position, followed by the encoder state
+void writeCheckpointFile( const std::string& fileName, uint64_t cfgSignature, int64_t bitstreamSize, const CheckpointStream& stream );
+void readCheckpointFile ( const std::string& fileName, uint64_t cfgSignature, int64_t& bitstreamSize, CheckpointStream& stream );
+
+} // namespace vvenc
+
+//! \}
+
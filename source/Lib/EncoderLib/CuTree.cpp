@@ -0,0 +1,390 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+
+
+/** \file     CuTree.cpp
+    \brief    CU-tree QP propagation over a look-ahead window
+*/
+
+
+#include "CuTree.h"
+#include "CommonLib/Picture.h"
+
+#include <cmath>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+const int    CuTree::m_blkSize     = 8;    // 16x16 luma samples
+const int    CuTree::m_searchRange = 32;
+const double CuTree::m_strength    = 2.0;
+const int    CuTree::m_maxQpOffset = 3;
+
+
+CuTree::CuTree()
+  : m_encCfg      ( nullptr )
+  , m_window      ( 0 )
+  , m_procPoc     ( 0 )
+  , m_lowResWidth ( 0 )
+  , m_lowResHeight( 0 )
+  , m_widthInBlks ( 0 )
+  , m_heightInBlks( 0 )
+{
+}
+
+
+CuTree::~CuTree()
+{
+}
+
+
+void CuTree::init( const VVEncCfg& encCfg )
+{
+  m_encCfg  = &encCfg;
+  m_window  = encCfg.m_cuTree;
+  m_procPoc = 0;
+  m_frames.clear();
+}
+
+
+void CuTree::initPicture( Picture* pic )
+{
+  CHECK( ! m_frames.empty() && m_frames.back().poc >= pic->poc, "CuTree: pictures not in display order" );
+
+  m_frames.push_back( CuTreeFrame() );
+  CuTreeFrame& frame = m_frames.back();
+  frame.poc = pic->poc;
+  xInitLowRes( pic, frame );
+
+  // intra pictures and gaps in the look-ahead do not propagate into the previous picture
+  const CuTreeFrame* prevFrame = m_frames.size() > 1 ? &m_frames[ m_frames.size() - 2 ] : nullptr;
+  if( prevFrame && ( prevFrame->poc != pic->poc - 1 || pic->gopEntry->m_sliceType == 'I' ) )
+  {
+    prevFrame = nullptr;
+  }
+  xEstimateCosts( frame, prevFrame );
+}
+
+
+void CuTree::processPictures( const PicList& picList, AccessUnitList& auList, PicList& doneList, PicList& freeList )
+{
+  if( picList.empty() )
+  {
+    return;
+  }
+
+  // process next picture, when its look-ahead window is complete or the encoder is flushed
+  Picture* pic = nullptr;
+  for( auto p : picList )
+  {
+    if( p->poc == m_procPoc )
+    {
+      pic = p;
+      break;
+    }
+  }
+  if( pic && ( picList.back()->poc >= m_procPoc + m_window || picList.back()->isFlush ) )
+  {
+    CHECK( m_frames.empty() || m_frames.front().poc != m_procPoc, "CuTree: look-ahead data missing" );
+    const int numFrames = std::min( m_window + 1, (int)m_frames.size() );
+    xSetQpOffsets( pic, xPropagate( numFrames ) );
+    doneList.push_back( pic );
+    m_frames.pop_front();
+    m_procPoc += 1;
+  }
+
+  // release pictures already processed
+  for( auto p : picList )
+  {
+    if( p->poc >= m_procPoc )
+      break;
+    freeList.push_back( p );
+  }
+}
+
+
+void CuTree::xInitLowRes( Picture* pic, CuTreeFrame& frame )
+{
+  frame.lowRes = &pic->m_picShared->getLumaPyramid( 0 );
+
+  const int width  = frame.lowRes->Y().width;
+  const int height = frame.lowRes->Y().height;
+  if( m_lowResWidth == 0 )
+  {
+    m_lowResWidth  = width;
+    m_lowResHeight = height;
+    m_widthInBlks  = ( width  + m_blkSize - 1 ) / m_blkSize;
+    m_heightInBlks = ( height + m_blkSize - 1 ) / m_blkSize;
+  }
+  CHECK( width != m_lowResWidth || height != m_lowResHeight, "CuTree: resolution changed" );
+}
+
+
+uint32_t CuTree::xBlockSad( const CuTreeFrame& cur, const CuTreeFrame& ref, int x, int y, int w, int h, const Mv& mv ) const
+{
+  const CPelBuf srcBuf = cur.lowRes->Y();
+  const CPelBuf refBuf = ref.lowRes->Y();
+  const Pel*    src    = srcBuf.bufAt( x, y );
+  const Pel*    buf    = refBuf.bufAt( x + mv.hor, y + mv.ver );
+  uint32_t      sad    = 0;
+  for( int j = 0; j < h; j++, src += srcBuf.stride, buf += refBuf.stride )
+  {
+    for( int i = 0; i < w; i++ )
+    {
+      sad += abs( src[ i ] - buf[ i ] );
+    }
+  }
+  return sad;
+}
+
+
+void CuTree::xEstimateCosts( CuTreeFrame& frame, const CuTreeFrame* prevFrame ) const
+{
+  const int numBlks = m_widthInBlks * m_heightInBlks;
+  frame.intraCost.resize( numBlks );
+  frame.interCost.resize( numBlks );
+  frame.mvs.assign( numBlks, Mv() );
+
+  for( int by = 0; by < m_heightInBlks; by++ )
+  {
+    for( int bx = 0; bx < m_widthInBlks; bx++ )
+    {
+      const int blkIdx = by * m_widthInBlks + bx;
+      const int x      = bx * m_blkSize;
+      const int y      = by * m_blkSize;
+      const int w      = std::min( m_blkSize, m_lowResWidth  - x );
+      const int h      = std::min( m_blkSize, m_lowResHeight - y );
+
+      // intra cost: deviation from the block mean, with a floor for flat blocks
+      const CPelBuf srcBuf = frame.lowRes->Y();
+      const Pel*    src    = srcBuf.bufAt( x, y );
+      int sum = 0;
+      for( int j = 0; j < h; j++ )
+      {
+        for( int i = 0; i < w; i++ )
+        {
+          sum += src[ j * srcBuf.stride + i ];
+        }
+      }
+      const int mean  = ( sum + ( ( w * h ) >> 1 ) ) / ( w * h );
+      uint32_t  intra = w * h;
+      for( int j = 0; j < h; j++ )
+      {
+        for( int i = 0; i < w; i++ )
+        {
+          intra += abs( src[ j * srcBuf.stride + i ] - mean );
+        }
+      }
+      frame.intraCost[ blkIdx ] = intra;
+
+      if( ! prevFrame )
+      {
+        frame.interCost[ blkIdx ] = intra;
+        continue;
+      }
+
+      // inter cost: integer motion search against the previous picture, starting from the best neighbour vector
+      auto isValid = [&]( const Mv& mv )
+      {
+        return abs( mv.hor ) <= m_searchRange && abs( mv.ver ) <= m_searchRange
+            && x + mv.hor >= 0 && x + mv.hor + w <= m_lowResWidth
+            && y + mv.ver >= 0 && y + mv.ver + h <= m_lowResHeight;
+      };
+
+      Mv       bestMv;
+      uint32_t bestSad = xBlockSad( frame, *prevFrame, x, y, w, h, bestMv );
+      const Mv cands[ 3 ] = { bx > 0 ? frame.mvs[ blkIdx - 1 ] : Mv(),
+                              by > 0 ? frame.mvs[ blkIdx - m_widthInBlks ] : Mv(),
+                              by > 0 && bx + 1 < m_widthInBlks ? frame.mvs[ blkIdx - m_widthInBlks + 1 ] : Mv() };
+      for( const Mv& cand : cands )
+      {
+        if( cand != bestMv && isValid( cand ) )
+        {
+          const uint32_t sad = xBlockSad( frame, *prevFrame, x, y, w, h, cand );
+          if( sad < bestSad )
+          {
+            bestSad = sad;
+            bestMv  = cand;
+          }
+        }
+      }
+
+      for( int step = m_blkSize; step > 0; step >>= 1 )
+      {
+        bool improved = true;
+        for( int iter = 0; improved && iter < m_searchRange; iter++ )
+        {
+          improved = false;
+          const Mv center = bestMv;
+          const Mv dirs[ 4 ] = { Mv( step, 0 ), Mv( -step, 0 ), Mv( 0, step ), Mv( 0, -step ) };
+          for( const Mv& dir : dirs )
+          {
+            const Mv cand = center + dir;
+            if( isValid( cand ) )
+            {
+              const uint32_t sad = xBlockSad( frame, *prevFrame, x, y, w, h, cand );
+              if( sad < bestSad )
+              {
+                bestSad  = sad;
+                bestMv   = cand;
+                improved = true;
+              }
+            }
+          }
+        }
+      }
+
+      frame.mvs      [ blkIdx ] = bestMv;
+      frame.interCost[ blkIdx ] = std::min<uint32_t>( bestSad + w * h, intra );
+    }
+  }
+}
+
+
+const std::vector<double>& CuTree::xPropagate( int numFrames )
+{
+  const int numBlks  = m_widthInBlks * m_heightInBlks;
+  const int blkArea  = m_blkSize * m_blkSize;
+  std::vector<double>* propIn  = &m_propagate[ 0 ];
+  std::vector<double>* propOut = &m_propagate[ 1 ];
+  propIn->assign( numBlks, 0.0 );
+
+  // walk back through the look-ahead window, each picture hands the information it inherits to its reference
+  for( int f = numFrames - 1; f > 0; f-- )
+  {
+    const CuTreeFrame& frame = m_frames[ f ];
+    propOut->assign( numBlks, 0.0 );
+
+    for( int by = 0; by < m_heightInBlks; by++ )
+    {
+      for( int bx = 0; bx < m_widthInBlks; bx++ )
+      {
+        const int      blkIdx = by * m_widthInBlks + bx;
+        const uint32_t intra  = frame.intraCost[ blkIdx ];
+        const uint32_t inter  = frame.interCost[ blkIdx ];
+        if( inter >= intra )
+        {
+          continue;
+        }
+
+        // amount of information taken from the reference, split over the blocks covered by the motion compensated block
+        const double amount = ( ( *propIn )[ blkIdx ] + intra ) * ( intra - inter ) / intra;
+        const Mv&    mv     = frame.mvs[ blkIdx ];
+        const int    px     = bx * m_blkSize + mv.hor;
+        const int    py     = by * m_blkSize + mv.ver;
+        const int    x0     = px / m_blkSize;
+        const int    y0     = py / m_blkSize;
+        const int    fx     = px - x0 * m_blkSize;
+        const int    fy     = py - y0 * m_blkSize;
+        const int    weights[ 4 ] = { ( m_blkSize - fx ) * ( m_blkSize - fy ), fx * ( m_blkSize - fy ), ( m_blkSize - fx ) * fy, fx * fy };
+
+        for( int i = 0; i < 4; i++ )
+        {
+          const int rx = x0 + ( i & 1 );
+          const int ry = y0 + ( i >> 1 );
+          if( weights[ i ] && rx < m_widthInBlks && ry < m_heightInBlks )
+          {
+            ( *propOut )[ ry * m_widthInBlks + rx ] += amount * weights[ i ] / blkArea;
+          }
+        }
+      }
+    }
+    std::swap( propIn, propOut );
+  }
+
+  return *propIn;
+}
+
+
+void CuTree::xSetQpOffsets( Picture* pic, const std::vector<double>& propagateIn ) const
+{
+  // only pictures with block importance offsets from MCTF, the others are derived from their references in EncGOP
+  std::vector<int>& ctuQpOffset = pic->m_picShared->m_ctuBimQpOffset;
+  if( ctuQpOffset.empty() )
+  {
+    return;
+  }
+
+  const CuTreeFrame& frame   = m_frames.front();
+  const int ctuSize          = m_encCfg->m_bimCtuSize;
+  const int widthInCtus      = ( pic->lwidth()  + ctuSize - 1 ) / ctuSize;
+  const int heightInCtus     = ( pic->lheight() + ctuSize - 1 ) / ctuSize;
+  const int numCtu           = widthInCtus * heightInCtus;
+  const int ctuBlks          = std::max( 1, ( ctuSize >> 1 ) / m_blkSize );
+  CHECK( (int)ctuQpOffset.size() != numCtu, "CuTree: unexpected number of CTU QP offsets" );
+
+  std::vector<double> sumOffset( numCtu, 0.0 );
+  std::vector<int>    blkCount ( numCtu, 0 );
+  for( int by = 0; by < m_heightInBlks; by++ )
+  {
+    for( int bx = 0; bx < m_widthInBlks; bx++ )
+    {
+      const int    blkIdx = by * m_widthInBlks + bx;
+      const int    ctuId  = std::min( by / ctuBlks, heightInCtus - 1 ) * widthInCtus + std::min( bx / ctuBlks, widthInCtus - 1 );
+      const double intra  = frame.intraCost[ blkIdx ];
+      sumOffset[ ctuId ] -= m_strength * log2( ( intra + propagateIn[ blkIdx ] ) / intra );
+      blkCount [ ctuId ] += 1;
+    }
+  }
+
+  int sumCtuQpOffsets = 0;
+  for( int i = 0; i < numCtu; i++ )
+  {
+    const double avgOffset = blkCount[ i ] ? sumOffset[ i ] / blkCount[ i ] : 0.0;
+    ctuQpOffset[ i ]       = Clip3( -m_maxQpOffset, m_maxQpOffset, (int)floor( avgOffset + 0.5 ) );
+    sumCtuQpOffsets       += ctuQpOffset[ i ];
+  }
+
+  // same convention as the MCTF based offsets: picture average in the aux QP offset, CTU offsets relative to it
+  pic->m_picShared->m_picAuxQpOffset = ( sumCtuQpOffsets + ( sumCtuQpOffsets < 0 ? -(numCtu >> 1) : numCtu >> 1 ) ) / numCtu;
+  for( int i = 0; i < numCtu; i++ )
+  {
+    ctuQpOffset[ i ] -= pic->m_picShared->m_picAuxQpOffset;
+  }
+}
+
+} // namespace vvenc
+
+//! \}
+
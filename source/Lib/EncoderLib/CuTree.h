@@ -0,0 +1,113 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+
+
+/** \file     CuTree.h
+    \brief    CU-tree QP propagation over a look-ahead window (header)
+*/
+
+
+#pragma once
+
+#include "CommonLib/CommonDef.h"
+#include "EncStage.h"
+
+#include <deque>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+// ====================================================================================================================
+
+class CuTree : public EncStage
+{
+  private:
+    // half resolution luma and block costs of one look-ahead picture
+    struct CuTreeFrame
+    {
+      int                   poc;
+      const PelStorage*     lowRes;       // shared luma pyramid level of the picture
+      std::vector<uint32_t> intraCost;
+      std::vector<uint32_t> interCost;    // against the preceding picture in display order
+      std::vector<Mv>       mvs;          // integer sample vectors in the half resolution picture
+    };
+
+    static const int      m_blkSize;      // block size in the half resolution picture
+    static const int      m_searchRange;
+    static const double   m_strength;
+    static const int      m_maxQpOffset;
+
+    const VVEncCfg*       m_encCfg;
+    int                   m_window;
+    int                   m_procPoc;
+    int                   m_lowResWidth;
+    int                   m_lowResHeight;
+    int                   m_widthInBlks;
+    int                   m_heightInBlks;
+    std::deque<CuTreeFrame> m_frames;
+    std::vector<double>   m_propagate[ 2 ];
+
+  public:
+    CuTree();
+    virtual ~CuTree();
+
+    void init( const VVEncCfg& encCfg );
+
+  protected:
+    virtual void initPicture    ( Picture* pic );
+    virtual void processPictures( const PicList& picList, AccessUnitList& auList, PicList& doneList, PicList& freeList );
+
+  private:
+    void     xInitLowRes     ( Picture* pic, CuTreeFrame& frame );
+    void     xEstimateCosts  ( CuTreeFrame& frame, const CuTreeFrame* prevFrame ) const;
+    uint32_t xBlockSad       ( const CuTreeFrame& cur, const CuTreeFrame& ref, int x, int y, int w, int h, const Mv& mv ) const;
+    const std::vector<double>& xPropagate( int numFrames );
+    void     xSetQpOffsets   ( Picture* pic, const std::vector<double>& propagateIn ) const;
+};
+
+} // namespace vvenc
+
+//! \}
+
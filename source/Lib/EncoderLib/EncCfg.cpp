@@ -81,6 +81,27 @@ static unsigned getMaxTlVal( unsigned perTlVal )
   return maxVal;
 }
 
+// takes over the parameters, which can be changed while encoding, see vvenc_reconfig()
+void VVEncCfg::reconfig( const vvenc_config& extern_cfg )
+{
+  if( m_RCTargetBitrate > 0 )
+  {
+    m_RCTargetBitrate   = extern_cfg.m_RCTargetBitrate;
+  }
+  else
+  {
+    // with rate control, the QP is the base QP derived by the rate control
+    m_QP                = extern_cfg.m_QP;
+  }
+  m_RCMaxBitrate        = extern_cfg.m_RCMaxBitrate;
+  m_maxMTTDepth         = extern_cfg.m_maxMTTDepth;
+  m_SearchRange         = extern_cfg.m_SearchRange;
+  m_fastInterSearchMode = extern_cfg.m_fastInterSearchMode;
+
+  m_rateCap             = m_RCMaxBitrate > 0 && m_RCMaxBitrate < INT32_MAX && m_RCTargetBitrate == 0;
+  m_splitCostThrParamId = getMaxTlVal( m_maxMTTDepth );
+}
+
 void VVEncCfg::xInitCfgMembers()
 {
   m_stageParallelProc   = m_numThreads > 0 && m_maxParallelFrames > 0;
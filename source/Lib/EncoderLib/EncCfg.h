@@ -76,6 +76,7 @@ struct VVEncCfg : public vvenc_config
   VVEncCfg();
 
   VVEncCfg& operator= ( const vvenc_config& extern_cfg );
+  void      reconfig  ( const vvenc_config& extern_cfg );
 
   bool      m_stageParallelProc;
   bool      m_salienceBasedOpt;
@@ -56,6 +56,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "BitAllocation.h"
 #include "EncHRD.h"
 #include "GOPCfg.h"
+#include "Utilities/NumaHelper.h"
 
 #include <list>
 
@@ -143,6 +144,11 @@ EncGOP::EncGOP( MsgLog& logger )
   , m_pocCRA             ( 0 )
   , m_associatedIRAPPOC  ( 0 )
   , m_associatedIRAPType ( VVENC_NAL_UNIT_CODED_SLICE_IDR_N_LP )
+  , m_numPicEncoders     ( 0 )
+  , m_numActivePicEncoders( 0 )
+  , m_reconfigPending    ( false )
+  , m_checkpointPoc      ( -1 )
+  , m_fgcLog2ScaleFactor ( 0 )
 {
 }
 
@@ -160,11 +166,6 @@ EncGOP::~EncGOP()
   m_freePicEncoderList.clear();
   m_threadPool = nullptr;
 
-  if ( m_pcEncCfg->m_fga )
-  {
-    m_fgAnalyzer.destroy();
-  }
-
   // cleanup parameter sets
   m_spsMap.clearMap();
   m_ppsMap.clearMap();
@@ -196,9 +197,7 @@ void EncGOP::init( const VVEncCfg& encCfg, const GOPCfg* gopCfg, RateCtrl& rateC
 
   if ( encCfg.m_fga )
   {
-    m_fgAnalyzer.init( m_pcEncCfg->m_PadSourceWidth, m_pcEncCfg->m_PadSourceHeight,
-                       m_pcEncCfg->m_internChromaFormat, m_pcEncCfg->m_outputBitDepth,
-                       m_pcEncCfg->m_fg.m_fgcSEICompModelPresent );
+    FGAnalyzer::initDefaultModel( m_fgcLog2ScaleFactor, m_fgcCompModel );
   }
 
   if( !m_pcEncCfg->m_poc0idr )
@@ -208,12 +207,24 @@ void EncGOP::init( const VVEncCfg& encCfg, const GOPCfg* gopCfg, RateCtrl& rateC
   m_seiEncoder.init( encCfg, gopCfg, m_EncHRD );
 
   const int maxPicEncoder = ( encCfg.m_maxParallelFrames ) ? encCfg.m_maxParallelFrames : 1;
+  const int numNumaNodes  = encCfg.m_numaAware ? NumaHelper::getNumNodes() : 1;
   for ( int i = 0; i < maxPicEncoder; i++ )
   {
+    // spread the picture encoders over the NUMA nodes, keeping the memory of each encoder on one node
+    if( numNumaNodes > 1 )
+    {
+      NumaHelper::setPreferredNode( i % numNumaNodes );
+    }
     EncPicture* picEncoder = new EncPicture;
     picEncoder->init( encCfg, &m_globalCtuQpVector, sps0, pps0, rateCtrl, threadPool );
     m_freePicEncoderList.push_back( picEncoder );
   }
+  if( numNumaNodes > 1 )
+  {
+    NumaHelper::setPreferredNode( -1 );
+  }
+  m_numPicEncoders       = maxPicEncoder;
+  m_numActivePicEncoders = maxPicEncoder;
 
   if (encCfg.m_usePerceptQPA)
   {
@@ -245,6 +256,10 @@ void EncGOP::initPicture( Picture* pic )
   pic->encTime.startTimer();
 
   pic->TLayer = pic->gopEntry->m_temporalId;
+  if( ! pic->m_picShared->m_checkpoint.empty() && ! m_isPreAnalysis )
+  {
+    m_checkpointCts.push_back( CheckpointCts{ pic->poc, m_lastCts, m_numPicsInMissing } );
+  }
   if( pic->ctsValid )
   {
     if( m_lastCts )
@@ -309,6 +324,13 @@ void EncGOP::initPicture( Picture* pic )
   pic->encTime.stopTimer();
 }
 
+void EncGOP::setNumActivePicEncoders( int numActive )
+{
+  std::unique_lock<std::mutex> lock( m_gopEncMutex );
+  m_numActivePicEncoders = std::max( 1, std::min( numActive, m_numPicEncoders ) );
+  m_gopEncCond.notify_all();
+}
+
 void EncGOP::waitForFreeEncoders()
 {
   {
@@ -393,9 +415,11 @@ void EncGOP::xProcessPictures( AccessUnitList& auList, PicList& doneList )
             ; } );
 
         const bool nextPicReady = picItr != m_procList.end();
+        // the number of pictures encoded in parallel may be limited below the number of pic encoders at runtime
+        const bool encoderReady = (int) m_freePicEncoderList.size() > m_numPicEncoders - m_numActivePicEncoders;
 
         // check at least one picture and one pic encoder ready
-        if( m_freePicEncoderList.empty() || ! nextPicReady )
+        if( ! encoderReady || ! nextPicReady )
         {
           // non-blocking stage: wait on top level, let other stages do their jobs
           // in non-lockstep mode, check if next picture can be output
@@ -583,6 +607,129 @@ void EncGOP::xSyncAlfAps( Picture& pic )
   dst.setApsIdStart( src.getApsIdStart() );
 }
 
+void EncGOP::reconfig( const vvenc_config& encCfg )
+{
+  CHECK( m_isPreAnalysis, "reconfiguration of the pre-analysis encoder not supported" );
+  m_reconfigCfg     = encCfg;
+  m_reconfigPending = true;
+}
+
+void EncGOP::xApplyReconfig()
+{
+  // the configuration is shared by all picture encoders, which are all idle here
+  VVEncCfg& encCfg = const_cast<VVEncCfg&>( *m_pcEncCfg );
+  encCfg.reconfig( m_reconfigCfg );
+
+  if( encCfg.m_RCTargetBitrate > 0 )
+  {
+    m_pcRateCtrl->updateTargetRate( encCfg.m_RCTargetBitrate, encCfg.m_RCMaxBitrate );
+  }
+
+  m_reconfigPending = false;
+}
+
+void EncGOP::restoreState( CheckpointStream& stream, int resumePoc )
+{
+  stream.read( m_bFirstWrite );
+  stream.read( m_bRefreshPending );
+  stream.read( m_lastCodingNum );
+  stream.read( m_numPicsCoded );
+  stream.read( m_lastCts );
+  stream.read( m_numPicsInMissing );
+  stream.read( m_numPicsOutOffset );
+  stream.read( m_pocRecOut );
+  stream.read( m_lastIDR );
+  stream.read( m_lastRasPoc );
+  stream.read( m_pocCRA );
+  stream.read( m_associatedIRAPPOC );
+  stream.read( m_associatedIRAPType );
+  stream.read( m_rcap );
+  stream.read( m_forceSCC );
+  stream.readBytes( &m_BlkStat, sizeof( m_BlkStat ) );
+  stream.readRange( m_globalCtuQpVector );
+
+  // APS of the last coded picture, the restart picture may propagate from it
+  if( stream.read<bool>() )
+  {
+    const int poc           = stream.read<int>();
+    const unsigned tid      = stream.read<unsigned>();
+    PicApsGlobal* apsGlobal = new PicApsGlobal( poc, tid );
+    apsGlobal->initalized   = true;
+    apsGlobal->apsMap.setApsIdStart( stream.read<int>() );
+    for( int i = 0; i < ALF_CTB_MAX_NUM_APS; i++ )
+    {
+      if( stream.read<bool>() )
+      {
+        const int apsMapIdx = ( i << NUM_APS_TYPE_LEN ) + ALF_APS;
+        stream.read( *apsGlobal->apsMap.allocatePS( apsMapIdx ) );
+        apsGlobal->apsMap.clearChangedFlag( apsMapIdx );
+      }
+    }
+    m_globalApsList.push_back( apsGlobal );
+  }
+
+  m_pcRateCtrl->restoreState( stream );
+  CHECK( ! stream.atEnd(), "checkpoint data corrupted" );
+
+  // pictures before the restart point are counted as coded
+  m_picCount      = m_numPicsCoded;
+  m_checkpointPoc = resumePoc;
+}
+
+void EncGOP::xStoreCheckpoint( const Picture& pic )
+{
+  auto ctsItr = std::find_if( m_checkpointCts.begin(), m_checkpointCts.end(), [&pic]( const CheckpointCts& c ) { return c.poc == pic.poc; } );
+  CHECK( ctsItr == m_checkpointCts.end(), "missing time stamp state of checkpoint picture" );
+
+  CheckpointStream stream;
+  stream.write( pic.poc );
+  stream.write( m_pcEncCfg->m_QP );
+  stream.writeStream( pic.m_picShared->m_checkpoint );
+
+  stream.write( m_bFirstWrite );
+  stream.write( m_bRefreshPending );
+  stream.write( m_lastCodingNum );
+  stream.write( m_numPicsCoded );
+  stream.write( ctsItr->lastCts );
+  stream.write( ctsItr->numPicsInMissing );
+  stream.write( m_numPicsOutOffset );
+  stream.write( m_pocRecOut );
+  stream.write( m_lastIDR );
+  stream.write( m_lastRasPoc );
+  stream.write( m_pocCRA );
+  stream.write( m_associatedIRAPPOC );
+  stream.write( m_associatedIRAPType );
+  stream.write( m_rcap );
+  stream.write( m_forceSCC );
+  stream.writeBytes( &m_BlkStat, sizeof( m_BlkStat ) );
+  stream.writeRange( m_globalCtuQpVector );
+
+  const PicApsGlobal* apsGlobal = m_globalApsList.empty() ? nullptr : m_globalApsList.back();
+  stream.write<bool>( apsGlobal != nullptr );
+  if( apsGlobal )
+  {
+    CHECK( ! apsGlobal->initalized, "APS of the last coded picture not initialized" );
+    stream.write( apsGlobal->poc );
+    stream.write( apsGlobal->tid );
+    stream.write<int>( apsGlobal->apsMap.getApsIdStart() );
+    for( int i = 0; i < ALF_CTB_MAX_NUM_APS; i++ )
+    {
+      const APS* aps = apsGlobal->apsMap.getPS( ( i << NUM_APS_TYPE_LEN ) + ALF_APS );
+      stream.write<bool>( aps != nullptr );
+      if( aps )
+      {
+        stream.write( *aps );
+      }
+    }
+  }
+
+  m_pcRateCtrl->storeState( stream );
+
+  m_checkpointData = stream.data();
+  m_checkpointPoc  = pic.poc;
+  m_checkpointCts.erase( m_checkpointCts.begin(), ctsItr + 1 );
+}
+
 void EncGOP::xEncodePicture( Picture* pic, EncPicture* picEncoder )
 {
   // first pass temporal down-sampling
@@ -626,22 +773,13 @@ void EncGOP::xEncodePicture( Picture* pic, EncPicture* picEncoder )
   // compress next picture
   picEncoder->compressPicture( *pic, *this );
 
-  if ( m_pcEncCfg->m_fga && !m_isPreAnalysis && m_pcRateCtrl->rcIsFinalPass )
+  // take over the film grain model estimated by the film grain analysis stage
+  if ( m_pcEncCfg->m_fga && !m_isPreAnalysis && m_pcRateCtrl->rcIsFinalPass && pic->m_picShared->m_fgcModel.isAnalysed )
   {
-    /* It is mctf denoising for film grain analysis. Note:
-     * when mctf is used, it is different from mctf for encoding. */
-    int curFrameNum = pic->getPOC();
-    int gopSize = m_pcEncCfg->m_GOPSize;
-    int prevAnalysedPoc = m_fgAnalyzer.prevAnalysisPoc;
-    if ( ( prevAnalysedPoc == -1 ) || ( abs( curFrameNum - prevAnalysedPoc ) >= gopSize ) )
-    {
-      bool isFiltered = pic->getFilteredOrigBuffer().valid();
-      if ( isFiltered )
-      {
-        m_fgAnalyzer.estimateGrainParameters( pic );
-        m_fgAnalyzer.prevAnalysisPoc = curFrameNum;
-      }
-    }
+    const PicFgcModel& fgcModel = pic->m_picShared->m_fgcModel;
+    fgcModel.done.wait();
+    m_fgcLog2ScaleFactor = fgcModel.log2ScaleFactor;
+    std::copy_n( fgcModel.compModel, (int)MAX_NUM_COMP, m_fgcCompModel );
   }
 
   // finish picture encoding and cleanup
@@ -1457,6 +1595,40 @@ void EncGOP::xInitPicsInCodingOrder( const PicList& picList )
       xUpdateVAStartOfLastGop( *pic );
     }
 
+    // apply a pending reconfiguration at the start of a GOP, as soon as all previous pictures are encoded
+    if( m_reconfigPending && pic->gopEntry->m_isStartOfGop )
+    {
+      bool encodersIdle = false;
+      {
+        std::unique_lock<std::mutex> lock( m_gopEncMutex, std::defer_lock );
+        if( m_pcEncCfg->m_numThreads > 0 ) lock.lock();
+        encodersIdle = m_gopEncListInput.empty() && m_procList.empty() && xEncodersFinished();
+      }
+      if( ! encodersIdle )
+      {
+        break;
+      }
+      xApplyReconfig();
+    }
+
+    // store the encoder state at a restart point, as soon as all previous pictures are written
+    if( ! pic->m_picShared->m_checkpoint.empty() && pic->poc != m_checkpointPoc && m_pcRateCtrl->rcIsFinalPass && ! m_isPreAnalysis
+        && pic->gopEntry->m_codingNum == m_lastCodingNum + 1 )
+    {
+      bool encoderIdle = false;
+      {
+        std::unique_lock<std::mutex> lock( m_gopEncMutex, std::defer_lock );
+        if( m_pcEncCfg->m_numThreads > 0 ) lock.lock();
+        encoderIdle = m_gopEncListInput.empty() && m_gopEncListOutput.empty() && m_procList.empty()
+                      && m_rcUpdateList.empty() && m_rcInputReorderList.empty() && xEncodersFinished();
+      }
+      if( ! encoderIdle )
+      {
+        break;
+      }
+      xStoreCheckpoint( *pic );
+    }
+
     // GOP QP adjustments
     if( (m_pcEncCfg->m_rateCap || m_pcEncCfg->m_GOPQPA || m_pcEncCfg->m_usePerceptQPA) && pic->gopEntry->m_isStartOfGop )
     {
@@ -1963,9 +2135,10 @@ void EncGOP::xInitFirstSlice( Picture& pic, const PicList& picList, bool isEncod
     slice->picHeader->maxMTTDepth[i] = sps.maxMTTDepth[i];
     slice->picHeader->maxBTSize[i]   = sps.maxBTSize[i];
     slice->picHeader->maxTTSize[i]   = sps.maxTTSize[i];
-    if( ( i == 1 ) && ( m_pcEncCfg->m_maxMTTDepth >= 10 ) )
+    if( i == 1 )
     {
-      slice->picHeader->maxMTTDepth[i]    = int( m_pcEncCfg->m_maxMTTDepth / pow( 10, sps.maxTLayers - slice->TLayer - 1 ) ) % 10;
+      // per temporal layer depths and depths changed by a reconfiguration are signalled in the picture header
+      slice->picHeader->maxMTTDepth[i]    = m_pcEncCfg->m_maxMTTDepth >= 10 ? int( m_pcEncCfg->m_maxMTTDepth / pow( 10, sps.maxTLayers - slice->TLayer - 1 ) ) % 10 : m_pcEncCfg->m_maxMTTDepth;
       slice->picHeader->splitConsOverride = slice->picHeader->maxMTTDepth[i] != sps.maxMTTDepth[i];
     }
   }
@@ -2319,6 +2492,10 @@ void EncGOP::xWritePicture( Picture& pic, AccessUnitList& au, bool isEncodeLtRef
   au.temporalLayer = pic.TLayer;
   au.refPic        = pic.isReferenced;
   au.userData      = pic.userData;
+  if( pic.poc == m_checkpointPoc && ! m_checkpointData.empty() )
+  {
+    au.checkpointData.swap( m_checkpointData );
+  }
   if( ! pic.slices.empty() )
   {
     au.sliceType = pic.slices[ 0 ]->sliceType;
@@ -2426,7 +2603,7 @@ int EncGOP::xWritePictureSlices( Picture& pic, AccessUnitList& accessUnit, HLSWr
     xAttachSliceDataToNalUnit( nalu, &pic.sliceDataStreams[ sliceIdx ] );
 
     accessUnit.push_back( new NALUnitEBSP( nalu ) );
-    numBytes += unsigned( accessUnit.back()->m_nalUnitData.str().size() );
+    numBytes += unsigned( accessUnit.back()->m_nalUnitData.size() );
   }
 
   xCabacZeroWordPadding( pic, slice, pic.sliceDataNumBins, numBytes, accessUnit.back()->m_nalUnitData );
@@ -2481,12 +2658,12 @@ void EncGOP::xWriteLeadingSEIs( const Picture& pic, AccessUnitList& accessUnit )
   {
     SeiFgc* sei = new SeiFgc;
     m_seiEncoder.initSeiFgc( sei );
-    sei->log2ScaleFactor = m_fgAnalyzer.getLog2scaleFactor();
+    sei->log2ScaleFactor = m_fgcLog2ScaleFactor;
     for ( int compIdx = 0; compIdx < getNumberValidComponents(pic.chromaFormat); compIdx++ )
     {
       if ( sei->compModel[compIdx].presentFlag )
       {  // higher importance of presentFlag is from cfg file
-        sei->compModel[compIdx] = m_fgAnalyzer.getCompModel( compIdx );
+        sei->compModel[compIdx] = m_fgcCompModel[compIdx];
       }
     }
     leadingSeiMessages.push_back( sei );
@@ -2550,7 +2727,7 @@ int EncGOP::xWriteVPS ( AccessUnitList &accessUnit, const VPS *vps, HLSWriter& h
   hlsWriter.setBitstream( &nalu.m_Bitstream );
   hlsWriter.codeVPS( vps );
   accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  return (int)(accessUnit.back()->m_nalUnitData.size()) * 8;
 }
 
 int EncGOP::xWriteDCI ( AccessUnitList &accessUnit, const DCI *dci, HLSWriter& hlsWriter )
@@ -2564,7 +2741,7 @@ int EncGOP::xWriteDCI ( AccessUnitList &accessUnit, const DCI *dci, HLSWriter& h
   hlsWriter.setBitstream( &nalu.m_Bitstream );
   hlsWriter.codeDCI( dci );
   accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  return (int)(accessUnit.back()->m_nalUnitData.size()) * 8;
 }
 
 int EncGOP::xWriteSPS ( AccessUnitList &accessUnit, const SPS *sps, HLSWriter& hlsWriter )
@@ -2573,7 +2750,7 @@ int EncGOP::xWriteSPS ( AccessUnitList &accessUnit, const SPS *sps, HLSWriter& h
   hlsWriter.setBitstream( &nalu.m_Bitstream );
   hlsWriter.codeSPS( sps );
   accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  return (int)(accessUnit.back()->m_nalUnitData.size()) * 8;
 }
 
 int EncGOP::xWritePPS ( AccessUnitList &accessUnit, const PPS *pps, const SPS *sps, HLSWriter& hlsWriter )
@@ -2582,7 +2759,7 @@ int EncGOP::xWritePPS ( AccessUnitList &accessUnit, const PPS *pps, const SPS *s
   hlsWriter.setBitstream( &nalu.m_Bitstream );
   hlsWriter.codePPS( pps, sps );
   accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  return (int)(accessUnit.back()->m_nalUnitData.size()) * 8;
 }
 
 int EncGOP::xWriteAPS( AccessUnitList &accessUnit, const APS *aps, HLSWriter& hlsWriter, vvencNalUnitType eNalUnitType )
@@ -2591,7 +2768,7 @@ int EncGOP::xWriteAPS( AccessUnitList &accessUnit, const APS *aps, HLSWriter& hl
   hlsWriter.setBitstream(&nalu.m_Bitstream);
   hlsWriter.codeAPS(aps);
   accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  return (int)(accessUnit.back()->m_nalUnitData.size()) * 8;
 }
 
 void EncGOP::xWriteAccessUnitDelimiter ( AccessUnitList &accessUnit, Slice* slice, bool IrapOrGdr, HLSWriter& hlsWriter )
@@ -2648,7 +2825,7 @@ void EncGOP::xAttachSliceDataToNalUnit( OutputNALUnit& rNalu, const OutputBitstr
   }
 }
 
-void EncGOP::xCabacZeroWordPadding( const Picture& pic, const Slice* slice, uint32_t binCountsInNalUnits, uint32_t numBytesInVclNalUnits, std::ostringstream &nalUnitData )
+void EncGOP::xCabacZeroWordPadding( const Picture& pic, const Slice* slice, uint32_t binCountsInNalUnits, uint32_t numBytesInVclNalUnits, std::vector<uint8_t>& nalUnitData )
 {
   const PPS &pps                     = *(slice->pps);
   const SPS &sps                     = *(slice->sps);
@@ -2671,12 +2848,12 @@ void EncGOP::xCabacZeroWordPadding( const Picture& pic, const Slice* slice, uint
       const uint32_t numberOfAdditionalCabacZeroBytes = numberOfAdditionalCabacZeroWords * 3;
       if ( m_pcEncCfg->m_cabacZeroWordPaddingEnabled )
       {
-        std::vector<uint8_t> zeroBytesPadding(numberOfAdditionalCabacZeroBytes, uint8_t(0));
+        const size_t startPos = nalUnitData.size();
+        nalUnitData.resize( startPos + numberOfAdditionalCabacZeroBytes, uint8_t( 0 ) );
         for( uint32_t i = 0; i < numberOfAdditionalCabacZeroWords; i++ )
         {
-          zeroBytesPadding[ i * 3 + 2 ] = 3;  // 00 00 03
+          nalUnitData[ startPos + i * 3 + 2 ] = 3;  // 00 00 03
         }
-        nalUnitData.write( reinterpret_cast<const char*>(&(zeroBytesPadding[ 0 ])), numberOfAdditionalCabacZeroBytes );
         msg.log( VVENC_NOTICE, "Adding %d bytes of padding\n", numberOfAdditionalCabacZeroWords * 3 );
       }
       else
@@ -2706,7 +2883,7 @@ void EncGOP::xAddPSNRStats( const Picture* pic, CPelUnitBuf cPicD, AccessUnitLis
   uint32_t numRBSPBytes = 0;
   for (AccessUnitList::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
   {
-    uint32_t numRBSPBytes_nal = uint32_t((*it)->m_nalUnitData.str().size());
+    uint32_t numRBSPBytes_nal = uint32_t((*it)->m_nalUnitData.size());
     if (m_pcEncCfg->m_summaryVerboseness > 0)
     {
       msg.log( VVENC_NOTICE, "*** %s numBytesInNALunit: %u\n", nalUnitTypeToString((*it)->m_nalUnitType), numRBSPBytes_nal);
@@ -2770,6 +2947,12 @@ void EncGOP::xAddPSNRStats( const Picture* pic, CPelUnitBuf cPicD, AccessUnitLis
     );
     *PSNR_Y = dPSNR[COMP_Y];
   }
+  if( m_pcEncCfg->m_qualityMetrics && ! isEncodeLtRef )
+  {
+    m_AnalyzeAll.addQualityResult( pic->ssim, pic->msSsim, pic->vif, pic->detail );
+    Analyze& analyzeSliceType = slice->isIntra() ? m_AnalyzeI : slice->isInterP() ? m_AnalyzeP : m_AnalyzeB;
+    analyzeSliceType.addQualityResult( pic->ssim, pic->msSsim, pic->vif, pic->detail );
+  }
 
   char c = (slice->isIntra() ? 'I' : slice->isInterP() ? 'P' : 'B');
   if ( ! pic->isReferenced && pic->refCounter == 0 && ! m_pcEncCfg->m_maxParallelFrames )
@@ -2846,6 +3029,22 @@ void EncGOP::xAddPSNRStats( const Picture* pic, CPelUnitBuf cPicD, AccessUnitLis
         accessUnit.InfoString.append( cFrameMSE );
       }
 
+      if( m_pcEncCfg->m_qualityMetrics )
+      {
+        std::string cQuality = prnt( " [SSIM %6.4lf  MS-SSIM %6.4lf  VIF %6.4lf  DLM %6.4lf]", pic->ssim, pic->msSsim, pic->vif, pic->detail );
+        accessUnit.InfoString.append( cQuality );
+      }
+
+      accessUnit.qualityValid = true;
+      for( int i = 0; i < MAX_NUM_COMP; i++ )
+      {
+        accessUnit.psnr[ i ] = dPSNR[ i ];
+      }
+      accessUnit.ssim   = pic->ssim;
+      accessUnit.msSsim = pic->msSsim;
+      accessUnit.vif    = pic->vif;
+      accessUnit.detail = pic->detail;
+
       std::string cEncTime = prnt(" [ET %5d ]", pic->encTime.getTimerInSec() );
       accessUnit.InfoString.append( cEncTime );
 
@@ -2866,47 +3065,6 @@ void EncGOP::xAddPSNRStats( const Picture* pic, CPelUnitBuf cPicD, AccessUnitLis
   }
 }
 
-uint64_t EncGOP::xFindDistortionPlane( const CPelBuf& pic0, const CPelBuf& pic1, uint32_t rshift ) const
-{
-  uint64_t uiTotalDiff;
-  const  Pel*  pSrc0 = pic0.bufAt(0, 0);
-  const  Pel*  pSrc1 = pic1.bufAt(0, 0);
-
-  CHECK(pic0.width  != pic1.width , "Unspecified error");
-  CHECK(pic0.height != pic1.height, "Unspecified error");
-
-  if( rshift > 0 )
-  {
-    uiTotalDiff = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        uiTotalDiff += uint64_t((iTemp * iTemp) >> rshift);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
-  }
-  else
-  {
-    uiTotalDiff = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        uiTotalDiff += uint64_t(iTemp * iTemp);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
-  }
-
-  return uiTotalDiff;
-}
-
 void EncGOP::xPrintPictureInfo( const Picture& pic, AccessUnitList& accessUnit, const std::string& digestStr, bool printFrameMSE, bool isEncodeLtRef )
 {
   double PSNR_Y;
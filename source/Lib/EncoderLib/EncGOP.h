@@ -111,6 +111,14 @@ struct RateCapParam {
 class EncGOP : public EncStage
 {
 private:
+  // time stamp state before the initialization of a checkpoint picture
+  struct CheckpointCts
+  {
+    int      poc;
+    uint64_t lastCts;
+    int      numPicsInMissing;
+  };
+
   MsgLog&                   msg;
 
   Analyze                   m_AnalyzeAll;
@@ -159,6 +167,8 @@ private:
   RateCapParam              m_rcap;
 
   std::list<EncPicture*>    m_freePicEncoderList;
+  int                       m_numPicEncoders;
+  std::atomic_int           m_numActivePicEncoders;
   std::list<Picture*>       m_gopEncListInput;
   std::list<Picture*>       m_gopEncListOutput;
   std::list<Picture*>       m_procList;
@@ -167,8 +177,14 @@ private:
   std::deque<PicApsGlobal*> m_globalApsList;
   std::vector<int>          m_globalCtuQpVector;
   bool                      m_forceSCC;
+  vvenc_config              m_reconfigCfg;         // parameters changed by vvenc_reconfig(), applied at the next GOP start
+  bool                      m_reconfigPending;
+  int                       m_checkpointPoc;
+  std::vector<uint8_t>      m_checkpointData;
+  std::deque<CheckpointCts> m_checkpointCts;
 
-  FGAnalyzer                m_fgAnalyzer;
+  int                       m_fgcLog2ScaleFactor;  // film grain model of the latest analysed picture in coding order
+  SeiFgc::CompModel         m_fgcCompModel[ MAX_NUM_COMP ];
 
 public:
   EncGOP( MsgLog& msglog );
@@ -179,6 +195,9 @@ public:
   void init               ( const VVEncCfg& encCfg, const GOPCfg* gopCfg, RateCtrl& rateCtrl, NoMallocThreadPool* threadPool, bool isPreAnalysis );
   void printOutSummary    ( const bool printMSEBasedSNR, const bool printSequenceMSE, const bool printHexPsnr );
   void getParameterSets   ( AccessUnitList& accessUnit );
+  void reconfig           ( const vvenc_config& encCfg );
+  void restoreState       ( CheckpointStream& stream, int resumePoc );
+  void setNumActivePicEncoders( int numActive );
 
 protected:
   virtual void initPicture    ( Picture* pic );
@@ -191,6 +210,8 @@ private:
   void xEncodePicture                 ( Picture* pic, EncPicture* picEncoder );
   void xOutputRecYuv                  ( const PicList& picList );
   void xReleasePictures               ( const PicList& picList, PicList& freeList );
+  void xApplyReconfig                 ();
+  void xStoreCheckpoint               ( const Picture& pic );
 
   void xInitVPS                       ( VPS &vps ) const;
   void xInitDCI                       ( DCI &dci, const SPS &sps, const int dciId ) const;
@@ -231,12 +252,11 @@ private:
   void xWriteSEI                      ( vvencNalUnitType naluType, SEIMessages& seiMessages, AccessUnitList &accessUnit, AccessUnitList::iterator &auPos, int temporalId, const SPS *sps );
   void xWriteSEISeparately            ( vvencNalUnitType naluType, SEIMessages& seiMessages, AccessUnitList &accessUnit, AccessUnitList::iterator &auPos, int temporalId, const SPS *sps );
   void xAttachSliceDataToNalUnit      ( OutputNALUnit& rNalu, const OutputBitstream* pcBitstreamRedirect );
-  void xCabacZeroWordPadding          ( const Picture& pic, const Slice* slice, uint32_t binCountsInNalUnits, uint32_t numBytesInVclNalUnits, std::ostringstream &nalUnitData );
+  void xCabacZeroWordPadding          ( const Picture& pic, const Slice* slice, uint32_t binCountsInNalUnits, uint32_t numBytesInVclNalUnits, std::vector<uint8_t>& nalUnitData );
 
   void xUpdateRateCap();
   void xUpdateRateCapBits             ( const Picture* pic, const uint32_t uibits );
   void xAddPSNRStats( const Picture* pic, CPelUnitBuf cPicD, AccessUnitList&, bool printFrameMSE, double* PSNR_Y, bool isEncodeLtRef );
-  uint64_t xFindDistortionPlane       ( const CPelBuf& pic0, const CPelBuf& pic1, uint32_t rshift ) const;
   void xPrintPictureInfo              ( const Picture& pic, AccessUnitList& accessUnit, const std::string& digestStr, bool printFrameMSE, bool isEncodeLtRef );
   inline bool xEncodersFinished       () { return ( int ) m_freePicEncoderList.size() >= std::max(1, m_pcEncCfg->m_maxParallelFrames); }
   inline bool xLockStepPicsFinished   ()
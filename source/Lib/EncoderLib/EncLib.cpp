@@ -55,9 +55,14 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "Utilities/MsgLog.h"
 #include "EncStage.h"
 #include "PreProcess.h"
+#include "FGAStage.h"
+#include "CuTree.h"
+#include "Renditions.h"
 #include "EncGOP.h"
 #include "CommonLib/x86/CommonDefX86.h"
 
+#include <chrono>
+
 //! \ingroup EncoderLib
 //! \{
 
@@ -72,19 +77,29 @@ EncLib::EncLib( MsgLog& logger )
   : msg             ( logger )
   , m_recYuvBufFunc  ( nullptr )
   , m_recYuvBufCtx   ( nullptr )
+  , m_yuvReleaseFunc ( nullptr )
+  , m_yuvReleaseCtx  ( nullptr )
   , m_encCfg         ()
   , m_orgCfg         ()
   , m_firstPassCfg   ()
   , m_rateCtrl       ( nullptr )
   , m_preProcess     ( nullptr )
   , m_MCTF           ( nullptr )
+  , m_fgaStage       ( nullptr )
+  , m_cuTree         ( nullptr )
   , m_preEncoder     ( nullptr )
   , m_gopEncoder     ( nullptr )
+  , m_renditions     ( nullptr )
   , m_threadPool     ( nullptr )
   , m_picsRcvd       ( 0 )
   , m_passInitialized( -1 )
   , m_maxNumPicShared( MAX_INT )
   , m_accessUnitOutputStarted( false )
+  , m_cfgSignature   ( 0 )
+  , m_resumePass     ( -1 )
+  , m_resumePoc      ( -1 )
+  , m_resumeQP       ( 0 )
+  , m_resumeBitstreamSize( 0 )
 {
 }
 
@@ -104,10 +119,21 @@ void EncLib::setRecYUVBufferCallback( void* ctx, vvencRecYUVBufferCallback func
   }
 }
 
-void EncLib::initEncoderLib( const vvenc_config& encCfg )
+void EncLib::setYUVBufferReleaseCallback( void* ctx, vvencYUVBufferReleaseCallback func )
+{
+  m_yuvReleaseCtx  = ctx;
+  m_yuvReleaseFunc = func;
+}
+
+void EncLib::initEncoderLib( const vvenc_config& encCfg, const std::vector<vvenc_config>& renditionCfgs )
 {
   // copy config parameter
   const_cast<VVEncCfg&>(m_encCfg) = encCfg;
+  m_renditionCfgs.resize( renditionCfgs.size() );
+  for( int i = 0; i < (int)renditionCfgs.size(); i++ )
+  {
+    m_renditionCfgs[ i ] = renditionCfgs[ i ];
+  }
 
 #if defined( REAL_TARGET_X86 ) && defined( _MSC_VER ) && _MSC_VER >= 1938 && _MSC_VER < 1939
   if( read_x86_extension_flags() >= x86_simd::AVX2 )
@@ -122,6 +148,14 @@ void EncLib::initEncoderLib( const vvenc_config& encCfg )
     xInitRCCfg();
   }
 
+  m_threadBudgetCtrl.init( m_encCfg );
+
+  // load the encoder state of an interrupted encoding
+  if( m_encCfg.m_checkpointFile[ 0 ] != '\0' )
+  {
+    xInitCheckpoint();
+  }
+
   // initialize pass
   initPass( 0, nullptr );
 
@@ -189,6 +223,8 @@ void EncLib::uninitEncoderLib()
 
 void EncLib::initPass( int pass, const char* statsFName )
 {
+  const bool isResume = m_resumePoc >= 0 && pass == m_resumePass;
+
   CHECK( m_passInitialized != pass && m_passInitialized + 1 != pass, "initialization of passes only in successive order possible" );
 
   if( m_rateCtrl == nullptr )
@@ -219,9 +255,10 @@ void EncLib::initPass( int pass, const char* statsFName )
       // restore encoder config for final 2nd RC pass
       const_cast<VVEncCfg&>(m_encCfg) = m_orgCfg;
       m_rateCtrl->init( m_encCfg );
-      const_cast<VVEncCfg&>(m_encCfg).m_QP = m_rateCtrl->getBaseQP();
+      // when resuming, the first pass data has already been processed and is restored from the checkpoint
+      const_cast<VVEncCfg&>(m_encCfg).m_QP = isResume ? m_resumeQP : m_rateCtrl->getBaseQP();
     }
-    if( m_encCfg.m_RCTargetBitrate > 0 && !m_encCfg.m_LookAhead )
+    if( m_encCfg.m_RCTargetBitrate > 0 && !m_encCfg.m_LookAhead && ! isResume )
     {
       m_rateCtrl->processFirstPassData( false );
     }
@@ -238,9 +275,13 @@ void EncLib::initPass( int pass, const char* statsFName )
   }
   m_maxNumPicShared = 0;
 
+  // when resuming, the pictures preceding the restart point are fed again to the pre-processing stages
+  const int startPoc   = isResume ? m_resumePoc : 0;
+  const int numPreroll = isResume ? PreProcess::getNumPreroll( m_encCfg, m_resumePoc ) : m_encCfg.m_leadFrames;
+
   // pre processing
   m_preProcess = new PreProcess( msg );
-  m_preProcess->initStage( m_encCfg, 1, -m_encCfg.m_leadFrames, true, true, false );
+  m_preProcess->initStage( m_encCfg, 1, startPoc - numPreroll, true, true, false );
   m_preProcess->init( m_encCfg, m_rateCtrl->rcIsFinalPass );
   m_encStages.push_back( m_preProcess );
   m_maxNumPicShared += 1;
@@ -249,14 +290,45 @@ void EncLib::initPass( int pass, const char* statsFName )
   if( m_encCfg.m_vvencMCTF.MCTF || m_encCfg.m_usePerceptQPA )
   {
     m_MCTF = new MCTF();
-    const int leadFrames   = std::min( VVENC_MCTF_RANGE, m_encCfg.m_leadFrames );
+    const int leadFrames   = std::min( VVENC_MCTF_RANGE, numPreroll );
     const int minQueueSize = m_encCfg.m_vvencMCTF.MCTFFutureReference ? ( leadFrames + 1 + VVENC_MCTF_RANGE ) : ( leadFrames + 1 );
-    m_MCTF->initStage( m_encCfg, minQueueSize, -leadFrames, true, true, false );
-    m_MCTF->init( m_encCfg, m_rateCtrl->rcIsFinalPass, m_threadPool );
+    m_MCTF->initStage( m_encCfg, minQueueSize, startPoc - leadFrames, true, true, false );
+    m_MCTF->init( m_encCfg, m_rateCtrl->rcIsFinalPass, m_threadPool, startPoc );
     m_encStages.push_back( m_MCTF );
     m_maxNumPicShared += minQueueSize - leadFrames;
   }
 
+  // film grain analysis of the filtered pictures, running asynchronously on the thread pool
+  if( m_encCfg.m_fga )
+  {
+    m_fgaStage = new FGAStage();
+    m_fgaStage->initStage( m_encCfg, 1, 0, false, true, false );
+    m_fgaStage->init( m_encCfg, m_rateCtrl->rcIsFinalPass, m_threadPool );
+    m_encStages.push_back( m_fgaStage );
+    m_maxNumPicShared += 1;
+  }
+
+  // CU-tree QP propagation
+  if( m_encCfg.m_cuTree )
+  {
+    m_cuTree = new CuTree();
+    const int minQueueSize = m_encCfg.m_cuTree + 1;
+    m_cuTree->initStage( m_encCfg, minQueueSize, 0, false, true, false );
+    m_cuTree->init( m_encCfg );
+    m_encStages.push_back( m_cuTree );
+    m_maxNumPicShared += minQueueSize;
+  }
+
+  // downscaled renditions, fed with the results of the shared pre-analysis
+  if( ! m_renditionCfgs.empty() )
+  {
+    m_renditions = new Renditions();
+    m_renditions->initStage( m_encCfg, 1, 0, false, true, false );
+    m_renditions->init( m_encCfg );
+    m_encStages.push_back( m_renditions );
+    m_maxNumPicShared += 1;
+  }
+
   // pre analysis encoder
   if( m_encCfg.m_LookAhead )
   {
@@ -271,11 +343,24 @@ void EncLib::initPass( int pass, const char* statsFName )
   // gop encoder
   m_gopEncoder = new EncGOP( msg );
   const int minQueueSize = m_encCfg.m_GOPSize + 1;
-  m_gopEncoder->initStage( m_encCfg, minQueueSize, 0, false, false, m_encCfg.m_stageParallelProc );
+  m_gopEncoder->initStage( m_encCfg, minQueueSize, startPoc, false, false, m_encCfg.m_stageParallelProc );
   m_gopEncoder->init( m_encCfg, m_preProcess->getGOPCfg(), *m_rateCtrl, m_threadPool, false );
   m_encStages.push_back( m_gopEncoder );
   m_maxNumPicShared += minQueueSize;
 
+  // one encoder per rendition, running on the same thread pool, not linked into the stage chain
+  for( auto& renditionCfg : m_renditionCfgs )
+  {
+    RateCtrl* rateCtrl = new RateCtrl( msg );
+    rateCtrl->setRCPass( renditionCfg, 0, nullptr );
+    EncGOP* encoder = new EncGOP( msg );
+    encoder->initStage( renditionCfg, renditionCfg.m_GOPSize + 1, 0, false, false, renditionCfg.m_stageParallelProc );
+    encoder->init( renditionCfg, m_preProcess->getGOPCfg(), *rateCtrl, m_threadPool, false );
+    m_renditions->addRendition( renditionCfg, encoder );
+    m_renditionRateCtrls.push_back( rateCtrl );
+    m_renditionEncoders.push_back( encoder );
+  }
+
   // additional pictures due to structural delay
   m_maxNumPicShared += m_preProcess->getGOPCfg()->getNumReorderPics()[ m_encCfg.m_maxTLayer ];
   m_maxNumPicShared += 3;
@@ -293,11 +378,65 @@ void EncLib::initPass( int pass, const char* statsFName )
     m_encStages[ i ]->linkNextStage( m_encStages[ i + 1 ] );
   }
 
-  m_picsRcvd                = -m_encCfg.m_leadFrames;
+  // restore the state of the interrupted encoding
+  if( isResume )
+  {
+    CheckpointStream preProcessState;
+    m_resumeState.readStream( preProcessState );
+    m_preProcess->restoreState( preProcessState, m_resumePoc );
+    m_gopEncoder->restoreState( m_resumeState, m_resumePoc );
+    m_resumeState.clear();
+  }
+
+  if( m_threadPool )
+  {
+    xApplyThreadBudget();
+  }
+
+  m_picsRcvd                = startPoc - numPreroll;
   m_accessUnitOutputStarted = false;
   m_passInitialized         = pass;
 }
 
+void EncLib::xInitCheckpoint()
+{
+  // the checkpoint file itself is not part of the configuration signature
+  vvenc_config cfg = m_encCfg;
+  memset( cfg.m_checkpointFile, '\0', sizeof( cfg.m_checkpointFile ) );
+  cfg.m_checkpointResume = false;
+  m_cfgSignature = getCheckpointSignature( vvenc_get_config_as_string( &cfg, VVENC_DETAILS ) );
+
+  if( ! m_encCfg.m_checkpointResume )
+  {
+    return;
+  }
+
+  readCheckpointFile( m_encCfg.m_checkpointFile, m_cfgSignature, m_resumeBitstreamSize, m_resumeState );
+  m_resumeState.read( m_resumePoc );
+  m_resumeState.read( m_resumeQP );
+  CHECK( m_resumePoc <= 0, "invalid restart picture in checkpoint file" );
+
+  m_resumePass      = m_encCfg.m_RCNumPasses > 1 ? 1 : 0;
+  m_passInitialized = m_resumePass - 1;
+  msg.log( VVENC_INFO, "resume encoding at frame %d from checkpoint file %s\n", m_resumePoc, m_encCfg.m_checkpointFile );
+}
+
+void EncLib::writeCheckpoint( const std::vector<uint8_t>& data, int64_t bitstreamSize )
+{
+  CheckpointStream stream;
+  stream.assign( data );
+  writeCheckpointFile( m_encCfg.m_checkpointFile, m_cfgSignature, bitstreamSize, stream );
+}
+
+void EncLib::getCheckpointInfo( int& pass, int& firstFrame, int& firstInputFrame, int64_t& bitstreamSize ) const
+{
+  const bool isResume = m_resumePoc >= 0;
+  pass            = isResume ? m_resumePass : 0;
+  firstFrame      = isResume ? m_resumePoc : 0;
+  firstInputFrame = isResume ? m_resumePoc - PreProcess::getNumPreroll( m_encCfg, m_resumePoc ) : 0;
+  bitstreamSize   = isResume ? m_resumeBitstreamSize : 0;
+}
+
 void EncLib::xUninitLib()
 {
   // make sure all processing threads are stopped before releasing data
@@ -321,6 +460,16 @@ void EncLib::xUninitLib()
     delete m_MCTF;
     m_MCTF = nullptr;
   }
+  if( m_fgaStage )
+  {
+    delete m_fgaStage;
+    m_fgaStage = nullptr;
+  }
+  if( m_cuTree )
+  {
+    delete m_cuTree;
+    m_cuTree = nullptr;
+  }
   if( m_preEncoder )
   {
     delete m_preEncoder;
@@ -331,8 +480,27 @@ void EncLib::xUninitLib()
     delete m_gopEncoder;
     m_gopEncoder = nullptr;
   }
+  for( auto encoder : m_renditionEncoders )
+  {
+    delete encoder;
+  }
+  m_renditionEncoders.clear();
+  for( auto rateCtrl : m_renditionRateCtrls )
+  {
+    rateCtrl->destroy();
+    delete rateCtrl;
+  }
+  m_renditionRateCtrls.clear();
+  if( m_renditions )
+  {
+    delete m_renditions;
+    m_renditions = nullptr;
+  }
   m_encStages.clear();
 
+  // return all lent input buffers, the encoder stages do not reference them anymore
+  xReleaseLentBuffers( true );
+
   for( auto picShared : m_picSharedList )
   {
     delete picShared;
@@ -416,6 +584,8 @@ void EncLib::encodePicture( bool flush, const vvencYUVBuffer* yuvInBuf, AccessUn
 {
   PROFILER_ACCUM_AND_START_NEW_SET( 1, g_timeProfiler, P_TOP_LEVEL );
 
+  const auto encStartTime = std::chrono::steady_clock::now();
+
   CHECK( yuvInBuf == nullptr && ! flush, "no input picture given" );
 
   // clear output access unit
@@ -440,7 +610,14 @@ void EncLib::encodePicture( bool flush, const vvencYUVBuffer* yuvInBuf, AccessUn
       picShared = xGetFreePicShared();
       if( picShared )
       {
-        picShared->reuse( m_picsRcvd, yuvInBuf );
+        const bool lendBuffer = m_yuvReleaseFunc && picShared->isLendable( yuvInBuf );
+        picShared->reuse( m_picsRcvd, yuvInBuf, lendBuffer );
+        if( m_yuvReleaseFunc && ! lendBuffer )
+        {
+          // input has been copied, so the caller gets the buffer back immediately
+          vvencYUVBuffer yuvBuf = *yuvInBuf;
+          m_yuvReleaseFunc( m_yuvReleaseCtx, &yuvBuf );
+        }
         m_encStages[ 0 ]->addPicSorted( picShared, flush );
         m_picsRcvd  += 1;
         inputPending = false;
@@ -457,15 +634,33 @@ void EncLib::encodePicture( bool flush, const vvencYUVBuffer* yuvInBuf, AccessUn
       isQueueEmpty &= encStage->isStageDone();
     }
 
+    xReleaseLentBuffers( false );
+
     if( !au.empty() )
     {
       m_AuList.push_back( au );
 
       au.detachNalUnitList();
       au.clearAu();
-      // NOTE: delay AU output in stage parallel mode only
+      // NOTE: delay AU output in stage parallel mode only, unless low latency output is requested
       if( !m_accessUnitOutputStarted )
-        m_accessUnitOutputStarted = !m_encCfg.m_stageParallelProc || m_AuList.size() > 4 || flush;
+        m_accessUnitOutputStarted = !m_encCfg.m_stageParallelProc || m_encCfg.m_lowLatencyOutput || m_AuList.size() > 4 || flush;
+    }
+
+    // the renditions are encoded into separate access units
+    for( int i = 0; i < (int)m_renditionEncoders.size(); i++ )
+    {
+      AccessUnitList renditionAu;
+      m_renditionEncoders[ i ]->runStage( flush, renditionAu );
+      isQueueEmpty &= m_renditionEncoders[ i ]->isStageDone();
+      if( !renditionAu.empty() )
+      {
+        renditionAu.rendition = i + 1;
+        m_AuList.push_back( renditionAu );
+        renditionAu.detachNalUnitList();
+        if( !m_accessUnitOutputStarted )
+          m_accessUnitOutputStarted = !m_encCfg.m_stageParallelProc || m_encCfg.m_lowLatencyOutput || m_AuList.size() > 4 || flush;
+      }
     }
 
     // wait if input picture hasn't been stored yet or if encoding is running and no new output access unit has been encoded
@@ -483,6 +678,11 @@ void EncLib::encodePicture( bool flush, const vvencYUVBuffer* yuvInBuf, AccessUn
           encStage->waitForFreeEncoders();
       }
     }
+    for( EncStage* encStage : m_renditionEncoders )
+    {
+      if( encStage->isNonBlocking() )
+        encStage->waitForFreeEncoders();
+    }
   }
 
   // check if we have an AU to output
@@ -501,6 +701,55 @@ void EncLib::encodePicture( bool flush, const vvencYUVBuffer* yuvInBuf, AccessUn
 
   // finally, ensure that the whole queue is empty
   isQueueEmpty &= m_AuList.empty();
+
+  if( m_threadPool )
+  {
+    // the encoding time is measured once the access unit output has started, i.e. the picture pipeline is filled
+    const bool   measure   = m_accessUnitOutputStarted && m_rateCtrl->rcIsFinalPass;
+    const double encTime   = measure ? std::chrono::duration<double>( std::chrono::steady_clock::now() - encStartTime ).count() : 0.0;
+    const int    numFrames = measure && ! au.empty() && au.rendition == 0 ? 1 : 0;
+    if( m_threadBudgetCtrl.update( encTime, numFrames ) )
+    {
+      msg.log( VVENC_DETAILS, "thread budget: %d active threads\n", m_threadBudgetCtrl.getNumActive() );
+      xApplyThreadBudget();
+    }
+  }
+}
+
+void EncLib::setCpuBudget( int numThreads )
+{
+  // applied by the encoding thread with the next picture
+  m_threadBudgetCtrl.setBudget( numThreads );
+}
+
+void EncLib::xApplyThreadBudget()
+{
+  const int numActive = m_threadBudgetCtrl.getNumActive();
+  m_threadPool->setNumActiveThreads( numActive );
+
+  // the number of pictures encoded in parallel follows the share of active threads
+  auto setPicEncoders = [&]( EncGOP* encoder, const VVEncCfg& encCfg )
+  {
+    if( encoder && encCfg.m_maxParallelFrames > 0 )
+    {
+      encoder->setNumActivePicEncoders( ( encCfg.m_maxParallelFrames * numActive + encCfg.m_numThreads - 1 ) / encCfg.m_numThreads );
+    }
+  };
+  setPicEncoders( m_preEncoder, m_firstPassCfg );
+  setPicEncoders( m_gopEncoder, m_encCfg );
+  for( int i = 0; i < (int)m_renditionEncoders.size(); i++ )
+  {
+    setPicEncoders( m_renditionEncoders[ i ], m_renditionCfgs[ i ] );
+  }
+}
+
+void EncLib::reconfig( const vvenc_config& encCfg )
+{
+  CHECK( m_gopEncoder == nullptr, "encoder not initialized" );
+  CHECK( m_encCfg.m_RCNumPasses > 1, "reconfiguration not supported in two pass rate control" );
+
+  // the final encoder takes over the new parameters at the next GOP start, the first pass encoder keeps its setup
+  m_gopEncoder->reconfig( encCfg );
 }
 
 void EncLib::printSummary()
@@ -509,6 +758,12 @@ void EncLib::printSummary()
   {
     m_gopEncoder->printOutSummary( m_encCfg.m_printMSEBasedSequencePSNR, m_encCfg.m_printSequenceMSE, m_encCfg.m_printHexPsnr );
   }
+  for( int i = 0; i < (int)m_renditionEncoders.size(); i++ )
+  {
+    const VVEncCfg& renditionCfg = m_renditionCfgs[ i ];
+    msg.log( VVENC_INFO, "\nrendition %d: %dx%d QP %d\n", i + 1, renditionCfg.m_SourceWidth, renditionCfg.m_SourceHeight, renditionCfg.m_QP );
+    m_renditionEncoders[ i ]->printOutSummary( renditionCfg.m_printMSEBasedSequencePSNR, renditionCfg.m_printSequenceMSE, renditionCfg.m_printHexPsnr );
+  }
 }
 
 void EncLib::getParameterSets( AccessUnitList& au )
@@ -546,7 +801,7 @@ PicShared* EncLib::xGetFreePicShared()
       return nullptr;
 
     picShared = new PicShared();
-    picShared->create( m_encCfg.m_framesToBeEncoded, m_encCfg.m_internChromaFormat, Size( m_encCfg.m_PadSourceWidth, m_encCfg.m_PadSourceHeight ), m_encCfg.m_vvencMCTF.MCTF || m_encCfg.m_usePerceptQPA );
+    picShared->create( m_encCfg.m_framesToBeEncoded, m_encCfg.m_internChromaFormat, Size( m_encCfg.m_PadSourceWidth, m_encCfg.m_PadSourceHeight ), m_encCfg.m_vvencMCTF.MCTF || m_encCfg.m_usePerceptQPA, m_encCfg.m_numaAware, m_yuvReleaseFunc != nullptr );
     m_picSharedList.push_back( picShared );
   }
   CHECK( picShared == nullptr, "out of memory" );
@@ -554,6 +809,29 @@ PicShared* EncLib::xGetFreePicShared()
   return picShared;
 }
 
+void EncLib::xReleaseLentBuffers( bool releaseAll )
+{
+  for( auto picShared : m_picSharedList )
+  {
+    if( picShared->isLent() && ( releaseAll || ! picShared->isUsed() ) )
+    {
+      if( releaseAll )
+      {
+        // encoder is shut down, drop pending references
+        while( picShared->isUsed() )
+        {
+          picShared->decUsed();
+        }
+      }
+      vvencYUVBuffer yuvBuf = picShared->returnLentBuffer();
+      if( m_yuvReleaseFunc )
+      {
+        m_yuvReleaseFunc( m_yuvReleaseCtx, &yuvBuf );
+      }
+    }
+  }
+}
+
 } // namespace vvenc
 
 //! \}
@@ -49,6 +49,8 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "vvenc/vvencCfg.h"
 #include "CommonLib/Nal.h"
 #include "EncCfg.h"
+#include "Checkpoint.h"
+#include "ThreadBudgetCtrl.h"
 
 #include <vector>
 #include <list>
@@ -73,6 +75,9 @@ class MsgLog;
 class EncStage;
 class PreProcess;
 class MCTF;
+class FGAStage;
+class CuTree;
+class Renditions;
 class EncGOP;
 class RateCtrl;
 class PicShared;
@@ -85,6 +90,8 @@ private:
 
   std::function<void( void*, vvencYUVBuffer* )> m_recYuvBufFunc;
   void*                                         m_recYuvBufCtx;
+  std::function<void( void*, vvencYUVBuffer* )> m_yuvReleaseFunc;
+  void*                                         m_yuvReleaseCtx;
 
   const VVEncCfg             m_encCfg;
   const VVEncCfg             m_orgCfg;
@@ -92,9 +99,15 @@ private:
   RateCtrl*                  m_rateCtrl;
   PreProcess*                m_preProcess;
   MCTF*                      m_MCTF;
+  FGAStage*                  m_fgaStage;
+  CuTree*                    m_cuTree;
   EncGOP*                    m_preEncoder;
   EncGOP*                    m_gopEncoder;
+  Renditions*                m_renditions;
   std::vector<EncStage*>     m_encStages;
+  std::vector<VVEncCfg>      m_renditionCfgs;
+  std::vector<RateCtrl*>     m_renditionRateCtrls;
+  std::vector<EncGOP*>       m_renditionEncoders;
   std::list<PicShared*>      m_picSharedList;
 
   NoMallocThreadPool*        m_threadPool;
@@ -106,25 +119,40 @@ private:
   std::mutex                 m_stagesMutex;
   std::condition_variable    m_stagesCond;
   std::deque<AccessUnitList> m_AuList;
+  uint64_t                   m_cfgSignature;
+  CheckpointStream           m_resumeState;
+  int                        m_resumePass;
+  int                        m_resumePoc;
+  int                        m_resumeQP;
+  int64_t                    m_resumeBitstreamSize;
+  ThreadBudgetCtrl           m_threadBudgetCtrl;
 
 public:
   EncLib( MsgLog& logger );
   virtual ~EncLib();
 
   void     setRecYUVBufferCallback( void* ctx, vvencRecYUVBufferCallback func );
-  void     initEncoderLib      ( const vvenc_config& encCfg );
+  void     setYUVBufferReleaseCallback( void* ctx, vvencYUVBufferReleaseCallback func );
+  void     initEncoderLib      ( const vvenc_config& encCfg, const std::vector<vvenc_config>& renditionCfgs = std::vector<vvenc_config>() );
   void     initPass            ( int pass, const char* statsFName );
   void     encodePicture       ( bool flush, const vvencYUVBuffer* yuvInBuf, AccessUnitList& au, bool& isQueueEmpty );
+  void     reconfig            ( const vvenc_config& encCfg );
   void     uninitEncoderLib    ();
   void     printSummary        ();
   void     getParameterSets    ( AccessUnitList& au );
   int      getCurPass          () const;
+  void     writeCheckpoint     ( const std::vector<uint8_t>& data, int64_t bitstreamSize );
+  void     getCheckpointInfo   ( int& pass, int& firstFrame, int& firstInputFrame, int64_t& bitstreamSize ) const;
+  void     setCpuBudget        ( int numThreads );
 
 private:
   void     xUninitLib          ();
   void     xInitRCCfg          ();
+  void     xInitCheckpoint     ();
 
   PicShared* xGetFreePicShared();
+  void       xReleaseLentBuffers( bool releaseAll );
+  void       xApplyThreadBudget ();
  };
 
 } // namespace vvenc
@@ -76,6 +76,7 @@ static const __itt_string_handle* itt_handle_alf_recon    = __itt_string_handle_
 static const __itt_string_handle* itt_handle_ccalf_stat   = __itt_string_handle_create( "CCALF_CTU_STAT" );
 static const __itt_string_handle* itt_handle_ccalf_derive = __itt_string_handle_create( "CCALF_DERIVE" );
 static const __itt_string_handle* itt_handle_ccalf_recon  = __itt_string_handle_create( "CCALF_RECONSTRUCT" );
+static const __itt_string_handle* itt_handle_metrics      = __itt_string_handle_create( "QUALITY_METRICS" );
 #endif
 
 void setArbitraryWppPattern( const PreCalcValues& pcv, std::vector<int>& ctuAddrMap, int stepX = 1 )
@@ -144,6 +145,7 @@ struct PerThreadRsrc
   CtxCache  m_CtxCache;
   EncCu     m_encCu;
   PelStorage m_alfTempCtuBuf;
+  QualityMetricsBuf m_metricsBuf;
 };
 
 struct CtuEncParam
@@ -181,6 +183,8 @@ EncSlice::EncSlice()
   , m_pcRateCtrl         ( nullptr )
   , m_CABACWriter        ( m_BinEncoder )
   , m_encCABACTableIdx   ( VVENC_I_SLICE )
+  , m_sliceDataInCtuTasks( false )
+  , m_sliceDataSubStrm   ( 0 )
 {
 }
 
@@ -238,6 +242,8 @@ void EncSlice::init( const VVEncCfg& encCfg,
   m_ThreadRsrc.resize( maxCtuEnc,  nullptr );
   m_TileLineEncRsrc.resize( maxCntRscr, nullptr );
 
+  m_qualityMetrics.init( encCfg, *pps.pcv );
+
   for( PerThreadRsrc*& taskRsc : m_ThreadRsrc )
   {
     taskRsc = new PerThreadRsrc();
@@ -247,6 +253,7 @@ void EncSlice::init( const VVEncCfg& encCfg,
                            m_syncPicCtx.data(),
                            &rateCtrl );
     taskRsc->m_alfTempCtuBuf.create( pps.pcv->chrFormat, Area( 0, 0, pps.pcv->maxCUSize + (MAX_ALF_PADDING_SIZE << 1), pps.pcv->maxCUSize + (MAX_ALF_PADDING_SIZE << 1) ), pps.pcv->maxCUSize, MAX_ALF_PADDING_SIZE, 0, false );
+    m_qualityMetrics.initBuf( taskRsc->m_metricsBuf );
   }
 
   for( TileLineEncRsrc*& lnRsc : m_TileLineEncRsrc )
@@ -285,6 +292,10 @@ void EncSlice::init( const VVEncCfg& encCfg,
     std::min( ((encCfg.m_ifpLines & (~(asuHeightInCtus - 1))) + asuHeightInCtus), pps.pcv->heightInCtus ) : pps.pcv->heightInCtus;
   m_alfDeriveCtu  = numDeriveLines * pps.pcv->widthInCtus - 1;
   m_ccalfDeriveCtu = encCfg.m_ifpLines ? pps.pcv->widthInCtus * std::min((unsigned)encCfg.m_ifpLines + 1, pps.pcv->heightInCtus) - 1: pps.pcv->sizeInCtus - 1;
+
+  // CTU lines can only be written before the picture is finished, if no picture level ALF decision is pending
+  // and the substreams follow the CTU line order (single tile)
+  m_sliceDataInCtuTasks = encCfg.m_lowLatencyOutput && !sps.alfEnabled && pps.getNumTiles() == 1;
 }
 
 
@@ -728,6 +739,9 @@ void EncSlice::finishCompressSlice( Picture* pic, Slice& slice )
 {
   CodingStructure& cs = *pic->cs;
 
+  // all CTU lines are final at this point
+  m_qualityMetrics.finishPic( *pic );
+
   // finalize
   if( slice.sps->saoEnabled && pic->useSAO )
   {
@@ -770,6 +784,13 @@ void EncSlice::xProcessCtus( Picture* pic, const unsigned startCtuTsAddr, const
     }
 
     std::fill( m_saoReconParams.begin(), m_saoReconParams.end(), SAOBlkParam() );
+
+    // slice header flags are needed when writing the first CTU line
+    if( m_sliceDataInCtuTasks )
+    {
+      slice.saoEnabled[ CH_L ] = m_saoEnabled[ COMP_Y  ];
+      slice.saoEnabled[ CH_C ] = m_saoEnabled[ COMP_Cb ];
+    }
   }
   else
   {
@@ -782,6 +803,12 @@ void EncSlice::xProcessCtus( Picture* pic, const unsigned startCtuTsAddr, const
   }
 
   std::fill( m_processStates.begin(), m_processStates.end(), CTU_ENCODE );
+  m_qualityMetrics.initPic();
+
+  if( m_sliceDataInCtuTasks )
+  {
+    xInitSliceData( pic );
+  }
 
   // fill encoder parameter list
   int idx = 0;
@@ -1355,6 +1382,10 @@ bool EncSlice::xProcessCtuTask( int threadIdx, void* taskParam )
           if( checkCtuTaskNbBot( pps, ctuPosX, ctuPosY, ctuRsAddr, processStates, CCALF_GET_STATISTICS ) ) return false;
         }
 
+        // low latency output: CTU lines are written in order, the line above has to be written first
+        if( encSlice->m_sliceDataInCtuTasks && ctuPosY > 0 && processStates[ ctuRsAddr - ctuStride ] < PROCESS_DONE )
+          return false;
+
         if( checkReadyState )
           return true;
 
@@ -1372,6 +1403,13 @@ bool EncSlice::xProcessCtuTask( int threadIdx, void* taskParam )
 
         ITT_TASKEND( itt_domain_encode, itt_handle_ccalf_recon );
 
+        // low latency output: write the CTU line as soon as it is final
+        if( encSlice->m_sliceDataInCtuTasks )
+        {
+          const uint32_t firstCtuInLine = ctuPosY * ctuStride;
+          encSlice->xEncodeSliceDataCtus( pic, firstCtuInLine, firstCtuInLine + ctuStride );
+        }
+
         // extend pic border
         // CCALF reconstruction stage is done per tile, ensure that all tiles in current CTU row are done  
         if( ++(pic->m_tileColsDone->at(ctuPosY)) >= pps.numTileCols )
@@ -1390,6 +1428,31 @@ bool EncSlice::xProcessCtuTask( int threadIdx, void* taskParam )
             ++(pic->m_tileColsDone->at( ctuPosY ));
         }
 
+        // the quality metrics of a CTU line are computed by the task of its last CTU
+        if( ctuPosX + 1 < pcv.widthInCtus )
+        {
+          processStates[ctuRsAddr] = PROCESS_DONE;
+          // processing done => terminate thread
+          return true;
+        }
+        processStates[ctuRsAddr] = QUALITY_METRICS;
+      }
+
+    case QUALITY_METRICS:
+      {
+        // all tiles of the CTU line have to be reconstructed
+        if( pic->m_tileColsDone->at( ctuPosY ) < pps.numTileCols )
+          return false;
+
+        if( checkReadyState )
+          return true;
+
+        ITT_TASKSTART( itt_domain_encode, itt_handle_metrics );
+
+        encSlice->m_qualityMetrics.processCtuLine( *pic, ctuPosY, encSlice->m_ThreadRsrc[ threadIdx ]->m_metricsBuf );
+
+        ITT_TASKEND( itt_domain_encode, itt_handle_metrics );
+
         // perform finish only once for whole picture
         const unsigned finishCtu = pcv.sizeInCtus - 1;
         if( ctuRsAddr < finishCtu )
@@ -1433,12 +1496,20 @@ bool EncSlice::xProcessCtuTask( int threadIdx, void* taskParam )
 }
 
 void EncSlice::encodeSliceData( Picture* pic )
+{
+  // in low latency mode the CTU lines have already been written by the CTU tasks
+  if( !m_sliceDataInCtuTasks )
+  {
+    xInitSliceData( pic );
+    xEncodeSliceDataCtus( pic, pic->cs->slice->sliceMap.ctuAddrInSlice[0], pic->cs->pcv->sizeInCtus );
+  }
+  xFinishSliceData( pic );
+}
+
+void EncSlice::xInitSliceData( Picture* pic )
 {
   CodingStructure& cs              = *pic->cs;
   Slice* const slice               = cs.slice;
-  const uint32_t startCtuTsAddr    = slice->sliceMap.ctuAddrInSlice[0];
-  const uint32_t boundingCtuTsAddr = cs.pcv->sizeInCtus;
-  const bool wavefrontsEnabled     = slice->sps->entropyCodingSyncEnabled;
 
   // this ensures that independently encoded bitstream chunks can be combined to bit-equal
   const SliceType cabacTableIdx = ! slice->pps->cabacInitPresent || slice->pendingRasInit ? slice->sliceType : m_encCABACTableIdx;
@@ -1449,20 +1520,35 @@ void EncSlice::encodeSliceData( Picture* pic )
 
   DTRACE( g_trace_ctx, D_HEADER, "=========== POC: %d ===========\n", slice->poc );
 
-  int prevQP[MAX_NUM_CH];
-  prevQP[0] = prevQP[1] = slice->sliceQp;
+  m_sliceDataPrevQP[0] = m_sliceDataPrevQP[1] = slice->sliceQp;
 
-  const PreCalcValues& pcv        = *cs.pcv;
-  const uint32_t widthInCtus      = pcv.widthInCtus;
-  uint32_t uiSubStrm              = 0;
   const int numSubstreamsColumns  = slice->pps->numTileCols;
   const int numSubstreamRows      = slice->sps->entropyCodingSyncEnabled ? pic->cs->pcv->heightInCtus : slice->pps->numTileRows;
   const int numSubstreams         = std::max<int>( numSubstreamRows * numSubstreamsColumns, 0/*(int)pic->brickMap->bricks.size()*/ );
-  std::vector<OutputBitstream> substreamsOut( numSubstreams );
+  m_sliceDataSubstreams.clear();
+  m_sliceDataSubstreams.resize( numSubstreams );
+  m_sliceDataSubStrm = 0;
 
   slice->clearSubstreamSizes();
+}
 
-  for( uint32_t ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr++ )
+void EncSlice::xEncodeSliceDataCtus( Picture* pic, const uint32_t startCtuTsAddr, const uint32_t endCtuTsAddr )
+{
+  CodingStructure& cs              = *pic->cs;
+  Slice* const slice               = cs.slice;
+  const uint32_t sliceStartTsAddr  = slice->sliceMap.ctuAddrInSlice[0];
+  const uint32_t boundingCtuTsAddr = cs.pcv->sizeInCtus;
+  const bool wavefrontsEnabled     = slice->sps->entropyCodingSyncEnabled;
+
+  int (&prevQP)[MAX_NUM_CH]        = m_sliceDataPrevQP;
+  std::vector<OutputBitstream>& substreamsOut = m_sliceDataSubstreams;
+  const int numSubstreams          = (int)substreamsOut.size();
+
+  const PreCalcValues& pcv        = *cs.pcv;
+  const uint32_t widthInCtus      = pcv.widthInCtus;
+  uint32_t& uiSubStrm             = m_sliceDataSubStrm;
+
+  for( uint32_t ctuTsAddr = startCtuTsAddr; ctuTsAddr < endCtuTsAddr; ctuTsAddr++ )
   {
     const uint32_t ctuRsAddr            = slice->sliceMap.ctuAddrInSlice[ctuTsAddr];
     const uint32_t ctuXPosInCtus        = ctuRsAddr % widthInCtus;
@@ -1480,7 +1566,7 @@ void EncSlice::encodeSliceData( Picture* pic )
     // set up CABAC contexts' state for this CTU
     if (ctuXPosInCtus == tileXPosInCtus && ctuYPosInCtus == tileYPosInCtus )
     {
-      if (ctuTsAddr != startCtuTsAddr) // if it is the first CTU, then the entropy coder has already been reset
+      if (ctuTsAddr != sliceStartTsAddr) // if it is the first CTU, then the entropy coder has already been reset
       {
         m_CABACWriter.initCtxModels( *slice );
       }
@@ -1489,7 +1575,7 @@ void EncSlice::encodeSliceData( Picture* pic )
     else if (ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled)
     {
       // Synchronize cabac probabilities with upper-right CTU if it's available and at the start of a line.
-      if (ctuTsAddr != startCtuTsAddr) // if it is the first CTU, then the entropy coder has already been reset
+      if (ctuTsAddr != sliceStartTsAddr) // if it is the first CTU, then the entropy coder has already been reset
       {
         m_CABACWriter.initCtxModels( *slice );
       }
@@ -1529,6 +1615,11 @@ void EncSlice::encodeSliceData( Picture* pic )
       uiSubStrm++;
     }
   } // CTU-loop
+}
+
+void EncSlice::xFinishSliceData( Picture* pic )
+{
+  Slice* const slice = pic->cs->slice;
 
   if(slice->pps->cabacInitPresent)
   {
@@ -1543,7 +1634,7 @@ void EncSlice::encodeSliceData( Picture* pic )
   OutputBitstream& outStream = pic->sliceDataStreams[ 0/*slice->sliceIdx*/ ];
   for ( int i = 0; i < slice->getNumberOfSubstreamSizes() + 1; i++ )
   {
-    outStream.addSubstream( &(substreamsOut[ i ]) );
+    outStream.addSubstream( &(m_sliceDataSubstreams[ i ]) );
   }
   pic->sliceDataNumBins += m_CABACWriter.getNumBins();
 }
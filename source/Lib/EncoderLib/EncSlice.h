@@ -49,6 +49,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Picture.h"
 #include "InterSearch.h"
+#include "QualityMetrics.h"
 
 #include <atomic>
 
@@ -83,6 +84,7 @@ enum TaskType {
   CCALF_GET_STATISTICS,
   CCALF_DERIVE_FILTER,
   CCALF_RECONSTRUCT,
+  QUALITY_METRICS,
   FINISH_SLICE,
   PROCESS_DONE
 };
@@ -114,6 +116,10 @@ private:
   SliceType                    m_encCABACTableIdx;
   unsigned                     m_alfDeriveCtu;
   unsigned                     m_ccalfDeriveCtu;
+  bool                         m_sliceDataInCtuTasks;                ///< entropy code each CTU line as soon as it is final (low latency output)
+  std::vector<OutputBitstream> m_sliceDataSubstreams;
+  uint32_t                     m_sliceDataSubStrm;
+  int                          m_sliceDataPrevQP[ MAX_NUM_CH ];
 
   double                       m_saoDisabledRate[ MAX_NUM_COMP ][ VVENC_MAX_TLAYER ];
   bool                         m_saoEnabled[ MAX_NUM_COMP ];
@@ -122,6 +128,7 @@ private:
   std::vector<SAOStatData**>   m_saoStatData;
   std::vector<CtuEncParam>     ctuEncParams;
   std::vector<int>             m_ctuAddrMap;
+  QualityMetrics               m_qualityMetrics;
 
 public:
   EncSlice();
@@ -149,6 +156,9 @@ private:
   void    xInitSliceLambdaQP  ( Slice* slice );
   double  xCalculateLambda    ( const Slice* slice, const int depth, const double refQP, const double dQP, int& iQP );
   void    xProcessCtus        ( Picture* pic, const unsigned startCtuTsAddr, const unsigned boundingCtuTsAddr );
+  void    xInitSliceData      ( Picture* pic );
+  void    xEncodeSliceDataCtus( Picture* pic, const uint32_t startCtuTsAddr, const uint32_t endCtuTsAddr );
+  void    xFinishSliceData    ( Picture* pic );
   template<bool checkReadyState=false>
   static bool xProcessCtuTask ( int taskIdx, void* taskParam );
 
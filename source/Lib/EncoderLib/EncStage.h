@@ -49,6 +49,9 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Picture.h"
 #include "CommonLib/Nal.h"
+#include "CommonLib/SEI.h"
+#include "Utilities/NoMallocThreadPool.h"
+#include "Checkpoint.h"
 
 #include <vector>
 
@@ -57,6 +60,24 @@ POSSIBILITY OF SUCH DAMAGE.
 
 namespace vvenc {
 
+// motion field of the MCTF motion search against one neighbouring picture
+struct MvHintField
+{
+  int             pocOffset;      // POC of the searched picture relative to the current picture
+  int             width;          // in blocks
+  int             height;
+  std::vector<Mv> mvs;            // one vector per block, internal MV precision
+};
+
+// film grain model of a picture, estimated by the asynchronous film grain analysis stage
+struct PicFgcModel
+{
+  bool              isAnalysed      { false };
+  int               log2ScaleFactor { 0 };
+  SeiFgc::CompModel compModel[ MAX_NUM_COMP ];
+  BlockingBarrier   done;           // unlocked when the analysis has finished
+};
+
 class PicShared
 {
 public:
@@ -71,10 +92,23 @@ public:
   uint8_t          m_minNoiseLevels[QPA_MAX_NOISE_LEVELS];
   std::vector<int> m_ctuBimQpOffset;
   int              m_picAuxQpOffset; // auxiliary QP offset per frame, for combination of RC and BIM (and possibly other tools)
+  std::vector<MvHintField> m_mvHints;
+  int              m_mvHintBlkSize;
+  CheckpointStream m_checkpoint;    // encoder state for a restart at this picture, set for IDR pictures when checkpoints are enabled
+  PicFgcModel      m_fgcModel;
 
 private:
   PelStorage       m_origBuf;
   PelStorage       m_filteredBuf;
+  PelStorage       m_lentBuf;       // references the planes of a caller owned input buffer, no allocation
+  PelStorage       m_lumaPyr[ NUM_LUMA_PYR_LEVELS ];
+  int              m_lumaPyrLevels; // number of valid pyramid levels
+  vvencYUVBuffer   m_lentYuvBuf;
+  bool             m_isLent;
+  ChromaFormat     m_chromaFormat;
+  Size             m_lumaSize;
+  int              m_padding;
+  bool             m_numaInterleave;
   uint64_t         m_cts;
   int              m_maxFrames;
   int              m_poc;
@@ -93,6 +127,12 @@ public:
   , m_picMemorySTA   ( 0 )
   , m_picMotEstError ( 0 )
   , m_picAuxQpOffset ( 0 )
+  , m_mvHintBlkSize  ( 0 )
+  , m_lumaPyrLevels  ( 0 )
+  , m_isLent         ( false )
+  , m_chromaFormat   ( NUM_CHROMA_FORMAT )
+  , m_padding        ( 0 )
+  , m_numaInterleave ( false )
   , m_cts            ( 0 )
   , m_maxFrames      ( -1 )
   , m_poc            ( -1 )
@@ -105,6 +145,7 @@ public:
     std::fill_n( m_prevShared, NUM_QPA_PREV_FRAMES, nullptr );
     std::fill_n( m_minNoiseLevels, QPA_MAX_NOISE_LEVELS, 255u );
     m_gopEntry.setDefaultGOPEntry();
+    vvenc_YUVBuffer_default( &m_lentYuvBuf );
   };
 
   ~PicShared() {};
@@ -114,26 +155,77 @@ public:
   void         decUsed()               { CHECK( m_refCount <= 0, "invalid state: release unused picture" ); if( m_refCount > 0 ) m_refCount -= 1; }
   bool         isLeadTrail()     const { return m_isLead || m_isTrail; }
   int          getPOC()          const { return m_poc; }
-  ChromaFormat getChromaFormat() const { return m_origBuf.chromaFormat; }
-  Size         getLumaSize()     const { return m_origBuf.Y(); }
+  bool         isLent()          const { return m_isLent; }
+  ChromaFormat getChromaFormat() const { return m_chromaFormat; }
+  Size         getLumaSize()     const { return m_lumaSize; }
 
-  void create( int maxFrames, ChromaFormat chromaFormat, const Size& size, bool useFilter )
+  void create( int maxFrames, ChromaFormat chromaFormat, const Size& size, bool useFilter, bool numaInterleave = false, bool lazyAlloc = false )
   {
     CHECK( m_refCount >= 0, "PicShared already created" );
 
-    m_maxFrames = maxFrames;
-    m_refCount  = 0;
+    m_maxFrames      = maxFrames;
+    m_refCount       = 0;
+    m_chromaFormat   = chromaFormat;
+    m_lumaSize       = size;
+    m_padding        = useFilter ? MCTF_PADDING : 0;
+    m_numaInterleave = numaInterleave;
 
-    const int padding = useFilter ? MCTF_PADDING : 0;
-    m_origBuf.create( chromaFormat, Area( Position(), size ), 0, padding );
+    if( ! lazyAlloc )
+    {
+      xCreateOrigBuf();
+    }
   }
 
-  void reuse( int poc, const vvencYUVBuffer* yuvInBuf )
+  static_assert( MCTF_PADDING <= VVENC_INPUT_BUFFER_MARGIN, "lent input buffers must provide the margin for the MCTF padding" );
+
+  // a caller owned input buffer can be referenced in place, if it has the internal size and enough margin for the padding
+  bool isLendable( const vvencYUVBuffer* yuvInBuf ) const
+  {
+    const int numComp = getNumberValidComponents( m_chromaFormat );
+    for( int i = 0; i < numComp; i++ )
+    {
+      const ComponentID    compID = ComponentID( i );
+      const vvencYUVPlane& plane  = yuvInBuf->planes[ i ];
+      const int            width  = m_lumaSize.width  >> getComponentScaleX( compID, m_chromaFormat );
+      const int            height = m_lumaSize.height >> getComponentScaleY( compID, m_chromaFormat );
+      const int            margin = m_padding         >> getComponentScaleX( compID, m_chromaFormat );
+      if( plane.ptr == nullptr || plane.width != width || plane.height != height || plane.stride < width + 2 * margin )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void reuse( int poc, const vvencYUVBuffer* yuvInBuf, bool lendBuffer = false )
   {
     CHECK( m_refCount < 0, "PicShared not created" );
     CHECK( isUsed(),       "PicShared still in use" );
+    CHECK( m_isLent,       "PicShared still references a lent input buffer" );
 
-    copyPadToPelUnitBuf( m_origBuf, *yuvInBuf, getChromaFormat() );
+    if( lendBuffer )
+    {
+      CHECK( ! isLendable( yuvInBuf ), "input buffer can not be referenced in place" );
+      const int  numComp = getNumberValidComponents( m_chromaFormat );
+      PelUnitBuf lentBuf;
+      lentBuf.chromaFormat = m_chromaFormat;
+      for( int i = 0; i < numComp; i++ )
+      {
+        const vvencYUVPlane& plane = yuvInBuf->planes[ i ];
+        lentBuf.bufs.push_back( PelBuf( plane.ptr, plane.stride, plane.width, plane.height ) );
+      }
+      m_lentBuf.createFromBuf( lentBuf );
+      m_lentYuvBuf = *yuvInBuf;
+      m_isLent     = true;
+    }
+    else
+    {
+      if( m_origBuf.bufs.empty() )
+      {
+        xCreateOrigBuf();
+      }
+      copyPadToPelUnitBuf( m_origBuf, *yuvInBuf, getChromaFormat() );
+    }
 
     m_picVA.reset();
     m_isSccWeak    = false;
@@ -149,6 +241,10 @@ public:
     m_ctuBimQpOffset.resize( 0 );
     m_picMotEstError = 0;
     m_picAuxQpOffset = 0;
+    m_mvHints.clear();
+    m_checkpoint.clear();
+    m_fgcModel.isAnalysed = false;
+    m_lumaPyrLevels  = 0;
     std::fill_n( m_prevShared, NUM_QPA_PREV_FRAMES, nullptr );
     std::fill_n( m_minNoiseLevels, QPA_MAX_NOISE_LEVELS, 255u );
     m_gopEntry.setDefaultGOPEntry();
@@ -157,11 +253,123 @@ public:
 #endif
   }
 
+  // resampled copy of an analysed picture for an additional rendition, the size dependent analysis data is mapped by the caller
+  void reuseResampled( PicShared& src, PelResampler& resampler )
+  {
+    CHECK( m_refCount < 0, "PicShared not created" );
+    CHECK( isUsed(),       "PicShared still in use" );
+
+    if( m_origBuf.bufs.empty() )
+    {
+      xCreateOrigBuf();
+    }
+    resampler.resample( m_origBuf, src.getOrigBuf() );
+    if( src.m_filteredBuf.valid() )
+    {
+      if( ! m_filteredBuf.valid() )
+      {
+        m_filteredBuf.create( m_chromaFormat, Area( Position(), m_lumaSize ), 0, m_padding );
+      }
+      resampler.resample( m_filteredBuf, src.m_filteredBuf );
+    }
+    else
+    {
+      m_filteredBuf.destroy();
+    }
+
+    m_gopEntry       = src.m_gopEntry;
+    m_picVA          = src.m_picVA;
+    m_isSccWeak      = src.m_isSccWeak;
+    m_isSccStrong    = src.m_isSccStrong;
+    m_forceSCC       = src.m_forceSCC;
+    m_picMemorySTA   = src.m_picMemorySTA;
+    m_picMotEstError = src.m_picMotEstError;
+    m_picAuxQpOffset = src.m_picAuxQpOffset;
+    m_cts            = src.m_cts;
+    m_poc            = src.m_poc;
+    m_refCount       = 0;
+    m_isLead         = src.m_isLead;
+    m_isTrail        = src.m_isTrail;
+    m_ctsValid       = src.m_ctsValid;
+    m_userData       = src.m_userData;
+    m_ctuBimQpOffset.resize( 0 );
+    m_mvHints.clear();
+    m_checkpoint.clear();
+    m_mvHintBlkSize  = src.m_mvHintBlkSize;
+    m_lumaPyrLevels  = 0;
+    std::fill_n( m_prevShared, NUM_QPA_PREV_FRAMES, nullptr );
+    std::copy_n( src.m_minNoiseLevels, QPA_MAX_NOISE_LEVELS, m_minNoiseLevels );
+
+    // the film grain model estimated on the full resolution picture is signalled for the rendition as well
+    m_fgcModel.isAnalysed = src.m_fgcModel.isAnalysed;
+    if( src.m_fgcModel.isAnalysed )
+    {
+      src.m_fgcModel.done.wait();
+      m_fgcModel.log2ScaleFactor = src.m_fgcModel.log2ScaleFactor;
+      std::copy_n( src.m_fgcModel.compModel, (int)MAX_NUM_COMP, m_fgcModel.compModel );
+      m_fgcModel.done.unlock();
+    }
+  }
+
+  // luma downsampled by 2^(level+1), created once on first request and shared by all pre-analysis stages
+  const PelStorage& getLumaPyramid( int level )
+  {
+    CHECK( level < 0 || level >= NUM_LUMA_PYR_LEVELS, "invalid luma pyramid level" );
+    for( ; m_lumaPyrLevels <= level; m_lumaPyrLevels++ )
+    {
+      const CPelBuf src = m_lumaPyrLevels ? m_lumaPyr[ m_lumaPyrLevels - 1 ].Y() : getOrigBuf().Y();
+      PelStorage&   dst = m_lumaPyr[ m_lumaPyrLevels ];
+      if( dst.bufs.empty() )
+      {
+        dst.create( CHROMA_400, Area( 0, 0, src.width >> 1, src.height >> 1 ), 0, MCTF_PADDING );
+      }
+      g_pelBufOP.downsample2x2( src.buf, src.stride, dst.Y().buf, dst.Y().stride, dst.Y().width, dst.Y().height );
+      dst.extendBorderPel( MCTF_PADDING, MCTF_PADDING );
+    }
+    return m_lumaPyr[ level ];
+  }
+
+  // motion hint for the block covering luma position (x,y), scaled from the field with the closest POC offset
+  bool getMvHint( int x, int y, int pocOffset, Mv& mv ) const
+  {
+    const MvHintField* field = nullptr;
+    for( const auto& f : m_mvHints )
+    {
+      if( ! field || abs( f.pocOffset - pocOffset ) < abs( field->pocOffset - pocOffset ) )
+      {
+        field = &f;
+      }
+    }
+    if( ! field || pocOffset == 0 )
+    {
+      return false;
+    }
+    const int bx = std::min( x / m_mvHintBlkSize, field->width  - 1 );
+    const int by = std::min( y / m_mvHintBlkSize, field->height - 1 );
+    mv = field->mvs[ by * field->width + bx ];
+    if( field->pocOffset != pocOffset )
+    {
+      mv.hor = mv.hor * pocOffset / field->pocOffset;
+      mv.ver = mv.ver * pocOffset / field->pocOffset;
+    }
+    return true;
+  }
+
+  // hand back a lent input buffer, must not be called before the last reference is released
+  vvencYUVBuffer returnLentBuffer()
+  {
+    CHECK( ! m_isLent, "PicShared does not reference a lent input buffer" );
+    CHECK( isUsed(),   "lent input buffer still in use" );
+    m_lentBuf.destroy();
+    m_isLent = false;
+    return m_lentYuvBuf;
+  }
+
   void shareData( Picture* pic )
   {
     PelStorage* prevOrigBufs[ NUM_QPA_PREV_FRAMES ];
     sharePrevBuffers( prevOrigBufs );
-    pic->linkSharedBuffers( &m_origBuf, &m_filteredBuf, prevOrigBufs, this );
+    pic->linkSharedBuffers( &getOrigBuf(), &m_filteredBuf, prevOrigBufs, this );
     pic->picVA          = m_picVA;
     pic->isSccWeak      = m_isSccWeak;
     pic->isSccStrong    = m_isSccStrong;
@@ -189,7 +397,7 @@ public:
       if( m_prevShared[ i ] )
       {
         m_prevShared[ i ]->incUsed();
-        prevOrigBufs[ i ] = &( m_prevShared[ i ]->m_origBuf );
+        prevOrigBufs[ i ] = &( m_prevShared[ i ]->getOrigBuf() );
       }
     }
   }
@@ -205,6 +413,18 @@ public:
     }
     pic->releasePrevBuffers();
   }
+
+private:
+  PelStorage& getOrigBuf() { return m_isLent ? m_lentBuf : m_origBuf; }
+
+  void xCreateOrigBuf()
+  {
+    m_origBuf.create( m_chromaFormat, Area( Position(), m_lumaSize ), 0, m_padding );
+    if( m_numaInterleave )
+    {
+      m_origBuf.interleaveNumaNodes();
+    }
+  }
 };
 
 // ====================================================================================================================
@@ -225,6 +445,7 @@ private:
   int       m_ctuSize          { MAX_CU_SIZE };
   bool      m_isNonBlocking    { false };
   bool      m_flush            { false };
+  bool      m_numaAware        { false };
 
 protected:
   int       m_picCount         { 0 };
@@ -274,6 +495,7 @@ public:
     m_sortByPoc        = sortByPoc;
     m_ctuSize          = encCfg.m_CTUSize;
     m_isNonBlocking    = nonBlocking;
+    m_numaAware        = encCfg.m_numaAware;
   }
 
   void linkNextStage( EncStage* nextStage )
@@ -309,6 +531,7 @@ public:
     {
       pic = new Picture();
       pic->create( chromaFormat, lumaSize, m_ctuSize, m_ctuSize + 16, false );
+      pic->numaInterleave = m_numaAware;
     }
     CHECK( pic == nullptr, "out of memory" );
     CHECK( pic->chromaFormat != chromaFormat || pic->Y().size() != lumaSize, "resolution or format changed" );
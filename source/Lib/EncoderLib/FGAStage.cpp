@@ -0,0 +1,225 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+
+
+
+/** \file     FGAStage.cpp
+    \brief    film grain analysis of the filtered input pictures as an asynchronous pipeline stage
+*/
+
+
+#include "FGAStage.h"
+#include "CommonLib/Picture.h"
+#include "Utilities/NoMallocThreadPool.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+FGAStage::FGAStage()
+  : m_encCfg         ( nullptr )
+  , m_threadPool     ( nullptr )
+  , m_isFinalPass    ( false )
+  , m_prevAnalysisPoc( -1 )
+  , m_procPic        ( nullptr )
+  , m_maskDone       ( false )
+{
+}
+
+
+FGAStage::~FGAStage()
+{
+  // the thread pool has been shut down before, so no analysis task is running anymore
+  if( m_encCfg )
+  {
+    m_fgAnalyzer.destroy();
+  }
+}
+
+
+void FGAStage::init( const VVEncCfg& encCfg, bool isFinalPass, NoMallocThreadPool* threadPool )
+{
+  m_encCfg          = &encCfg;
+  m_threadPool      = threadPool;
+  m_isFinalPass     = isFinalPass;
+  m_prevAnalysisPoc = -1;
+  m_procPic         = nullptr;
+
+  m_fgAnalyzer.init( encCfg.m_PadSourceWidth, encCfg.m_PadSourceHeight,
+                     encCfg.m_internChromaFormat, encCfg.m_outputBitDepth,
+                     encCfg.m_fg.m_fgcSEICompModelPresent );
+
+  m_tileTaskParams.resize( m_fgAnalyzer.getNumTiles() );
+  for( int i = 0; i < (int)m_tileTaskParams.size(); i++ )
+  {
+    m_tileTaskParams[ i ].stage   = this;
+    m_tileTaskParams[ i ].tileIdx = i;
+  }
+}
+
+
+void FGAStage::initPicture( Picture* pic )
+{
+}
+
+
+void FGAStage::processPictures( const PicList& picList, AccessUnitList& auList, PicList& doneList, PicList& freeList )
+{
+  // the filtered pictures arrive in display order and are passed on at once,
+  // only the picture under analysis is held back, until its film grain model is available
+  for( auto pic : picList )
+  {
+    if( pic == m_procPic )
+    {
+      if( pic->isFlush )
+      {
+        pic->m_picShared->m_fgcModel.done.wait();
+      }
+      if( ! pic->m_picShared->m_fgcModel.done.isBlocked() )
+      {
+        freeList.push_back( pic );
+        m_procPic = nullptr;
+      }
+      continue;
+    }
+
+    doneList.push_back( pic );
+
+    if( xIsAnalysisPic( pic ) )
+    {
+      // the analyses share the buffers of the analyzer, so they are serialized
+      if( m_procPic )
+      {
+        m_procPic->m_picShared->m_fgcModel.done.wait();
+        freeList.push_back( m_procPic );
+        m_procPic = nullptr;
+      }
+      xStartAnalysis( pic );
+      if( pic->m_picShared->m_fgcModel.done.isBlocked() )
+      {
+        continue;
+      }
+      m_procPic = nullptr;
+    }
+
+    freeList.push_back( pic );
+  }
+}
+
+
+bool FGAStage::xIsAnalysisPic( Picture* pic ) const
+{
+  // analyse one MCTF filtered picture per GOP in the final pass only, the lowest temporal layer is coded first
+  if( ! m_isFinalPass || ! pic->getFilteredOrigBuffer().valid() || pic->gopEntry->m_temporalId != 0 )
+  {
+    return false;
+  }
+  return m_prevAnalysisPoc < 0 || pic->poc - m_prevAnalysisPoc >= m_encCfg->m_GOPSize;
+}
+
+
+void FGAStage::xStartAnalysis( Picture* pic )
+{
+  PicShared* picShared = pic->m_picShared;
+
+  m_procPic         = pic;
+  m_prevAnalysisPoc = pic->poc;
+  picShared->m_fgcModel.isAnalysed = true;
+  picShared->m_fgcModel.done.lock();
+
+  if( ! m_threadPool )
+  {
+    m_fgAnalyzer.estimateGrainParameters( pic );
+    xFinishAnalysis( picShared );
+    return;
+  }
+
+  // mask of the whole picture, then the independent tiles, then the estimation of the model
+  static auto maskTask = []( int, void* param )
+  {
+    FGAStage* stage = static_cast<FGAStage*>( param );
+    Picture*  pic   = stage->m_procPic;
+    stage->m_fgAnalyzer.initAnalysis( pic->getOrigBuffer(), pic->getFilteredOrigBuffer() );
+    return true;
+  };
+
+  static auto tileTask = []( int, void* param )
+  {
+    TileTaskParam* tileParam = static_cast<TileTaskParam*>( param );
+    tileParam->stage->m_fgAnalyzer.analyseTile( tileParam->tileIdx );
+    return true;
+  };
+
+  static auto finishTask = []( int, void* param )
+  {
+    FGAStage* stage = static_cast<FGAStage*>( param );
+    stage->m_fgAnalyzer.finishAnalysis();
+    stage->xFinishAnalysis( stage->m_procPic->m_picShared );
+    return true;
+  };
+
+  m_maskDone.lock();
+  m_threadPool->addBarrierTask( maskTask, this, nullptr, &m_maskDone );
+  for( auto& tileParam : m_tileTaskParams )
+  {
+    m_threadPool->addBarrierTask( tileTask, &tileParam, &m_tileCounter, nullptr, { &m_maskDone } );
+  }
+  m_threadPool->addBarrierTask( finishTask, this, nullptr, nullptr, { &m_tileCounter.done } );
+}
+
+
+void FGAStage::xFinishAnalysis( PicShared* picShared )
+{
+  PicFgcModel& model = picShared->m_fgcModel;
+  model.log2ScaleFactor = m_fgAnalyzer.getLog2scaleFactor();
+  for( int compIdx = 0; compIdx < MAX_NUM_COMP; compIdx++ )
+  {
+    model.compModel[ compIdx ] = m_fgAnalyzer.getCompModel( compIdx );
+  }
+  model.done.unlock();
+}
+
+} // namespace vvenc
+
+//! \}
+
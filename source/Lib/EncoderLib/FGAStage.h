@@ -0,0 +1,105 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+
+
+
+/** \file     FGAStage.h
+    \brief    film grain analysis of the filtered input pictures as an asynchronous pipeline stage (header)
+*/
+
+
+#pragma once
+
+#include "CommonLib/CommonDef.h"
+#include "EncStage.h"
+#include "SEIFilmGrainAnalyzer.h"
+
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+class NoMallocThreadPool;
+
+// ====================================================================================================================
+
+class FGAStage : public EncStage
+{
+  private:
+    struct TileTaskParam
+    {
+      FGAStage* stage;
+      int       tileIdx;
+    };
+
+    const VVEncCfg*            m_encCfg;
+    NoMallocThreadPool*        m_threadPool;
+    bool                       m_isFinalPass;
+    int                        m_prevAnalysisPoc;
+    FGAnalyzer                 m_fgAnalyzer;
+    Picture*                   m_procPic;          // picture of the running analysis, kept until its model is available
+    Barrier                    m_maskDone;
+    WaitCounter                m_tileCounter;
+    std::vector<TileTaskParam> m_tileTaskParams;
+
+  public:
+    FGAStage();
+    virtual ~FGAStage();
+
+    void init( const VVEncCfg& encCfg, bool isFinalPass, NoMallocThreadPool* threadPool );
+
+  protected:
+    virtual void initPicture    ( Picture* pic );
+    virtual void processPictures( const PicList& picList, AccessUnitList& auList, PicList& doneList, PicList& freeList );
+
+  private:
+    bool xIsAnalysisPic   ( Picture* pic ) const;
+    void xStartAnalysis   ( Picture* pic );
+    void xFinishAnalysis  ( PicShared* picShared );
+};
+
+} // namespace vvenc
+
+//! \}
+
@@ -47,6 +47,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "GOPCfg.h"
 #include "EncStage.h"
+#include "Checkpoint.h"
 
 //! \ingroup EncoderLib
 //! \{
@@ -279,6 +280,38 @@ void GOPCfg::fixStartOfLastGop( GOPEntry& gopEntry )
   }
 }
 
+void GOPCfg::storeState( CheckpointStream& stream ) const
+{
+  const int gopListIdx = m_gopList == &m_remainGopList ? -1 : (int)( m_gopList - m_defaultGopLists.data() );
+  stream.write( gopListIdx );
+  stream.write( m_nextListIdx );
+  stream.write( m_gopNum );
+  stream.write( m_nextPoc );
+  stream.write( m_pocOffset );
+  stream.write( m_cnOffset );
+  stream.write( m_numTillGop );
+  stream.write( m_numTillIntra );
+  stream.write( m_lastIntraPOC );
+  stream.write( m_adjustNoLPcodingOrder );
+}
+
+void GOPCfg::restoreState( CheckpointStream& stream )
+{
+  const int gopListIdx = stream.read<int>();
+  CHECK( gopListIdx < -1 || gopListIdx >= (int)m_defaultGopLists.size(), "checkpoint gop state does not match the gop configuration" );
+  m_gopList = gopListIdx < 0 ? &m_remainGopList : &m_defaultGopLists[ gopListIdx ];
+  stream.read( m_nextListIdx );
+  stream.read( m_gopNum );
+  stream.read( m_nextPoc );
+  stream.read( m_pocOffset );
+  stream.read( m_cnOffset );
+  stream.read( m_numTillGop );
+  stream.read( m_numTillIntra );
+  stream.read( m_lastIntraPOC );
+  stream.read( m_adjustNoLPcodingOrder );
+  xCreatePocToGopIdx( *m_gopList, !m_poc0idr, m_pocToGopIdx );
+}
+
 void GOPCfg::getDefaultRPLLists( RPLList& rpl0, RPLList& rpl1 ) const
 {
   const int numRpl = (int)m_defaultRPLList.size();
@@ -57,6 +57,7 @@ POSSIBILITY OF SUCH DAMAGE.
 namespace vvenc {
 
 class PicShared;
+class CheckpointStream;
 
 class GOPCfg
 {
@@ -134,6 +135,8 @@ class GOPCfg
     void fixStartOfLastGop( GOPEntry& gopEntry );
     void getDefaultRPLLists( RPLList& rpl0, RPLList& rpl1 ) const;
     void setLastIntraSTA( int poc ) { m_lastIntraPOC = poc; }
+    void storeState     ( CheckpointStream& stream ) const;
+    void restoreState   ( CheckpointStream& stream );
 
     int  getMaxTLayer() const                             { return m_maxTid; }
     const std::vector<int>& getMaxDecPicBuffering() const { return m_maxDecPicBuffering; }
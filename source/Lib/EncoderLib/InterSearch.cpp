@@ -48,6 +48,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "InterSearch.h"
 #include "EncModeCtrl.h"
 #include "EncLib.h"
+#include "EncStage.h"
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Rom.h"
 #include "CommonLib/MotionInfo.h"
@@ -763,14 +764,16 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
                                             Distortion& uiDistBest,
                                             int& patternId,
                                             CPelBuf* pattern,
-                                            bool useAltHpelIf )
+                                            bool useAltHpelIf,
+                                            const SubPelPlanes* subPelPlanes,
+                                            const Position& planePos )
 {
   Distortion  uiDist;
   uiDistBest = m_pcEncCfg->m_fastSubPel == 1 ? uiDistBest : MAX_DISTORTION;
   uint32_t        uiDirecBest = 0;
   const int reduceTap = m_pcEncCfg->m_meReduceTap;
 
-  Pel*  piRefPos;
+  const Pel* piRefPos;
   int iRefStride = pcPatternKey->width + 1;
   m_pcRdCost->setDistParam( m_cDistParam, *pcPatternKey, m_filteredBlock[0][0][0], iRefStride, m_lumaClpRng.bd, COMP_Y, 0, m_pcEncCfg->m_bUseHADME ? ( m_pcEncCfg->m_fastHad ? 2 : 1 ) : 0 );
 
@@ -811,7 +814,11 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
           break;
         }
 
-        if( 0 == i )
+        if( subPelPlanes )
+        {
+          // all half-pel positions are read from the sub-pel planes
+        }
+        else if( 0 == i )
         {
           // split the prediction with funny widths into power-of-2 and +1 parts for the sake of SIMD speed-up
           m_if.filterHor( COMP_Y, srcPtr, srcStride, m_filteredBlockTmp[ 0 ][ 0 ], intStride, width, height + filterSize, 0 << MV_FRACTIONAL_BITS_DIFF, false, chFmt, clpRng, useAltHpelIf, 0, reduceTap );
@@ -854,15 +861,24 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
 
     int horVal = cMvTest.hor * iFrac;
     int verVal = cMvTest.ver * iFrac;
-    piRefPos = m_filteredBlock[verVal & 3][horVal & 3][0];
-
-    if ( horVal == 2 && ( verVal & 1 ) == 0 )
+    if( subPelPlanes && subPelPlanes->hasPhase( verVal & 3, horVal & 3 ) )
     {
-      piRefPos += 1;
+      piRefPos = subPelPlanes->getBuf( verVal & 3, horVal & 3, planePos.x + ( horVal >> 2 ), planePos.y + ( verVal >> 2 ) );
+      m_cDistParam.cur.stride = subPelPlanes->getStride();
     }
-    if ( ( horVal & 1 ) == 0 && verVal == 2 )
+    else
     {
-      piRefPos += iRefStride;
+      piRefPos = m_filteredBlock[verVal & 3][horVal & 3][0];
+
+      if ( horVal == 2 && ( verVal & 1 ) == 0 )
+      {
+        piRefPos += 1;
+      }
+      if ( ( horVal & 1 ) == 0 && verVal == 2 )
+      {
+        piRefPos += iRefStride;
+      }
+      m_cDistParam.cur.stride = iRefStride;
     }
     cMvTest = pcMvRefine[i];
     cMvTest += rcMvFrac;
@@ -2042,8 +2058,17 @@ void InterSearch::xMotionEstimation(CodingUnit& cu, CPelUnitBuf& origBuf, RefPic
   m_pcRdCost->setPredictor( predQuarter );
   m_pcRdCost->setCostScale(2);
 
+  // exact block matches from the block hash table of the reference picture make any SAD based search obsolete
+  // (the table is built after the reference picture has been finished, which is not deterministic with IFP)
+  const bool hashMatch = !bBi && cu.imv == IMV_OFF && m_pcEncCfg->m_hashME && !m_pcEncCfg->m_ifpLines && refPic->blockHash.isValid()
+                         && BlockHash::isSupported( cu.lwidth(), cu.lheight() ) && xHashMotionSearch( cu, *refPic, cStruct, rcMv, ruiCost );
+
   //  Do integer search
-  if( m_motionEstimationSearchMethod == VVENC_MESEARCH_FULL || bBi )
+  if( hashMatch )
+  {
+    relatedCU.setMv( refPicList, iRefIdxPred, rcMv );
+  }
+  else if( m_motionEstimationSearchMethod == VVENC_MESEARCH_FULL || bBi )
   {
     cStruct.subShiftMode = m_pcEncCfg->m_fastInterSearchMode == VVENC_FASTINTERSEARCH_MODE1 || m_pcEncCfg->m_fastInterSearchMode == VVENC_FASTINTERSEARCH_MODE3 ? 1 : 0;
     m_pcRdCost->setDistParam( m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY, cStruct.iRefStride, m_lumaClpRng.bd, COMP_Y, cStruct.subShiftMode );
@@ -2110,7 +2135,7 @@ void InterSearch::xMotionEstimation(CodingUnit& cu, CPelUnitBuf& origBuf, RefPic
   // sub-pel refinement for sub-pel resolution
   if ( cu.imv == IMV_OFF || cu.imv == IMV_HPEL )
   {
-    if ( m_pcEncCfg->m_fastSubPel != 2 )
+    if ( m_pcEncCfg->m_fastSubPel != 2 && !hashMatch )
     {
       xPatternSearchFracDIF( cu, refPicList, iRefIdxPred, cStruct, rcMv, cMvHalf, cMvQter, ruiCost );
     }
@@ -2131,6 +2156,57 @@ void InterSearch::xMotionEstimation(CodingUnit& cu, CPelUnitBuf& origBuf, RefPic
   DTRACE(g_trace_ctx, D_ME, "   MECost<L%d,%d>: %6d (%d)  MV:%d,%d\n", (int)refPicList, (int)bBi, ruiCost, ruiBits, rcMv.hor << 2, rcMv.ver << 2);
 }
 
+bool InterSearch::xHashMotionSearch( const CodingUnit& cu, const Picture& refPic, const TZSearchStruct& cStruct, Mv& rcMv, Distortion& ruiSAD )
+{
+  const CPelBuf& orgBuf  = *cStruct.pcPatternKey;
+  const uint32_t hash    = BlockHash::getBlockHash( orgBuf );
+  const CPelBuf  refBuf  = refPic.getRecoBuf( COMP_Y );
+  const Position pos     = cu.lumaPos();
+  const int      width   = orgBuf.width;
+  const int      height  = orgBuf.height;
+
+  const BlockHash::Entry* begin;
+  const BlockHash::Entry* end;
+  refPic.blockHash.getBucket( hash, getLog2( width ), begin, end );
+
+  Distortion bestCost = MAX_DISTORTION;
+  for( const BlockHash::Entry* entry = begin; entry < end; entry++ )
+  {
+    if( entry->hash != hash )
+    {
+      continue;
+    }
+
+    const int        mvHor = entry->x - pos.x;
+    const int        mvVer = entry->y - pos.y;
+    const Distortion cost  = m_pcRdCost->getCostOfVectorWithPredictor( mvHor, mvVer, cStruct.imvShift );
+    if( cost >= bestCost )
+    {
+      continue;
+    }
+
+    // rule out hash collisions
+    bool isEqual = true;
+    for( int y = 0; y < height && isEqual; y++ )
+    {
+      isEqual = memcmp( orgBuf.bufAt( 0, y ), refBuf.bufAt( entry->x, entry->y + y ), width * sizeof( Pel ) ) == 0;
+    }
+    if( isEqual )
+    {
+      bestCost = cost;
+      rcMv.set( mvHor, mvVer );
+    }
+  }
+
+  if( bestCost == MAX_DISTORTION )
+  {
+    return false;
+  }
+
+  ruiSAD = bestCost;
+  return true;
+}
+
 void InterSearch::xClipMvSearch( Mv& rcMv, const Position& pos, const struct Size& size, const PreCalcValues& pcv, const int ifpLines )
 {
   int iMvShift = MV_FRACTIONAL_BITS_INTERNAL;
@@ -2369,11 +2445,37 @@ void InterSearch::xTZSearch( const CodingUnit& cu,
     }
   }
 
+  // test the MCTF motion field of the picture, a good hint allows a smaller search range
+  bool bHintIsBest = false;
+  if( m_pcEncCfg->m_mctfMvHints && cu.cs->picture->m_picShared )
+  {
+    const Picture* refPic = cu.slice->getRefPic( refPicList, iRefIdxPred );
+    const Position center = cu.lumaPos().offset( cu.lumaSize().width >> 1, cu.lumaSize().height >> 1 );
+    Mv cTmpMv;
+    if( cu.cs->picture->m_picShared->getMvHint( center.x, center.y, refPic->getPOC() - cu.slice->poc, cTmpMv ) )
+    {
+      xClipMvSearch( cTmpMv, cu.lumaPos(), cu.lumaSize(), *cu.cs->pcv, m_pcEncCfg->m_ifpLines );
+      cTmpMv.changePrecision( MV_PRECISION_INTERNAL, MV_PRECISION_INT );
+      m_cDistParam.cur.buf = cStruct.piRefY + ( cTmpMv.ver * cStruct.iRefStride ) + cTmpMv.hor;
+
+      Distortion uiSad = m_cDistParam.distFunc( m_cDistParam );
+      uiSad += m_pcRdCost->getCostOfVectorWithPredictor( cTmpMv.hor, cTmpMv.ver, cStruct.imvShift );
+      if( uiSad < cStruct.uiBestSad )
+      {
+        cStruct.uiBestSad = uiSad;
+        cStruct.iBestX    = cTmpMv.hor;
+        cStruct.iBestY    = cTmpMv.ver;
+        m_cDistParam.maximumDistortionForEarlyExit = uiSad;
+        bHintIsBest       = true;
+      }
+    }
+  }
+
   {
     // set search range
     Mv currBestMv(cStruct.iBestX, cStruct.iBestY );
     currBestMv <<= MV_FRACTIONAL_BITS_INTERNAL;
-    xSetSearchRange(cu, currBestMv, m_iSearchRange >> (bFastSettings ? 1 : 0), sr );
+    xSetSearchRange(cu, currBestMv, m_iSearchRange >> ((bFastSettings ? 1 : 0) + (bHintIsBest ? 1 : 0)), sr );
   }
 
   // starting point after initial examination
@@ -2692,9 +2794,18 @@ void InterSearch::xPatternSearchFracDIF(
   int         iOffset    = rcMvInt.hor + rcMvInt.ver * cStruct.iRefStride;
   CPelBuf cPatternRoi(cStruct.piRefY + iOffset, cStruct.iRefStride, *cStruct.pcPatternKey);
 
+  //  Sub-pel planes of the reference picture (not available for the alternative half-pel filter)
+  const Picture*      refPic       = cu.slice->getRefPic( refPicList, iRefIdx );
+  const SubPelPlanes* subPelPlanes = refPic->subPelPlanes.isValid() && !cStruct.useAltHpelIf ? &refPic->subPelPlanes : nullptr;
+  const Position      planePos     ( cu.lx() + rcMvInt.hor, cu.ly() + rcMvInt.ver );
+  if( subPelPlanes )
+  {
+    subPelPlanes->prepareRows( m_if, m_lumaClpRng, planePos.y - 1, planePos.y + cPatternRoi.height );
+  }
+
   //  Half-pel refinement
   m_pcRdCost->setCostScale(1);
-  if( 0 == m_pcEncCfg->m_fastSubPel )
+  if( 0 == m_pcEncCfg->m_fastSubPel && !subPelPlanes )
   {
     xExtDIFUpSamplingH( &cPatternRoi, cStruct.useAltHpelIf );
   }
@@ -2703,7 +2814,7 @@ void InterSearch::xPatternSearchFracDIF(
   Mv baseRefMv(0, 0);
   Distortion  uiDistBest = MAX_DISTORTION;
   int patternId = 41;
-  ruiCost = xPatternRefinement( cStruct.pcPatternKey, baseRefMv, 2, rcMvHalf, uiDistBest, patternId, &cPatternRoi, cStruct.useAltHpelIf );
+  ruiCost = xPatternRefinement( cStruct.pcPatternKey, baseRefMv, 2, rcMvHalf, uiDistBest, patternId, &cPatternRoi, cStruct.useAltHpelIf, subPelPlanes, planePos );
   patternId -= ( m_pcEncCfg->m_fastSubPel == 1 ? 41 : 0 );
 
 
@@ -2712,13 +2823,22 @@ void InterSearch::xPatternSearchFracDIF(
   {
     PROFILER_SCOPE_AND_STAGE( 0, _TPROF, P_QPEL );
     m_pcRdCost->setCostScale( 0 );
-    xExtDIFUpSamplingQ( &cPatternRoi, rcMvHalf, patternId );
+    if( !subPelPlanes )
+    {
+      xExtDIFUpSamplingQ( &cPatternRoi, rcMvHalf, patternId );
+    }
+    else if( !subPelPlanes->hasPhase( 1, 1 ) )
+    {
+      // half-pel planes only, the quarter-pel blocks are interpolated from the horizontally filtered pattern
+      xExtDIFFilterHorH( &cPatternRoi, false );
+      xExtDIFUpSamplingQ( &cPatternRoi, rcMvHalf, patternId );
+    }
     baseRefMv = rcMvHalf;
     baseRefMv <<= 1;
 
     rcMvQter = rcMvInt;    rcMvQter <<= 1;    // for mv-cost
     rcMvQter += rcMvHalf;  rcMvQter <<= 1;
-    ruiCost = xPatternRefinement( cStruct.pcPatternKey, baseRefMv, 1, rcMvQter, uiDistBest, patternId, &cPatternRoi, cStruct.useAltHpelIf );
+    ruiCost = xPatternRefinement( cStruct.pcPatternKey, baseRefMv, 1, rcMvQter, uiDistBest, patternId, &cPatternRoi, cStruct.useAltHpelIf, subPelPlanes, planePos );
   }
 
 }
@@ -2909,9 +3029,8 @@ void InterSearch::xSymMotionEstimation( CodingUnit& cu, CPelUnitBuf& origBuf, Mv
 * \param pattern Reference picture ROI
 * \param biPred    Flag indicating whether block is for biprediction
 */
-void InterSearch::xExtDIFUpSamplingH(CPelBuf* pattern, bool useAltHpelIf)
+void InterSearch::xExtDIFFilterHorH( CPelBuf* pattern, bool useAltHpelIf )
 {
-  PROFILER_SCOPE_AND_STAGE( 0, _TPROF, P_HPEL_INTERP );
   const ClpRng& clpRng = m_lumaClpRng;
   int width            = pattern->width;
   int height           = pattern->height;
@@ -2919,9 +3038,6 @@ void InterSearch::xExtDIFUpSamplingH(CPelBuf* pattern, bool useAltHpelIf)
   const int reduceTap = m_pcEncCfg->m_meReduceTap;
 
   int intStride = width + 1;
-  int dstStride = width + 1;
-  Pel* intPtr;
-  Pel* dstPtr;
   int filterSize     = useAltHpelIf ? ( reduceTap >= 1 ? NTAPS_AFFINE : NTAPS_LUMA )
                                     : ( reduceTap == 1 ? NTAPS_AFFINE
                                                        : ( reduceTap == 0 ? NTAPS_LUMA : NTAPS_CHROMA ) );
@@ -2937,6 +3053,28 @@ void InterSearch::xExtDIFUpSamplingH(CPelBuf* pattern, bool useAltHpelIf)
   // split the prediction with funny widths into power-of-2 and +1 parts for the sake of SIMD speed-up
   m_if.filterHor( COMP_Y, srcPtr,         srcStride, m_filteredBlockTmp[2][0],         intStride, width, height + filterSize, 2 << MV_FRACTIONAL_BITS_DIFF, false, chFmt, clpRng, useAltHpelIf, 0, reduceTap );
   m_if.filterHor( COMP_Y, srcPtr + width, srcStride, m_filteredBlockTmp[2][0] + width, intStride,     1, height + filterSize, 2 << MV_FRACTIONAL_BITS_DIFF, false, chFmt, clpRng, useAltHpelIf, 0, reduceTap );
+}
+
+void InterSearch::xExtDIFUpSamplingH(CPelBuf* pattern, bool useAltHpelIf)
+{
+  PROFILER_SCOPE_AND_STAGE( 0, _TPROF, P_HPEL_INTERP );
+  const ClpRng& clpRng = m_lumaClpRng;
+  int width            = pattern->width;
+  int height           = pattern->height;
+  const int reduceTap = m_pcEncCfg->m_meReduceTap;
+
+  int intStride = width + 1;
+  int dstStride = width + 1;
+  Pel* intPtr;
+  Pel* dstPtr;
+  int filterSize     = useAltHpelIf ? ( reduceTap >= 1 ? NTAPS_AFFINE : NTAPS_LUMA )
+                                    : ( reduceTap == 1 ? NTAPS_AFFINE
+                                                       : ( reduceTap == 0 ? NTAPS_LUMA : NTAPS_CHROMA ) );
+  int halfFilterSize = ( filterSize >> 1 );
+
+  const ChromaFormat chFmt = m_currChromaFormat;
+
+  xExtDIFFilterHorH( pattern, useAltHpelIf );
 
   intPtr = m_filteredBlockTmp[0][0] + halfFilterSize * intStride + 1;
   dstPtr = m_filteredBlock[0][0][0];
@@ -5714,7 +5852,16 @@ uint32_t InterSearch::xCalcAffineMVBits(CodingUnit& cu, Mv acMvTemp[3], Mv acMvP
 //! set adaptive search range based on poc difference
 void InterSearch::setSearchRange( const Slice* slice, const VVEncCfg& encCfg )
 {
-  if( !encCfg.m_bUseASR || slice->isIRAP() )
+  if( !encCfg.m_bUseASR )
+  {
+    // fixed search range, which can be changed by a reconfiguration of the encoder
+    for( uint32_t iDir = 0; iDir < MAX_NUM_REF_LIST_ADAPT_SR; iDir++ )
+    {
+      std::fill_n( m_aaiAdaptSR[iDir], MAX_IDX_ADAPT_SR, encCfg.m_SearchRange );
+    }
+    return;
+  }
+  if( slice->isIRAP() )
   {
     return;
   }
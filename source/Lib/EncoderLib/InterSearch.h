@@ -436,7 +436,7 @@ public:
 private:
   void       xCalcMinDistSbt        ( CodingStructure &cs, const CodingUnit& cu, const uint8_t sbtAllowed );
   /// sub-function for motion vector refinement used in fractional-pel accuracy
-  Distortion xPatternRefinement     ( const CPelBuf* pcPatternKey, Mv baseRefMv, int iFrac, Mv& rcMvFrac, Distortion& uiDistBest, int& patternId, CPelBuf* pattern, bool useAltHpelIf );
+  Distortion xPatternRefinement     ( const CPelBuf* pcPatternKey, Mv baseRefMv, int iFrac, Mv& rcMvFrac, Distortion& uiDistBest, int& patternId, CPelBuf* pattern, bool useAltHpelIf, const SubPelPlanes* subPelPlanes, const Position& planePos );
 
    typedef struct
    {
@@ -534,6 +534,13 @@ private:
                                     Distortion&           ruiSAD
                                   );
 
+  bool xHashMotionSearch          ( const CodingUnit&     cu,
+                                    const Picture&        refPic,
+                                    const TZSearchStruct& cStruct,
+                                    Mv&                   rcMv,
+                                    Distortion&           ruiSAD
+                                  );
+
   void xPatternSearchIntRefine    ( CodingUnit&         cu,
                                     TZSearchStruct&     cStruct,
                                     Mv&                 rcMv,
@@ -600,6 +607,7 @@ private:
   bool xReadBufferedAffineUniMv       ( CodingUnit& cu, RefPicList eRefPicList, int32_t iRefIdx, Mv acMvPred[3], Mv acMv[3], uint32_t& ruiBits, Distortion& ruiCost, int& mvpIdx, const AffineAMVPInfo& aamvpi );
   bool xReadBufferedUniMv             ( CodingUnit& cu, RefPicList eRefPicList, int32_t iRefIdx, Mv& pcMvPred, Mv& rcMv, uint32_t& ruiBits, Distortion& ruiCost);
 
+  void xExtDIFFilterHorH              ( CPelBuf* pcPattern, bool useAltHpelIf );
   void xExtDIFUpSamplingH             ( CPelBuf* pcPattern, bool useAltHpelIf);
   void xExtDIFUpSamplingQ             ( CPelBuf* pcPatternKey, Mv halfPelRef, int& patternId );
 
@@ -46,7 +46,6 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "CommonLib/Nal.h"
 #include <vector>
 #include <algorithm>
-#include <ostream>
 
 
 //! \ingroup EncoderLib
@@ -56,7 +55,7 @@ namespace vvenc {
 
 static const uint8_t emulation_prevention_three_byte = 3;
 
-void writeNalUnitHeader(std::ostream& out, OutputNALUnit& nalu)       // nal_unit_header()
+void writeNalUnitHeader(std::vector<uint8_t>& out, OutputNALUnit& nalu)       // nal_unit_header()
 {
 OutputBitstream bsNALUHeader;
   int forbiddenZero = 0;
@@ -68,13 +67,16 @@ OutputBitstream bsNALUHeader;
   bsNALUHeader.write(nalu.m_nalUnitType, 5);      // nal_unit_type
   bsNALUHeader.write(nalu.m_temporalId + 1, 3);   // nuh_temporal_id_plus1
 
-  out.write(reinterpret_cast<const char*>(bsNALUHeader.getByteStream()), bsNALUHeader.getByteStreamLength());
+  const uint8_t* header = bsNALUHeader.getByteStream();
+  out.insert( out.end(), header, header + bsNALUHeader.getByteStreamLength() );
 }
 /**
- * write nalu to bytestream out, performing RBSP anti startcode
+ * append nalu to the byte buffer out, performing RBSP anti startcode
  * emulation as required.  nalu.m_RBSPayload must be byte aligned.
+ * The emulation prevented bytes are written directly into out, without
+ * any intermediate buffer.
  */
-void write(std::ostream& out, OutputNALUnit& nalu)
+void write(std::vector<uint8_t>& out, OutputNALUnit& nalu)
 {
   writeNalUnitHeader(out, nalu);
   /* write out rsbp_byte's, inserting any required
@@ -99,8 +101,10 @@ void write(std::ostream& out, OutputNALUnit& nalu)
    */
   std::vector<uint8_t>& rbsp   = nalu.m_Bitstream.getFIFO();
 
-  std::vector<uint8_t> outputBuffer;
-  outputBuffer.resize(rbsp.size()*2+1); //there can never be enough emulation_prevention_three_bytes to require this much space
+  // there can never be enough emulation_prevention_three_bytes to require this much space
+  const std::size_t startPos = out.size();
+  out.resize( startPos + rbsp.size() + rbsp.size() / 2 + 2 );
+  uint8_t*    outputBuffer = out.data() + startPos;
   std::size_t outputAmount = 0;
   int         zeroCount    = 0;
   for (std::vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end(); it++)
@@ -132,7 +136,7 @@ void write(std::ostream& out, OutputNALUnit& nalu)
   {
     outputBuffer[outputAmount++]=emulation_prevention_three_byte;
   }
-  out.write(reinterpret_cast<const char*>(&(*outputBuffer.begin())), outputAmount);
+  out.resize( startPos + outputAmount );
 }
 
 } // namespace vvenc
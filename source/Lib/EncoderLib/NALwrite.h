@@ -44,7 +44,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/BitStream.h"
 #include "CommonLib/Nal.h"
-#include <ostream>
+#include <vector>
 
 //! \ingroup EncoderLib
 //! \{
@@ -80,7 +80,7 @@ struct OutputNALUnit : public NALUnit
   OutputBitstream m_Bitstream;
 };
 
-void write(std::ostream& out, OutputNALUnit& nalu);
+void write(std::vector<uint8_t>& out, OutputNALUnit& nalu);
 
 inline NALUnitEBSP::NALUnitEBSP(OutputNALUnit& nalu)
   : NALUnit(nalu)
@@ -48,6 +48,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "PreProcess.h"
 #include "BitAllocation.h"
+#include "Checkpoint.h"
 
 //! \ingroup EncoderLib
 //! \{
@@ -65,6 +66,8 @@ PreProcess::PreProcess( MsgLog& _m )
   , m_doVisAct   ( false )
   , m_doVisActQpa( false )
   , m_cappedCQF  ( false )
+  , m_doCheckpoint( false )
+  , m_resumePoc  ( std::numeric_limits<int>::min() )
 {
 }
 
@@ -91,6 +94,36 @@ void PreProcess::init( const VVEncCfg& encCfg, bool isFinalPass )
                          || (m_encCfg->m_LookAhead && m_encCfg->m_RCTargetBitrate > 0)
                          || (m_encCfg->m_RCNumPasses > 1 && (!isFinalPass));
   m_doVisActQpa        = m_encCfg->m_usePerceptQPA;
+  m_doCheckpoint       = m_encCfg->m_checkpointFile[ 0 ] != '\0' && isFinalPass;
+  m_resumePoc          = std::numeric_limits<int>::min();
+  m_prerollRecords.clear();
+}
+
+
+void PreProcess::restoreState( CheckpointStream& stream, int resumePoc )
+{
+  CheckpointStream gopState;
+  stream.readStream( gopState );
+  m_gopCfg.restoreState( gopState );
+
+  const int numPreroll = stream.read<int>();
+  CHECK( numPreroll != getNumPreroll( *m_encCfg, resumePoc ), "invalid number of preroll pictures in checkpoint" );
+  m_prerollRecords.clear();
+  for( int i = 0; i < numPreroll; i++ )
+  {
+    PrerollRecord rec;
+    stream.read( rec );
+    m_prerollRecords.push_back( rec );
+  }
+
+  m_resumePoc = resumePoc;
+}
+
+
+int PreProcess::getNumPreroll( const VVEncCfg& encCfg, int poc )
+{
+  // pictures before the restart point, which have to be fed again to continue mctf and the analysis
+  return std::min( poc, std::max( encCfg.m_GOPSize, VVENC_MCTF_RANGE ) );
 }
 
 
@@ -106,11 +139,28 @@ void PreProcess::processPictures( const PicList& picList, AccessUnitList& auList
   {
     auto pic = picList.back();
 
-    // set gop entry
-    m_gopCfg.getNextGopEntry( pic->m_picShared->m_gopEntry );
+    // set gop entry, the preroll pictures of a restart take the analysis results from the checkpoint
+    const bool isPreroll = pic->poc < m_resumePoc;
+    CheckpointStream gopState;
+    if( isPreroll )
+    {
+      xApplyPrerollRecord( pic );
+    }
+    else
+    {
+      if( m_doCheckpoint )
+      {
+        m_gopCfg.storeState( gopState );
+      }
+      m_gopCfg.getNextGopEntry( pic->m_picShared->m_gopEntry );
+    }
     CHECK( pic->m_picShared->m_gopEntry.m_POC != pic->poc, "invalid state" );
 
-    if( ! pic->m_picShared->isLeadTrail() )
+    if( isPreroll )
+    {
+      xLinkPrevQpaBufs( pic, picList );
+    }
+    else if( ! pic->m_picShared->isLeadTrail() )
     {
       // link previous frames
       xLinkPrevQpaBufs( pic, picList );
@@ -140,6 +190,11 @@ void PreProcess::processPictures( const PicList& picList, AccessUnitList& auList
       {
         xDisableTempDown( pic, picList, 0 /*for faster - TODO: 2 for fast*/ );
       }
+
+      if( m_doCheckpoint )
+      {
+        xStoreCheckpoint( pic, gopState );
+      }
     }
     else if( pic->gopEntry->m_temporalId == 0 )
     {
@@ -175,6 +230,60 @@ void PreProcess::processPictures( const PicList& picList, AccessUnitList& auList
 }
 
 
+void PreProcess::xStoreCheckpoint( Picture* pic, const CheckpointStream& gopState )
+{
+  const PicShared* picShared  = pic->m_picShared;
+  const GOPEntry& gopEntry    = picShared->m_gopEntry;
+  const int numPreroll        = getNumPreroll( *m_encCfg, pic->poc );
+  const int maxPreroll        = std::max( m_encCfg->m_GOPSize, VVENC_MCTF_RANGE );
+
+  // restart is possible at an intra picture, which is coded after all previous pictures
+  if( gopEntry.m_isStartOfIntra && pic->poc > 0 && (int)m_prerollRecords.size() >= numPreroll
+      && std::all_of( m_prerollRecords.begin(), m_prerollRecords.end(), [&]( const PrerollRecord& rec ) { return rec.gopEntry.m_codingNum < gopEntry.m_codingNum; } ) )
+  {
+    CheckpointStream& stream = pic->m_picShared->m_checkpoint;
+    stream.clear();
+    stream.writeStream( gopState );
+    stream.write<int>( numPreroll );
+    for( auto itr = m_prerollRecords.end() - numPreroll; itr != m_prerollRecords.end(); itr++ )
+    {
+      stream.write( *itr );
+    }
+  }
+
+  // keep analysis results for following checkpoints
+  PrerollRecord rec;
+  rec.gopEntry     = gopEntry;
+  rec.picVA        = picShared->m_picVA;
+  rec.picMemorySTA = picShared->m_picMemorySTA;
+  rec.isSccWeak    = picShared->m_isSccWeak;
+  rec.isSccStrong  = picShared->m_isSccStrong;
+  m_prerollRecords.push_back( rec );
+  if( (int)m_prerollRecords.size() > maxPreroll )
+  {
+    m_prerollRecords.pop_front();
+  }
+}
+
+
+void PreProcess::xApplyPrerollRecord( Picture* pic ) const
+{
+  auto rec = std::find_if( m_prerollRecords.begin(), m_prerollRecords.end(), [&]( const PrerollRecord& r ) { return r.gopEntry.m_POC == pic->poc; } );
+  CHECK( rec == m_prerollRecords.end(), "missing analysis results for preroll picture " << pic->poc );
+
+  PicShared* picShared        = pic->m_picShared;
+  picShared->m_gopEntry       = rec->gopEntry;
+  picShared->m_picVA          = rec->picVA;
+  picShared->m_picMemorySTA   = rec->picMemorySTA;
+  picShared->m_isSccWeak      = rec->isSccWeak;
+  picShared->m_isSccStrong    = rec->isSccStrong;
+  pic->picVA                  = rec->picVA;
+  pic->picMemorySTA           = rec->picMemorySTA;
+  pic->isSccWeak              = rec->isSccWeak;
+  pic->isSccStrong            = rec->isSccStrong;
+}
+
+
 void PreProcess::xFreeUnused( Picture* pic, const PicList& picList, PicList& doneList, PicList& freeList ) const
 {
   // current picture is done
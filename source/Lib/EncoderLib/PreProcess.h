@@ -63,6 +63,16 @@ namespace vvenc {
 class PreProcess : public EncStage
 {
   private:
+    // analysis results of a picture, needed to continue the analysis after a restart
+    struct PrerollRecord
+    {
+      GOPEntry  gopEntry;
+      PicVisAct picVA;
+      int       picMemorySTA;
+      bool      isSccWeak;
+      bool      isSccStrong;
+    };
+
     const VVEncCfg* m_encCfg;
     GOPCfg          m_gopCfg;
     int             m_lastPoc;
@@ -72,12 +82,18 @@ class PreProcess : public EncStage
     bool            m_doVisAct;
     bool            m_doVisActQpa;
     bool            m_cappedCQF;
+    bool            m_doCheckpoint;
+    int             m_resumePoc;
+    std::deque<PrerollRecord> m_prerollRecords;
 
   public:
     PreProcess( MsgLog& _m );
     virtual ~PreProcess();
 
-    void init( const VVEncCfg& encCfg, bool isFinalPass );
+    void init        ( const VVEncCfg& encCfg, bool isFinalPass );
+    void restoreState( CheckpointStream& stream, int resumePoc );
+
+    static int getNumPreroll( const VVEncCfg& encCfg, int poc );
 
     const GOPCfg* getGOPCfg() const { return &m_gopCfg; };
 
@@ -97,6 +113,8 @@ class PreProcess : public EncStage
     void     xDetectSTA           ( Picture* pic, const PicList& picList );
     void     xDetectScc           ( Picture* pic ) const;
     void     xDisableTempDown     ( Picture* pic, const PicList& picList, const int thresh = INT32_MAX );
+    void     xStoreCheckpoint     ( Picture* pic, const CheckpointStream& gopState );
+    void     xApplyPrerollRecord  ( Picture* pic ) const;
 };
 
 } // namespace vvenc
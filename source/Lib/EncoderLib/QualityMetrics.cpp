@@ -0,0 +1,334 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     QualityMetrics.cpp
+    \brief    per frame quality metrics of the reconstruction, computed per CTU line
+*/
+
+
+#include "QualityMetrics.h"
+
+#include <cmath>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+// MS-SSIM weights of the scales (Wang et al.), renormalized over the scales available for the CTU size
+static const double MS_SSIM_WEIGHTS[ QM_MAX_SCALES ] = { 0.0448, 0.2856, 0.3001, 0.2363, 0.1333 };
+static const double VIF_SIGMA_NSQ   = 2.0;     // variance of the visual noise in the VIF model (8 bit scale)
+static const double VIF_EPS         = 1.0e-10;
+static const double DETAIL_MIN_VAR  = 1.0;     // windows of lower variance (8 bit scale) contain no detail
+
+QualityMetrics::QualityMetrics()
+  : m_structural  ( false )
+  , m_chromaFormat( CHROMA_420 )
+  , m_numComp     ( 0 )
+  , m_ctuSize     ( 0 )
+  , m_ctuSizeLog2 ( 0 )
+  , m_numScales   ( 0 )
+  , m_bufStride   ( 0 )
+  , m_sumsStride  ( 0 )
+  , m_c1          ( 0.0 )
+  , m_c2          ( 0.0 )
+  , m_varScale    ( 1.0 )
+{
+  m_bitDepth[ CH_L ] = m_bitDepth[ CH_C ] = 8;
+}
+
+void QualityMetrics::init( const VVEncCfg& encCfg, const PreCalcValues& pcv )
+{
+  m_structural   = encCfg.m_qualityMetrics;
+  m_chromaFormat = pcv.chrFormat;
+  m_numComp      = getNumberValidComponents( m_chromaFormat );
+  m_bitDepth[ CH_L ] = encCfg.m_internalBitDepth[ CH_L ];
+  m_bitDepth[ CH_C ] = encCfg.m_internalBitDepth[ CH_C ];
+  m_ctuSize      = pcv.maxCUSize;
+  m_ctuSizeLog2  = pcv.maxCUSizeLog2;
+
+  for( int comp = 0; comp < m_numComp; comp++ )
+  {
+    const ComponentID compID = ComponentID( comp );
+    m_size[ comp ] = Size( ( pcv.lumaWidth  - encCfg.m_aiPad[ 0 ] ) >> getComponentScaleX( compID, m_chromaFormat ),
+                           ( pcv.lumaHeight - encCfg.m_aiPad[ 1 ] ) >> getComponentScaleY( compID, m_chromaFormat ) );
+  }
+
+  // the scales of the MS-SSIM pyramid stop at the smallest CTU line still holding a full window
+  m_numScales = 0;
+  while( m_numScales < QM_MAX_SCALES && ( m_ctuSize >> m_numScales ) >= 8 )
+  {
+    m_numScales++;
+  }
+  m_bufStride  = ( m_size[ COMP_Y ].width + 1 ) >> 1;
+  m_sumsStride = ( m_size[ COMP_Y ].width >> 2 ) + 1;
+
+  const double maxVal = double( ( 1 << m_bitDepth[ CH_L ] ) - 1 );
+  m_c1       = ( 0.01 * maxVal ) * ( 0.01 * maxVal );
+  m_c2       = ( 0.03 * maxVal ) * ( 0.03 * maxVal );
+  m_varScale = 1.0 / double( 1 << ( 2 * ( m_bitDepth[ CH_L ] - 8 ) ) );
+
+  m_lineStats.resize( pcv.heightInCtus );
+}
+
+void QualityMetrics::initBuf( QualityMetricsBuf& buf ) const
+{
+  if( ! m_structural )
+  {
+    return;
+  }
+  for( int i = 0; i < 2; i++ )
+  {
+    buf.scaled[ i ][ 0 ].resize( m_bufStride * ( m_ctuSize >> 1 ) );
+    buf.scaled[ i ][ 1 ].resize( m_bufStride * ( m_ctuSize >> 1 ) );
+    buf.blkSums[ i ].resize( 5 * m_sumsStride );
+  }
+}
+
+void QualityMetrics::initPic()
+{
+  std::fill( m_lineStats.begin(), m_lineStats.end(), CtuLineStats{} );
+}
+
+void QualityMetrics::processCtuLine( const Picture& pic, const int ctuPosY, QualityMetricsBuf& buf )
+{
+  CtuLineStats&     line  = m_lineStats[ ctuPosY ];
+  const CPelUnitBuf org   = pic.getOrigBuf();
+  const CPelUnitBuf rec   = pic.getRecoBuf();
+  const int         lumaY = ctuPosY << m_ctuSizeLog2;
+
+  for( int comp = 0; comp < m_numComp; comp++ )
+  {
+    const ComponentID compID = ComponentID( comp );
+    const int         csy    = getComponentScaleY( compID, m_chromaFormat );
+    const int         y0     = lumaY >> csy;
+    const int         y1     = std::min<int>( ( lumaY + m_ctuSize ) >> csy, m_size[ comp ].height );
+    const CPelBuf     o      = org.get( compID );
+    const CPelBuf     r      = rec.get( compID );
+
+    line.ssd[ comp ] = y1 > y0 ? g_pelBufOP.ssd( o.bufAt( 0, y0 ), o.stride, r.bufAt( 0, y0 ), r.stride, m_size[ comp ].width, y1 - y0 ) : 0;
+  }
+
+  if( ! m_structural )
+  {
+    return;
+  }
+
+  const CPelBuf o = org.get( COMP_Y );
+  const CPelBuf r = rec.get( COMP_Y );
+  const Pel* src0    = o.bufAt( 0, lumaY );
+  const Pel* src1    = r.bufAt( 0, lumaY );
+  int        stride0 = o.stride;
+  int        stride1 = r.stride;
+  int        width   = m_size[ COMP_Y ].width;
+  int        height  = std::min<int>( m_ctuSize, (int) m_size[ COMP_Y ].height - lumaY );
+
+  for( int scale = 0; scale < m_numScales && width >= 8 && height >= 8; scale++ )
+  {
+    xAddWindows( src0, stride0, src1, stride1, width, height, scale, line, buf );
+
+    if( scale + 1 < m_numScales )
+    {
+      width  >>= 1;
+      height >>= 1;
+      Pel* dst0 = buf.scaled[ scale & 1 ][ 0 ].data();
+      Pel* dst1 = buf.scaled[ scale & 1 ][ 1 ].data();
+      g_pelBufOP.downsample2x2( src0, stride0, dst0, m_bufStride, width, height );
+      g_pelBufOP.downsample2x2( src1, stride1, dst1, m_bufStride, width, height );
+      src0    = dst0;
+      src1    = dst1;
+      stride0 = stride1 = m_bufStride;
+    }
+  }
+}
+
+void QualityMetrics::xAddWindows( const Pel* src0, const int stride0, const Pel* src1, const int stride1, const int width, const int height, const int scale, CtuLineStats& line, QualityMetricsBuf& buf ) const
+{
+  const int    numBlkX   = width  >> 2;
+  const int    numBlkY   = height >> 2;
+  const int    ss        = m_sumsStride;
+  const double norm      = 1.0 / 64.0;
+  int*         sumsAbove = buf.blkSums[ 0 ].data();
+  int*         sumsCur   = buf.blkSums[ 1 ].data();
+
+  g_pelBufOP.ssimSums4x4( src0, stride0, src1, stride1, numBlkX, sumsAbove, ss );
+
+  for( int by = 1; by < numBlkY; by++ )
+  {
+    g_pelBufOP.ssimSums4x4( src0 + 4 * by * stride0, stride0, src1 + 4 * by * stride1, stride1, numBlkX, sumsCur, ss );
+
+    // 8x8 windows of 2x2 blocks, overlapping by one block
+    for( int bx = 0; bx + 1 < numBlkX; bx++ )
+    {
+      int sum[ 5 ];
+      for( int k = 0; k < 5; k++ )
+      {
+        sum[ k ] = sumsAbove[ k * ss + bx ] + sumsAbove[ k * ss + bx + 1 ] + sumsCur[ k * ss + bx ] + sumsCur[ k * ss + bx + 1 ];
+      }
+
+      const double mu0  = sum[ 0 ] * norm;
+      const double mu1  = sum[ 1 ] * norm;
+      const double var0 = std::max( 0.0, sum[ 2 ] * norm - mu0 * mu0 );
+      const double var1 = std::max( 0.0, sum[ 3 ] * norm - mu1 * mu1 );
+      const double cov  = sum[ 4 ] * norm - mu0 * mu1;
+      const double lum  = ( 2.0 * mu0 * mu1 + m_c1 ) / ( mu0 * mu0 + mu1 * mu1 + m_c1 );
+      const double cs   = ( 2.0 * cov + m_c2 ) / ( var0 + var1 + m_c2 );
+
+      line.ssim      [ scale ] += lum * cs;
+      line.cs        [ scale ] += cs;
+      line.numWindows[ scale ]++;
+
+      // pixel domain VIF: information of the original preserved in the reconstruction modeled as gain plus noise
+      const double v0 = var0 * m_varScale;
+      const double v1 = var1 * m_varScale;
+      const double c  = cov  * m_varScale;
+      double gain     = c / ( v0 + VIF_EPS );
+      double noise    = v1 - gain * c;
+      if( v0 < VIF_EPS )
+      {
+        gain  = 0.0;
+        noise = v1;
+      }
+      if( v1 < VIF_EPS )
+      {
+        gain  = 0.0;
+        noise = 0.0;
+      }
+      if( gain < 0.0 )
+      {
+        gain  = 0.0;
+        noise = v1;
+      }
+      noise = std::max( noise, VIF_EPS );
+      line.vifNum += std::log2( 1.0 + gain * gain * v0 / ( noise + VIF_SIGMA_NSQ ) );
+      line.vifDen += std::log2( 1.0 + v0 / VIF_SIGMA_NSQ );
+
+      // detail preservation: part of the local contrast of the original restored in the reconstruction
+      if( v0 > DETAIL_MIN_VAR )
+      {
+        const double sd0 = sqrt( v0 );
+        line.detailNum  += std::min( std::max( c, 0.0 ) / sd0, sd0 );
+        line.detailDen  += sd0;
+      }
+    }
+
+    std::swap( sumsAbove, sumsCur );
+  }
+}
+
+void QualityMetrics::finishPic( Picture& pic ) const
+{
+  for( int comp = 0; comp < m_numComp; comp++ )
+  {
+    uint64_t ssd = 0;
+    for( const auto& line : m_lineStats )
+    {
+      ssd += line.ssd[ comp ];
+    }
+
+    const ComponentID compID = ComponentID( comp );
+    const uint32_t    maxval = 255 << ( m_bitDepth[ toChannelType( compID ) ] - 8 );
+    const uint32_t    size   = m_size[ comp ].width * m_size[ comp ].height;
+    const double  fRefValue  = (double)maxval * maxval * size;
+    pic.psnr[ comp ] = ssd ? 10.0 * log10( fRefValue / (double)ssd ) : MAX_DOUBLE;
+    pic.mse [ comp ] = (double)ssd / size;
+  }
+
+  pic.ssim   = 0.0;
+  pic.msSsim = 0.0;
+  pic.vif    = 0.0;
+  pic.detail = 0.0;
+  if( ! m_structural )
+  {
+    return;
+  }
+
+  double ssim      [ QM_MAX_SCALES ] = { 0.0 };
+  double cs        [ QM_MAX_SCALES ] = { 0.0 };
+  int    numWindows[ QM_MAX_SCALES ] = { 0 };
+  double vifNum = 0.0, vifDen = 0.0, detailNum = 0.0, detailDen = 0.0;
+  for( const auto& line : m_lineStats )
+  {
+    for( int scale = 0; scale < m_numScales; scale++ )
+    {
+      ssim      [ scale ] += line.ssim      [ scale ];
+      cs        [ scale ] += line.cs        [ scale ];
+      numWindows[ scale ] += line.numWindows[ scale ];
+    }
+    vifNum    += line.vifNum;
+    vifDen    += line.vifDen;
+    detailNum += line.detailNum;
+    detailDen += line.detailDen;
+  }
+
+  int numScales = 0;
+  while( numScales < m_numScales && numWindows[ numScales ] > 0 )
+  {
+    numScales++;
+  }
+  if( numScales == 0 )
+  {
+    pic.ssim = pic.msSsim = pic.vif = pic.detail = 1.0;
+    return;
+  }
+
+  double weightSum = 0.0;
+  for( int scale = 0; scale < numScales; scale++ )
+  {
+    weightSum += MS_SSIM_WEIGHTS[ scale ];
+  }
+  double msSsim = 1.0;
+  for( int scale = 0; scale < numScales; scale++ )
+  {
+    // contrast-structure terms of the finer scales, luminance only at the coarsest scale
+    const double val = ( scale + 1 < numScales ? cs[ scale ] : ssim[ scale ] ) / numWindows[ scale ];
+    msSsim *= pow( std::max( val, 0.0 ), MS_SSIM_WEIGHTS[ scale ] / weightSum );
+  }
+
+  pic.ssim   = ssim[ 0 ] / numWindows[ 0 ];
+  pic.msSsim = msSsim;
+  pic.vif    = vifDen    > 0.0 ? vifNum    / vifDen    : 1.0;
+  pic.detail = detailDen > 0.0 ? detailNum / detailDen : 1.0;
+}
+
+} // namespace vvenc
+
+//! \}
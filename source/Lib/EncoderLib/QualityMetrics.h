@@ -0,0 +1,119 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+
+/** \file     QualityMetrics.h
+    \brief    per frame quality metrics of the reconstruction, computed per CTU line (header)
+*/
+
+#pragma once
+
+#include "CommonLib/Picture.h"
+
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+// ====================================================================================================================
+
+static const int QM_MAX_SCALES = 5;
+
+// scratch memory of one thread
+struct QualityMetricsBuf
+{
+  std::vector<Pel> scaled[ 2 ][ 2 ];   // downscaled original and reconstruction of the CTU line, used alternately per scale
+  std::vector<int> blkSums[ 2 ];       // sums of two lines of 4x4 blocks
+};
+
+// quality metrics of the reconstructed picture: PSNR, and optionally luma SSIM, MS-SSIM and the VMAF like features
+// pixel domain VIF and detail preservation. Each CTU line is processed as soon as its reconstruction is final, the
+// SSIM windows (8x8, step 4) and the MS-SSIM pyramid are kept within the CTU line. The sums per CTU line are combined
+// in line order, so the result does not depend on the scheduling of the CTU tasks.
+class QualityMetrics
+{
+  private:
+    struct CtuLineStats
+    {
+      uint64_t ssd       [ MAX_NUM_COMP ];
+      double   ssim      [ QM_MAX_SCALES ];
+      double   cs        [ QM_MAX_SCALES ];
+      int      numWindows[ QM_MAX_SCALES ];
+      double   vifNum;
+      double   vifDen;
+      double   detailNum;
+      double   detailDen;
+    };
+
+    bool                      m_structural;
+    ChromaFormat              m_chromaFormat;
+    int                       m_numComp;
+    int                       m_bitDepth[ MAX_NUM_CH ];
+    Size                      m_size[ MAX_NUM_COMP ];      // component size without the conformance padding
+    int                       m_ctuSize;
+    int                       m_ctuSizeLog2;
+    int                       m_numScales;
+    int                       m_bufStride;
+    int                       m_sumsStride;
+    double                    m_c1;
+    double                    m_c2;
+    double                    m_varScale;                  // scales the variances to 8 bit for the VIF noise model
+    std::vector<CtuLineStats> m_lineStats;
+
+  public:
+    QualityMetrics();
+
+    void init          ( const VVEncCfg& encCfg, const PreCalcValues& pcv );
+    void initBuf       ( QualityMetricsBuf& buf ) const;
+    void initPic       ();
+    void processCtuLine( const Picture& pic, const int ctuPosY, QualityMetricsBuf& buf );
+    void finishPic     ( Picture& pic ) const;
+
+  private:
+    void xAddWindows   ( const Pel* src0, const int stride0, const Pel* src1, const int stride1, const int width, const int height, const int scale, CtuLineStats& line, QualityMetricsBuf& buf ) const;
+};
+
+} // namespace vvenc
+
+//! \}
+
@@ -51,11 +51,65 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "vvenc/version.h"
 #include "RateCtrl.h"
 #include "CommonLib/Picture.h"
+#include "Checkpoint.h"
 
 #include <cmath>
+#include <cstddef>
 
 namespace vvenc {
 
+// binary rate control statistics file: a fixed-size header and one fixed-size record per picture,
+// followed by the intra PQPA statistics, which are appended when the file is closed
+static const char     RC_STATS_MAGIC[ 4 ]     = { 'V', 'V', 'R', 'C' };
+static const uint32_t RC_STATS_FORMAT_VERSION = 1;
+
+struct RCStatsFileHeader
+{
+  char     magic[ 4 ];
+  uint32_t formatVersion;
+  uint32_t headerSize;
+  uint32_t recordSize;
+  char     encVersion[ 32 ];
+  int32_t  sourceWidth;
+  int32_t  sourceHeight;
+  int32_t  ctuSize;
+  int32_t  gopSize;
+  int32_t  intraPeriod;
+  int32_t  qp;
+  int32_t  rcInitialQP;
+  uint8_t  pqpa;
+  uint8_t  reserved[ 3 ];
+  uint32_t numRecords;   // written when the file is closed
+  uint32_t numPqpaStats; // written when the file is closed
+};
+
+struct RCStatsFileRecord
+{
+  double   lambda;
+  double   psnrY;
+  int32_t  poc;
+  int32_t  qp;
+  uint32_t numBits;
+  int32_t  gopNum;
+  int32_t  spVisAct;
+  uint16_t visActY;
+  int8_t   tempLayer;
+  uint8_t  scType;
+  uint8_t  flags;        // bit 0: isIntra, bit 1: isStartOfIntra, bit 2: isStartOfGop
+  uint8_t  reserved[ 7 ];
+};
+
+static_assert( sizeof( RCStatsFileHeader ) == 88, "unexpected padding in rate control statistics file header" );
+static_assert( sizeof( RCStatsFileRecord ) == 48, "unexpected padding in rate control statistics file record" );
+
+#ifdef VVENC_ENABLE_THIRDPARTY_JSON
+static bool isJsonStatsFileName( const std::string& name )
+{
+  const std::string ext = ".json";
+  return name.length() >= ext.length() && name.compare( name.length() - ext.length(), ext.length(), ext ) == 0;
+}
+#endif
+
 //sequence level
 EncRCSeq::EncRCSeq()
 {
@@ -92,11 +146,10 @@ void EncRCSeq::create( bool twoPassRC, bool lookAhead, int targetBitrate, int ma
   destroy();
   twoPass             = twoPassRC;
   isLookAhead         = lookAhead;
-  targetRate          = std::min( INT32_MAX / 3, targetBitrate );
-  maxGopRate          = int( 0.5 + std::min( (double) INT32_MAX, (double) std::min( 3 * targetRate, maxBitrate ) * GOPSize / frRate ) ); // 1.5x-3x is the valid range
   frameRate           = frRate;
   intraPeriod         = Clip3<unsigned>( GOPSize, 4 * VVENC_MAX_GOP, intraPer );
   gopSize             = GOPSize;
+  setTargetRate( targetBitrate, maxBitrate );
   firstPassData       = firstPassStats;
   bitDepth            = bitDpth;
 
@@ -112,6 +165,12 @@ void EncRCSeq::create( bool twoPassRC, bool lookAhead, int targetBitrate, int ma
   std::memset (targetBitCnt, 0, sizeof (targetBitCnt));
 }
 
+void EncRCSeq::setTargetRate( int targetBitrate, int maxBitrate )
+{
+  targetRate          = std::min( INT32_MAX / 3, targetBitrate );
+  maxGopRate          = int( 0.5 + std::min( (double) INT32_MAX, (double) std::min( 3 * targetRate, maxBitrate ) * gopSize / frameRate ) ); // 1.5x-3x is the valid range
+}
+
 void EncRCSeq::destroy()
 {
   return;
@@ -165,6 +224,31 @@ void EncRCPic::addToPictureList( std::list<EncRCPic*>& listPreviousPictures )
   listPreviousPictures.push_back( this );
 }
 
+void EncRCPic::storeState( CheckpointStream& stream ) const
+{
+  stream.write( targetBits );
+  stream.write( tmpTargetBits );
+  stream.write( poc );
+  stream.write( refreshParams );
+  stream.write( visActSteady );
+  stream.write( frameLevel );
+  stream.write( picQP );
+  stream.write( picBits );
+}
+
+void EncRCPic::restoreState( CheckpointStream& stream, EncRCSeq* encRcSeq )
+{
+  encRCSeq = encRcSeq;
+  stream.read( targetBits );
+  stream.read( tmpTargetBits );
+  stream.read( poc );
+  stream.read( refreshParams );
+  stream.read( visActSteady );
+  stream.read( frameLevel );
+  stream.read( picQP );
+  stream.read( picBits );
+}
+
 void EncRCPic::create( EncRCSeq* encRcSeq, int frameLvl, int framePoc )
 {
   destroy();
@@ -283,9 +367,9 @@ RateCtrl::RateCtrl(MsgLog& logger)
   flushPOC             = -1;
   rcPass               = 0;
   rcIsFinalPass        = true;
-#ifdef VVENC_ENABLE_THIRDPARTY_JSON
+  m_rcStatsBinary      = true;
+  m_rcStatsNumRecords  = 0;
   m_pqpaStatsWritten   = 0;
-#endif
   m_numPicStatsTotal   = 0;
   m_numPicAddedToList  = 0;
   m_updateNoisePoc     = -1;
@@ -316,13 +400,7 @@ void RateCtrl::destroy()
     delete p;
   }
 
-#ifdef VVENC_ENABLE_THIRDPARTY_JSON
-  if ( m_rcStatsFHandle.is_open() )
-  {
-    m_rcStatsFHandle.close();
-  }
-  m_pqpaStatsWritten = 0;
-#endif
+  closeStatsFile();
 }
 
 void RateCtrl::init( const VVEncCfg& encCfg )
@@ -336,6 +414,12 @@ void RateCtrl::init( const VVEncCfg& encCfg )
                     m_pcEncCfg->m_IntraPeriod, m_pcEncCfg->m_GOPSize, m_pcEncCfg->m_internalBitDepth[CH_L], getFirstPassStats() );
 }
 
+void RateCtrl::updateTargetRate( int targetBitrate, int maxBitrate )
+{
+  // the bit budget of the following look-ahead chunks is derived from the new rate, bits already spent are kept
+  encRCSeq->setTargetRate( targetBitrate, maxBitrate );
+}
+
 int RateCtrl::getBaseQP()
 {
   // estimate near-optimal base QP for PPS in second RC pass
@@ -388,8 +472,7 @@ void RateCtrl::setRCPass(const VVEncCfg& encCfg, const int pass, const char* sta
   rcPass        = pass;
   rcIsFinalPass = (pass >= m_pcEncCfg->m_RCNumPasses - 1);
 
-#ifdef VVENC_ENABLE_THIRDPARTY_JSON
-  if( m_rcStatsFHandle.is_open() ) m_rcStatsFHandle.close();
+  closeStatsFile();
 
   const std::string name = statsFName != nullptr ? statsFName : "";
   if( name.length() )
@@ -397,12 +480,18 @@ void RateCtrl::setRCPass(const VVEncCfg& encCfg, const int pass, const char* sta
     openStatsFile( name );
     if( rcIsFinalPass )
     {
-      readStatsFile();
+      if( m_rcStatsBinary )
+      {
+        readStatsFileBinary();
+      }
+#ifdef VVENC_ENABLE_THIRDPARTY_JSON
+      else
+      {
+        readStatsFile();
+      }
+#endif
     }
   }
-#else
-  CHECK( statsFName != nullptr && strlen( statsFName ) > 0, "reading/writing rate control statistics file not supported, please compile with json enabled" );
-#endif
 
   if (rcIsFinalPass && (encCfg.m_FirstPassMode > 2))
   {
@@ -410,23 +499,152 @@ void RateCtrl::setRCPass(const VVEncCfg& encCfg, const int pass, const char* sta
   }
 }
 
-#ifdef VVENC_ENABLE_THIRDPARTY_JSON
 void RateCtrl::openStatsFile(const std::string& name)
 {
   if( rcIsFinalPass )
   {
-    m_rcStatsFHandle.open( name, std::ios::in );
+    m_rcStatsFHandle.open( name, std::ios::in | std::ios::binary );
     CHECK( m_rcStatsFHandle.fail(), "unable to open rate control statistics file for reading" );
-    readStatsHeader();
+    // the format is detected from the file content
+    char magic[ sizeof( RC_STATS_MAGIC ) ] = { 0 };
+    m_rcStatsFHandle.read( magic, sizeof( magic ) );
+    m_rcStatsFHandle.clear();
+    m_rcStatsFHandle.seekg( 0, std::ios::beg );
+    m_rcStatsBinary = std::equal( magic, magic + sizeof( magic ), RC_STATS_MAGIC );
+#ifdef VVENC_ENABLE_THIRDPARTY_JSON
+    if( ! m_rcStatsBinary )
+    {
+      readStatsHeader();
+    }
+#else
+    CHECK( ! m_rcStatsBinary, "rate control statistics file not recognized, reading of json statistics files requires json support" );
+#endif
   }
   else
   {
-    m_rcStatsFHandle.open( name, std::ios::trunc | std::ios::out );
+    // json output is written for file names with .json extension, if supported
+#ifdef VVENC_ENABLE_THIRDPARTY_JSON
+    m_rcStatsBinary = ! isJsonStatsFileName( name );
+#else
+    m_rcStatsBinary = true;
+#endif
+    m_rcStatsFHandle.open( name, m_rcStatsBinary ? std::ios::trunc | std::ios::out | std::ios::binary : std::ios::trunc | std::ios::out );
     CHECK( m_rcStatsFHandle.fail(), "unable to open rate control statistics file for writing" );
-    writeStatsHeader();
+    if( m_rcStatsBinary )
+    {
+      writeStatsHeaderBinary();
+    }
+#ifdef VVENC_ENABLE_THIRDPARTY_JSON
+    else
+    {
+      writeStatsHeader();
+    }
+#endif
   }
 }
 
+void RateCtrl::closeStatsFile()
+{
+  if( m_rcStatsFHandle.is_open() )
+  {
+    if( m_rcStatsBinary && ! rcIsFinalPass && m_rcStatsFHandle.good() )
+    {
+      // append the intra PQPA statistics and complete the header
+      if( m_pqpaStatsWritten > 0 )
+      {
+        m_rcStatsFHandle.write( (const char*) m_listRCIntraPQPAStats.data(), m_pqpaStatsWritten );
+      }
+      const uint32_t counts[ 2 ] = { (uint32_t) m_rcStatsNumRecords, (uint32_t) m_pqpaStatsWritten };
+      m_rcStatsFHandle.seekp( offsetof( RCStatsFileHeader, numRecords ), std::ios::beg );
+      m_rcStatsFHandle.write( (const char*) counts, sizeof( counts ) );
+      CHECK( ! m_rcStatsFHandle.good(), "unable to write to rate control statistics file" );
+    }
+    m_rcStatsFHandle.close();
+  }
+  m_pqpaStatsWritten = 0;
+}
+
+void RateCtrl::writeStatsHeaderBinary()
+{
+  RCStatsFileHeader header;
+  memset( &header, 0, sizeof( header ) );
+  std::copy( RC_STATS_MAGIC, RC_STATS_MAGIC + sizeof( RC_STATS_MAGIC ), header.magic );
+  header.formatVersion = RC_STATS_FORMAT_VERSION;
+  header.headerSize    = sizeof( RCStatsFileHeader );
+  header.recordSize    = sizeof( RCStatsFileRecord );
+  strncpy( header.encVersion, VVENC_VERSION, sizeof( header.encVersion ) - 1 );
+  header.sourceWidth   = m_pcEncCfg->m_SourceWidth;
+  header.sourceHeight  = m_pcEncCfg->m_SourceHeight;
+  header.ctuSize       = m_pcEncCfg->m_CTUSize;
+  header.gopSize       = m_pcEncCfg->m_GOPSize;
+  header.intraPeriod   = m_pcEncCfg->m_IntraPeriod;
+  header.qp            = m_pcEncCfg->m_QP;
+  header.rcInitialQP   = m_pcEncCfg->m_RCInitialQP;
+  header.pqpa          = m_pcEncCfg->m_usePerceptQPA ? 1 : 0;
+  m_rcStatsFHandle.write( (const char*) &header, sizeof( header ) );
+  m_rcStatsNumRecords = 0;
+}
+
+void RateCtrl::readStatsFileBinary()
+{
+  CHECK( ! m_rcStatsFHandle.good(), "unable to read from rate control statistics file" );
+
+  // read the whole file at once, the records are parsed in place
+  m_rcStatsFHandle.seekg( 0, std::ios::end );
+  const size_t fileSize = (size_t) m_rcStatsFHandle.tellg();
+  m_rcStatsFHandle.seekg( 0, std::ios::beg );
+  CHECK( fileSize < sizeof( RCStatsFileHeader ), "unable to read header from rate control statistics file" );
+  std::vector<uint8_t> fileData( fileSize );
+  m_rcStatsFHandle.read( (char*) fileData.data(), fileSize );
+  CHECK( m_rcStatsFHandle.fail(), "unable to read from rate control statistics file" );
+
+  RCStatsFileHeader header;
+  memcpy( &header, fileData.data(), sizeof( header ) );
+  if( header.formatVersion != RC_STATS_FORMAT_VERSION || header.headerSize != sizeof( RCStatsFileHeader ) || header.recordSize != sizeof( RCStatsFileRecord ) )
+  {
+    THROW( "header in rate control statistics file not recognized" );
+  }
+  CHECK( fileSize != header.headerSize + (size_t) header.numRecords * header.recordSize + header.numPqpaStats, "rate control statistics file is incomplete" );
+
+  header.encVersion[ sizeof( header.encVersion ) - 1 ] = 0;
+  if( strcmp( header.encVersion, VVENC_VERSION ) )           msg.log( VVENC_WARNING, "WARNING: wrong version in rate control statistics file\n" );
+  if( header.sourceWidth  != m_pcEncCfg->m_SourceWidth )  msg.log( VVENC_WARNING, "WARNING: wrong frame width in rate control statistics file\n" );
+  if( header.sourceHeight != m_pcEncCfg->m_SourceHeight ) msg.log( VVENC_WARNING, "WARNING: wrong frame height in rate control statistics file\n" );
+  if( header.ctuSize      != m_pcEncCfg->m_CTUSize )      msg.log( VVENC_WARNING, "WARNING: wrong CTU size in rate control statistics file\n" );
+  if( header.gopSize      != m_pcEncCfg->m_GOPSize )      msg.log( VVENC_WARNING, "WARNING: wrong GOP size in rate control statistics file\n" );
+  if( header.intraPeriod  != m_pcEncCfg->m_IntraPeriod )  msg.log( VVENC_WARNING, "WARNING: wrong intra period in rate control statistics file\n" );
+
+  uint8_t minNoiseLevels[ QPA_MAX_NOISE_LEVELS ];
+  std::fill_n( minNoiseLevels, QPA_MAX_NOISE_LEVELS, 255u );
+
+  const uint8_t* recData = fileData.data() + header.headerSize;
+  for( uint32_t i = 0; i < header.numRecords; i++, recData += header.recordSize )
+  {
+    RCStatsFileRecord rec;
+    memcpy( &rec, recData, sizeof( rec ) );
+    CHECK( rec.scType > SCT_TL0_SCENE_CUT, "scene type in rate control statistics file not recognized" );
+    m_listRCFirstPassStats.push_back( TRCPassStats( rec.poc,
+                                                    rec.qp,
+                                                    rec.lambda,
+                                                    rec.visActY,
+                                                    rec.numBits,
+                                                    rec.psnrY,
+                                                    ( rec.flags & 1 ) != 0,
+                                                    rec.tempLayer,
+                                                    ( rec.flags & 2 ) != 0,
+                                                    ( rec.flags & 4 ) != 0,
+                                                    rec.gopNum,
+                                                    (SceneType) rec.scType,
+                                                    rec.spVisAct,
+                                                    0, // motionEstError
+                                                    minNoiseLevels
+                                                    ) );
+  }
+  m_listRCIntraPQPAStats.insert( m_listRCIntraPQPAStats.end(), recData, recData + header.numPqpaStats );
+}
+
+#ifdef VVENC_ENABLE_THIRDPARTY_JSON
+
 void RateCtrl::writeStatsHeader()
 {
   nlohmann::json header = {
@@ -497,6 +715,31 @@ void RateCtrl::storeStatsData( TRCPassStats statsData )
       statsData.psnrY     = srcData.psnrY;
     }
   }
+
+  if( m_rcStatsFHandle.is_open() && m_rcStatsBinary )
+  {
+    CHECK( ! m_rcStatsFHandle.good(), "unable to write to rate control statistics file" );
+    RCStatsFileRecord rec;
+    memset( &rec, 0, sizeof( rec ) );
+    rec.lambda    = statsData.lambda;
+    rec.psnrY     = statsData.psnrY;
+    rec.poc       = statsData.poc;
+    rec.qp        = statsData.qp;
+    rec.numBits   = statsData.numBits;
+    rec.gopNum    = statsData.gopNum;
+    rec.spVisAct  = m_pcEncCfg->m_FirstPassMode > 2 ? statsData.spVisAct : 0;
+    rec.visActY   = statsData.visActY;
+    rec.tempLayer = (int8_t) statsData.tempLayer;
+    rec.scType    = (uint8_t) statsData.scType;
+    rec.flags     = ( statsData.isIntra ? 1 : 0 ) | ( statsData.isStartOfIntra ? 2 : 0 ) | ( statsData.isStartOfGop ? 4 : 0 );
+    m_rcStatsFHandle.write( (const char*) &rec, sizeof( rec ) );
+    // the intra PQPA statistics gathered so far are appended when the file is closed
+    m_pqpaStatsWritten = (int) m_listRCIntraPQPAStats.size();
+    m_rcStatsNumRecords++;
+    m_numPicStatsTotal++;
+    return;
+  }
+
 #ifdef VVENC_ENABLE_THIRDPARTY_JSON
   nlohmann::json data = {
     { "poc",            statsData.poc },
@@ -1172,6 +1415,84 @@ void RateCtrl::updateAfterPicEncRC( const Picture* pic )
   }
 }
 
+void RateCtrl::storeState( CheckpointStream& stream ) const
+{
+  stream.write( flushPOC );
+  stream.writeRange( m_listRCFirstPassStats );
+  stream.writeRange( m_listRCIntraPQPAStats );
+  stream.write( m_minNoiseLevels );
+
+  stream.write<bool>( encRCSeq != NULL );
+  if( encRCSeq )
+  {
+    stream.write( encRCSeq->isIntraGOP );
+    stream.write( encRCSeq->isRateSavingMode );
+    stream.write( encRCSeq->targetRate );
+    stream.write( encRCSeq->maxGopRate );
+    stream.write( encRCSeq->scRelax );
+    stream.write( encRCSeq->bitsUsed );
+    stream.write( encRCSeq->bitsUsedQPLimDiff );
+    stream.write( encRCSeq->estimatedBitUsage );
+    stream.write( encRCSeq->rateBoostFac );
+    stream.write( encRCSeq->qpCorrection );
+    stream.write( encRCSeq->actualBitCnt );
+    stream.write( encRCSeq->targetBitCnt );
+    stream.write( encRCSeq->lastAverageQP );
+    stream.write( encRCSeq->lastIntraQP );
+    stream.write( encRCSeq->lastIntraSM );
+    stream.writeRange( encRCSeq->firstPassData );
+  }
+
+  stream.write<uint32_t>( (uint32_t) m_listRCPictures.size() );
+  for( auto encRcPic : m_listRCPictures )
+  {
+    encRcPic->storeState( stream );
+  }
+}
+
+void RateCtrl::restoreState( CheckpointStream& stream )
+{
+  stream.read( flushPOC );
+  stream.readRange( m_listRCFirstPassStats );
+  stream.readRange( m_listRCIntraPQPAStats );
+  stream.read( m_minNoiseLevels );
+
+  const bool hasSeq = stream.read<bool>();
+  CHECK( hasSeq != ( encRCSeq != NULL ), "rate control state in checkpoint does not match the configuration" );
+  if( hasSeq )
+  {
+    stream.read( encRCSeq->isIntraGOP );
+    stream.read( encRCSeq->isRateSavingMode );
+    stream.read( encRCSeq->targetRate );
+    stream.read( encRCSeq->maxGopRate );
+    stream.read( encRCSeq->scRelax );
+    stream.read( encRCSeq->bitsUsed );
+    stream.read( encRCSeq->bitsUsedQPLimDiff );
+    stream.read( encRCSeq->estimatedBitUsage );
+    stream.read( encRCSeq->rateBoostFac );
+    stream.read( encRCSeq->qpCorrection );
+    stream.read( encRCSeq->actualBitCnt );
+    stream.read( encRCSeq->targetBitCnt );
+    stream.read( encRCSeq->lastAverageQP );
+    stream.read( encRCSeq->lastIntraQP );
+    stream.read( encRCSeq->lastIntraSM );
+    stream.readRange( encRCSeq->firstPassData );
+  }
+
+  while( m_listRCPictures.size() > 0 )
+  {
+    delete m_listRCPictures.front();
+    m_listRCPictures.pop_front();
+  }
+  const uint32_t numPics = stream.read<uint32_t>();
+  for( uint32_t i = 0; i < numPics; i++ )
+  {
+    EncRCPic* encRcPic = new EncRCPic;
+    encRcPic->restoreState( stream, encRCSeq );
+    m_listRCPictures.push_back( encRcPic );
+  }
+}
+
 void RateCtrl::initRateControlPic( Picture& pic, Slice* slice, int& qp, double& finalLambda )
 {
   const int frameLevel = ( slice->isIntra() ? 0 : slice->TLayer + 1 );
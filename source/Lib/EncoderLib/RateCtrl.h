@@ -60,6 +60,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 namespace vvenc {
   struct Picture;
+  class CheckpointStream;
 
   struct TRCPassStats
   {
@@ -106,6 +107,7 @@ namespace vvenc {
 
     void create( bool twoPassRC, bool lookAhead, int targetBitrate, int maxBitrate, double frRate, int intraPer, int GOPSize, int bitDpth, std::list<TRCPassStats> &firstPassStats );
     void destroy();
+    void setTargetRate( int targetBitrate, int maxBitrate );
     void updateAfterPic (const int actBits, const int tgtBits);
 
     bool            twoPass;
@@ -145,6 +147,8 @@ namespace vvenc {
     void   clipTargetQP (std::list<EncRCPic*>& listPreviousPictures, const int baseQP, const int refrIncrFac, const int maxTL, const double resRatio, int &qp, int* qpAvg);
     void   updateAfterPicture (const int picActualBits, const int averageQP);
     void   addToPictureList( std::list<EncRCPic*>& listPreviousPictures );
+    void   storeState      ( CheckpointStream& stream ) const;
+    void   restoreState    ( CheckpointStream& stream, EncRCSeq* encRcSeq );
 
     int     targetBits;
     int     tmpTargetBits;
@@ -174,9 +178,12 @@ namespace vvenc {
                          const bool isStartOfIntra, const bool isStartOfGop, const int gopNum, const SceneType scType,
                          int spVisAct, const uint16_t motEstError, const uint8_t minNoiseLevels[QPA_MAX_NOISE_LEVELS] );
     void setRCRateSavingState( const int maxRate );
+    void updateTargetRate( int targetBitrate, int maxBitrate );
     void processFirstPassData( const bool flush, const int poc = -1 );
     void updateAfterPicEncRC( const Picture* pic );
     void initRateControlPic( Picture& pic, Slice* slice, int& qp, double& finalLambda );
+    void storeState        ( CheckpointStream& stream ) const;
+    void restoreState      ( CheckpointStream& stream );
 
     std::list<EncRCPic*>&    getPicList()        { return m_listRCPictures; }
     std::list<TRCPassStats>& getFirstPassStats() { return m_listRCFirstPassStats; }
@@ -203,8 +210,11 @@ namespace vvenc {
     void updateMotionErrStatsGop( const bool flush, const int poc );
     double getLookAheadBoostFac ( const int thresholdDivisor );
     double updateQPstartModelVal();
-#ifdef VVENC_ENABLE_THIRDPARTY_JSON
     void openStatsFile( const std::string& name );
+    void closeStatsFile();
+    void writeStatsHeaderBinary();
+    void readStatsFileBinary();
+#ifdef VVENC_ENABLE_THIRDPARTY_JSON
     void writeStatsHeader();
     void readStatsHeader();
     void readStatsFile();
@@ -215,10 +225,10 @@ namespace vvenc {
     std::list<TRCPassStats> m_listRCFirstPassStats;
     std::list<TRCPassStats> m_firstPassCache;
     std::vector<uint8_t>    m_listRCIntraPQPAStats;
-#ifdef VVENC_ENABLE_THIRDPARTY_JSON
     std::fstream            m_rcStatsFHandle;
+    bool                    m_rcStatsBinary;
+    int                     m_rcStatsNumRecords;
     int                     m_pqpaStatsWritten;
-#endif
     int                     m_numPicStatsTotal;
     int                     m_numPicAddedToList;
     int                     m_updateNoisePoc;
@@ -0,0 +1,279 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+
+
+/** \file     Renditions.cpp
+    \brief    feeds resampled renditions of the analysed input pictures to additional encoders
+*/
+
+
+#include "Renditions.h"
+#include "CommonLib/Picture.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+// scales a value by num / den, rounded to the nearest integer
+static inline int scaleRounded( const int val, const int num, const int den )
+{
+  const int64_t n = ( int64_t ) val * num;
+  return ( int ) ( n >= 0 ? ( n + ( den >> 1 ) ) / den : -( ( -n + ( den >> 1 ) ) / den ) );
+}
+
+
+Renditions::Renditions()
+  : m_encCfg( nullptr )
+{
+}
+
+
+Renditions::~Renditions()
+{
+  // the rendition encoders have been destroyed before, so the pictures are not referenced anymore
+  for( auto& rendition : m_renditions )
+  {
+    for( auto picShared : rendition.picSharedList )
+    {
+      delete picShared;
+    }
+  }
+}
+
+
+void Renditions::init( const VVEncCfg& encCfg )
+{
+  m_encCfg = &encCfg;
+  m_renditions.clear();
+}
+
+
+void Renditions::addRendition( const VVEncCfg& encCfg, EncStage* encoder )
+{
+  CHECK( encCfg.m_GOPSize != m_encCfg->m_GOPSize, "Renditions: coding structure differs from the main encoder" );
+
+  m_renditions.push_back( Rendition() );
+  Rendition& rendition = m_renditions.back();
+  rendition.encCfg     = &encCfg;
+  rendition.encoder    = encoder;
+  rendition.resampler.init( encCfg.m_internChromaFormat, Size( m_encCfg->m_SourceWidth, m_encCfg->m_SourceHeight ), Size( encCfg.m_SourceWidth, encCfg.m_SourceHeight ), encCfg.m_internalBitDepth[ CH_L ], m_encCfg->m_renditionFilter );
+}
+
+
+void Renditions::initPicture( Picture* pic )
+{
+}
+
+
+void Renditions::processPictures( const PicList& picList, AccessUnitList& auList, PicList& doneList, PicList& freeList )
+{
+  // the pictures arrive in display order with their pre-analysis finished, each rendition gets a resampled copy
+  for( auto pic : picList )
+  {
+    PicShared* src = pic->m_picShared;
+    for( auto& rendition : m_renditions )
+    {
+      PicShared* dst = xGetFreePicShared( rendition );
+      dst->reuseResampled( *src, rendition.resampler );
+      xScaleVisAct    ( rendition, src, dst );
+      xMapBimQpOffsets( rendition, src, dst );
+      xMapMvHints     ( rendition, src, dst );
+      xMapPrevShared  ( rendition, src, dst );
+      rendition.encoder->addPicSorted( dst, pic->isFlush );
+    }
+    doneList.push_back( pic );
+    freeList.push_back( pic );
+  }
+}
+
+
+PicShared* Renditions::xGetFreePicShared( Rendition& rendition )
+{
+  for( auto picShared : rendition.picSharedList )
+  {
+    if( ! picShared->isUsed() )
+    {
+      return picShared;
+    }
+  }
+
+  // the input of the main encoder is limited, the pool only grows if a rendition encoder lags behind
+  const VVEncCfg& encCfg = *rendition.encCfg;
+  PicShared* picShared   = new PicShared();
+  picShared->create( encCfg.m_framesToBeEncoded, encCfg.m_internChromaFormat, Size( encCfg.m_PadSourceWidth, encCfg.m_PadSourceHeight ), encCfg.m_vvencMCTF.MCTF || encCfg.m_usePerceptQPA, encCfg.m_numaAware );
+  rendition.picSharedList.push_back( picShared );
+  return picShared;
+}
+
+
+void Renditions::xMapPrevShared( Rendition& rendition, const PicShared* src, PicShared* dst ) const
+{
+  for( int i = 0; i < NUM_QPA_PREV_FRAMES; i++ )
+  {
+    const PicShared* prev = src->m_prevShared[ i ];
+    if( prev == src )
+    {
+      dst->m_prevShared[ i ] = dst;
+      continue;
+    }
+    for( auto& entry : rendition.recent )
+    {
+      // the source pictures are recycled, so the POC has to match as well
+      if( prev && entry.first == prev && entry.second->getPOC() == prev->getPOC() )
+      {
+        dst->m_prevShared[ i ] = entry.second;
+      }
+    }
+  }
+
+  // keep the last pictures until they can not be referenced as previous pictures anymore
+  dst->incUsed();
+  rendition.recent.push_back( std::make_pair( src, dst ) );
+  if( (int)rendition.recent.size() > NUM_QPA_PREV_FRAMES )
+  {
+    rendition.recent.front().second->decUsed();
+    rendition.recent.pop_front();
+  }
+}
+
+
+void Renditions::xScaleVisAct( const Rendition& rendition, const PicShared* src, PicShared* dst ) const
+{
+  // the activities are mean high-pass magnitudes, which grow about linearly with the downscaling factor
+  PicVisAct& picVA = dst->m_picVA;
+  const int  num   = m_encCfg->m_SourceWidth;
+  const int  den   = rendition.encCfg->m_SourceWidth;
+  for( int ch = 0; ch < MAX_NUM_CH; ch++ )
+  {
+    picVA.spatAct       [ ch ] = (uint16_t) std::min( 4095, scaleRounded( src->m_picVA.spatAct       [ ch ], num, den ) );
+    picVA.prevTL0spatAct[ ch ] = (uint16_t) std::min( 4095, scaleRounded( src->m_picVA.prevTL0spatAct[ ch ], num, den ) );
+  }
+  picVA.visAct    = (uint16_t) std::min( 65535, scaleRounded( src->m_picVA.visAct,    num, den ) );
+  picVA.visActTL0 = (uint16_t) std::min( 65535, scaleRounded( src->m_picVA.visActTL0, num, den ) );
+}
+
+
+void Renditions::xMapBimQpOffsets( const Rendition& rendition, const PicShared* src, PicShared* dst ) const
+{
+  const std::vector<int>& srcOffsets = src->m_ctuBimQpOffset;
+  if( srcOffsets.empty() )
+  {
+    return;
+  }
+
+  const int srcCtuSize      = m_encCfg->m_bimCtuSize;
+  const int srcWidthInCtus  = ( m_encCfg->m_PadSourceWidth  + srcCtuSize - 1 ) / srcCtuSize;
+  const int srcHeightInCtus = ( m_encCfg->m_PadSourceHeight + srcCtuSize - 1 ) / srcCtuSize;
+  CHECK( (int)srcOffsets.size() != srcWidthInCtus * srcHeightInCtus, "Renditions: unexpected number of CTU QP offsets" );
+
+  // each rendition CTU gets the rounded average offset of the source CTUs it covers
+  const VVEncCfg& encCfg    = *rendition.encCfg;
+  const int srcWidth        = m_encCfg->m_SourceWidth;
+  const int srcHeight       = m_encCfg->m_SourceHeight;
+  const int ctuSize         = encCfg.m_bimCtuSize;
+  const int widthInCtus     = ( encCfg.m_PadSourceWidth  + ctuSize - 1 ) / ctuSize;
+  const int heightInCtus    = ( encCfg.m_PadSourceHeight + ctuSize - 1 ) / ctuSize;
+  std::vector<int>& offsets = dst->m_ctuBimQpOffset;
+  offsets.resize( widthInCtus * heightInCtus );
+  for( int y = 0; y < heightInCtus; y++ )
+  {
+    const int y0 = std::min(   (   y       * ctuSize * srcHeight                                      / encCfg.m_SourceHeight )       / srcCtuSize, srcHeightInCtus - 1 );
+    const int y1 = std::min( ( ( ( y + 1 ) * ctuSize * srcHeight + encCfg.m_SourceHeight - 1 ) / encCfg.m_SourceHeight - 1 ) / srcCtuSize, srcHeightInCtus - 1 );
+    for( int x = 0; x < widthInCtus; x++ )
+    {
+      const int x0 = std::min(   (   x       * ctuSize * srcWidth                                     / encCfg.m_SourceWidth )       / srcCtuSize, srcWidthInCtus - 1 );
+      const int x1 = std::min( ( ( ( x + 1 ) * ctuSize * srcWidth + encCfg.m_SourceWidth - 1 ) / encCfg.m_SourceWidth - 1 ) / srcCtuSize, srcWidthInCtus - 1 );
+      int sum = 0;
+      for( int sy = y0; sy <= y1; sy++ )
+      {
+        for( int sx = x0; sx <= x1; sx++ )
+        {
+          sum += srcOffsets[ sy * srcWidthInCtus + sx ];
+        }
+      }
+      const int num = ( y1 - y0 + 1 ) * ( x1 - x0 + 1 );
+      offsets[ y * widthInCtus + x ] = ( sum + ( sum < 0 ? -( num >> 1 ) : num >> 1 ) ) / num;
+    }
+  }
+}
+
+
+void Renditions::xMapMvHints( const Rendition& rendition, const PicShared* src, PicShared* dst ) const
+{
+  const int blkSize = src->m_mvHintBlkSize;
+  if( src->m_mvHints.empty() || blkSize <= 0 )
+  {
+    return;
+  }
+
+  // same block size in the rendition, sampled at the block centers and with downscaled vectors
+  const VVEncCfg& encCfg = *rendition.encCfg;
+  const int srcWidth     = m_encCfg->m_SourceWidth;
+  const int srcHeight    = m_encCfg->m_SourceHeight;
+  const int width        = ( encCfg.m_PadSourceWidth  + blkSize - 1 ) / blkSize;
+  const int height       = ( encCfg.m_PadSourceHeight + blkSize - 1 ) / blkSize;
+  for( const auto& srcField : src->m_mvHints )
+  {
+    dst->m_mvHints.push_back( MvHintField() );
+    MvHintField& field = dst->m_mvHints.back();
+    field.pocOffset    = srcField.pocOffset;
+    field.width        = width;
+    field.height       = height;
+    field.mvs.resize( width * height );
+    for( int y = 0; y < height; y++ )
+    {
+      const int sy = std::min( ( y * blkSize + ( blkSize >> 1 ) ) * srcHeight / encCfg.m_SourceHeight / blkSize, srcField.height - 1 );
+      for( int x = 0; x < width; x++ )
+      {
+        const int sx = std::min( ( x * blkSize + ( blkSize >> 1 ) ) * srcWidth / encCfg.m_SourceWidth / blkSize, srcField.width - 1 );
+        const Mv& mv = srcField.mvs[ sy * srcField.width + sx ];
+        field.mvs[ y * width + x ] = Mv( scaleRounded( mv.hor, encCfg.m_SourceWidth, srcWidth ), scaleRounded( mv.ver, encCfg.m_SourceHeight, srcHeight ) );
+      }
+    }
+  }
+}
+
+} // namespace vvenc
+
+//! \}
+
@@ -637,34 +637,45 @@ void FGAnalyzer::init ( const int width,
                         const int *outputBitDepths,
                         const bool doAnalysis[] )
 {
-  m_log2ScaleFactor = 2;
+  initDefaultModel( m_log2ScaleFactor, m_compModel );
   for (int i = 0; i < ComponentID::MAX_NUM_COMP; i++)
   {
-    m_compModel[i].presentFlag           = true;
-    m_compModel[i].numModelValues        = 3;
-    m_compModel[i].numIntensityIntervals = 1;
-    m_compModel[i].intensityValues.resize(VVENC_MAX_NUM_INTENSITIES);
-    for ( int j = 0; j < VVENC_MAX_NUM_INTENSITIES; j++ )
-    {
-      m_compModel[i].intensityValues[j].intensityIntervalLowerBound = 10;
-      m_compModel[i].intensityValues[j].intensityIntervalUpperBound = 250;
-      m_compModel[i].intensityValues[j].compModelValue.resize( MAX_ALLOWED_MODEL_VALUES );
-      for ( int k = 0; k < m_compModel[i].numModelValues; k++ )
-      {
-        // half intensity for chroma. Provided value is default value, manually tuned.
-        m_compModel[i].intensityValues[j].compModelValue[k] = i == 0 ? 26 : 13;
-      }
-    }
     m_doAnalysis[i] = doAnalysis[i];
   }
 
   // initialize picture parameters and create buffers
   m_bitDepths                   = const_cast<int*>( outputBitDepths );
   m_inputChromaFormat           = inputChroma;
+
+  // split the window columns of each component into tiles, every window gets its own DCT block
+  int N = 0;
+  m_tiles.clear();
+  for ( int compIdx = 0; compIdx < getNumberValidComponents( inputChroma ); compIdx++ )
+  {
+    const ComponentID compID  = ComponentID( compIdx );
+    const int         compW   = width  >> getComponentScaleX( compID, inputChroma );
+    const int         compH   = height >> getComponentScaleY( compID, inputChroma );
+    const int         numCols = compW / DATA_BASE_SIZE;
+    const int         numRows = compH / DATA_BASE_SIZE;
+    m_compBlockOffset[compIdx] = N;
+    for ( int col = 0; col < numCols; col += TILE_WINDOW_COLS )
+    {
+      AnalysisTile tile;
+      tile.compID     = compID;
+      tile.startX     = col * DATA_BASE_SIZE;
+      tile.endX       = std::min( col + TILE_WINDOW_COLS, numCols ) * DATA_BASE_SIZE;
+      tile.firstBlock = N + col * numRows;
+      tile.numBlocks  = 0;
+      tile.dctInout   = ( TCoeff* ) xMalloc( TCoeff, DATA_BASE_SIZE * DATA_BASE_SIZE );
+      tile.dctTemp    = ( TCoeff* ) xMalloc( TCoeff, DATA_BASE_SIZE * DATA_BASE_SIZE );
+      m_tiles.push_back( tile );
+    }
+    N += numCols * numRows;
+  }
+
   // Allocate memory for m_coeffBuf and m_dctGrainBlockList
-  m_coeffBuf = (TCoeff*)xMalloc( TCoeff, width * height );
-  int N = (width * height) / (DATA_BASE_SIZE * DATA_BASE_SIZE);
-  m_dctGrainBlockList = new CoeffBuf[N];
+  m_coeffBuf = (TCoeff*)xMalloc( TCoeff, std::max( N, 1 ) * DATA_BASE_SIZE * DATA_BASE_SIZE );
+  m_dctGrainBlockList = new CoeffBuf[std::max( N, 1 )];
 
   std::fill( std::begin(vecMean), std::end(vecMean), 0 );
   std::fill( std::begin(vecVar), std::end(vecVar), 0 );
@@ -750,15 +761,31 @@ void FGAnalyzer::init ( const int width,
                              0, margin,
                              0, false );
   }
-  if ( !m_DCTinout )
-  {
-    m_DCTinout = ( TCoeff* ) xMalloc( TCoeff, DATA_BASE_SIZE * DATA_BASE_SIZE );
-  }
-  if ( !m_DCTtemp )
+}
+
+// default parameters, used until the first successful estimation
+void FGAnalyzer::initDefaultModel ( int& log2ScaleFactor,
+                                    SeiFgc::CompModel compModel[] )
+{
+  log2ScaleFactor = 2;
+  for (int i = 0; i < ComponentID::MAX_NUM_COMP; i++)
   {
-    m_DCTtemp = ( TCoeff* ) xMalloc( TCoeff, DATA_BASE_SIZE * DATA_BASE_SIZE );
+    compModel[i].presentFlag           = true;
+    compModel[i].numModelValues        = 3;
+    compModel[i].numIntensityIntervals = 1;
+    compModel[i].intensityValues.resize(VVENC_MAX_NUM_INTENSITIES);
+    for ( int j = 0; j < VVENC_MAX_NUM_INTENSITIES; j++ )
+    {
+      compModel[i].intensityValues[j].intensityIntervalLowerBound = 10;
+      compModel[i].intensityValues[j].intensityIntervalUpperBound = 250;
+      compModel[i].intensityValues[j].compModelValue.resize( MAX_ALLOWED_MODEL_VALUES );
+      for ( int k = 0; k < compModel[i].numModelValues; k++ )
+      {
+        // half intensity for chroma. Provided value is default value, manually tuned.
+        compModel[i].intensityValues[j].compModelValue[k] = i == 0 ? 26 : 13;
+      }
+    }
   }
-
 }
 
 // delete picture buffers
@@ -809,18 +836,15 @@ void FGAnalyzer::destroy()
     delete m_maskUpsampled;
     m_maskUpsampled = nullptr;
   }
-  if ( m_DCTinout )
+  for ( auto& tile : m_tiles )
   {
-    xFree( m_DCTinout );
-    m_DCTinout = nullptr;
-  }
-  if ( m_DCTtemp )
-  {
-    xFree( m_DCTtemp );
-    m_DCTtemp = nullptr;
+    xFree( tile.dctInout );
+    xFree( tile.dctTemp );
   }
+  m_tiles.clear();
 
   xFree ( m_coeffBuf );
+  m_coeffBuf = nullptr;
 
   if ( m_dctGrainBlockList )
   {
@@ -1071,43 +1095,147 @@ void FGAnalyzer::combineMasks( ComponentID compId )
 // estimate cut-off frequencies and scaling factors for different intensity intervals
 void FGAnalyzer::estimateGrainParameters ( Picture *pic )
 {
-  m_originalBuf = &pic->getOrigBuffer();                                   // original frame
-  m_workingBuf = &pic->getFilteredOrigBuffer();                            // mctf filtered frame
+  initAnalysis ( pic->getOrigBuffer(),
+                 pic->getFilteredOrigBuffer() );
+  for ( int tileIdx = 0; tileIdx < getNumTiles(); tileIdx++ )
+  {
+    analyseTile ( tileIdx );
+  }
+  finishAnalysis ();
+}
+
+// generate the mask and the film grain estimate of the whole picture, both are read by all tiles
+void FGAnalyzer::initAnalysis ( const PelStorage& orig,
+                                const PelStorage& filtered )
+{
+  m_originalBuf = &orig;                                                    // original frame
+  m_workingBuf = &filtered;                                                 // mctf filtered frame
 
   // Determine blockSize dynamically based on the frame resolution
-  int blockSize = BLK_8;
   uint32_t picSizeInLumaSamples = m_workingBuf->Y().height * m_workingBuf->Y().width;
   if ( picSizeInLumaSamples >= 7680 * 4320 )
   {
     // 8K resolution
-    blockSize = BLK_32;
+    m_blockSize = BLK_32;
   }
   else if ( picSizeInLumaSamples >= 3840 * 2160 )
   {
     // 4K resolution
-    blockSize = BLK_16;
+    m_blockSize = BLK_16;
   }
   else
   {
-    blockSize = BLK_8;
+    m_blockSize = BLK_8;
   }
 
   findMask( COMP_Y );                                                       // Generate mask for luma only
 
   // find difference between original and filtered/reconstructed frame => film grain estimate
-  m_grainEstimateBuf->subtract( pic->getOrigBuffer(),
-                                pic->getFilteredOrigBuffer() );
+  m_grainEstimateBuf->subtract( orig,
+                                filtered );
+}
+
+// collect the DCT blocks and the data points of the flat windows in one tile
+void FGAnalyzer::analyseTile ( int tileIdx )
+{
+  AnalysisTile& tile         = m_tiles[tileIdx];
+  ComponentID   compID       = tile.compID;
+  int           height       = m_workingBuf->getBuf( compID ).height;       // Height of current frame
+  int           windowSize   = DATA_BASE_SIZE;                              // Size for Film Grain block
+  int           blockSize    = m_blockSize;
+  int           bitDepth     = m_bitDepths[toChannelType( compID )];
+  int           detect_edges = 0;
+  int           mean         = 0;
+  int           var          = 0;
+
+  tile.numBlocks = 0;
+  tile.mean.clear();
+  tile.var.clear();
+
+  for ( int i = tile.startX; i < tile.endX; i += windowSize )
+  { // loop over windowSize x windowSize blocks
+    for ( int j = 0; j <= height - windowSize; j += windowSize )
+    {
+      if ( compID == COMP_Y )
+      {
+        detect_edges = countEdges ( windowSize,
+                                    i,
+                                    j,
+                                    compID );  // for flat region without edges
+      }
+      else
+      {
+        detect_edges = 1;                      // always process for chroma
+      }
+      if ( detect_edges )   // selection of uniform, flat and low-complexity area; extend to other features, e.g., variance.
+      { // find transformed blocks; cut-off frequency estimation is done on 64 x 64 blocks as low-pass filtering on synthesis side is done on 64 x 64 blocks.
+        CoeffBuf& currentCoeffBuf = m_dctGrainBlockList[tile.firstBlock + tile.numBlocks++];
+        blockTransform ( currentCoeffBuf,
+                         tile.dctInout,
+                         tile.dctTemp,
+                         i,
+                         j,
+                         bitDepth,
+                         compID );
+      }
+
+      int step = windowSize / blockSize;
+      for ( int k = 0; k < step; k++ )
+      {
+        for ( int m = 0; m < step; m++ )
+        {
+          if ( compID == COMP_Y )
+          {
+            detect_edges = countEdges ( blockSize,
+                                        i + k * blockSize,
+                                        j + m * blockSize,
+                                        compID );   // for flat region without edges
+          }
+          else
+          {
+            detect_edges = 1;  // always process for chroma
+          }
+          if ( detect_edges )   // selection of uniform, flat and low-complexity area; extend to other features, e.g., variance.
+          {
+            // collect all data for parameter estimation; mean and variance are caluclated on blockSize x blockSize blocks
+            uint32_t stride = m_grainEstimateBuf->get( compID ).stride;
+            double varD = calcVar ( m_grainEstimateBuf->get( compID ).buf + ( ( j + m * blockSize ) * stride ) + i + ( k * blockSize ),
+                                    stride,
+                                    blockSize,
+                                    blockSize );
+            varD = varD / (( blockSize * blockSize ));
+            var = static_cast<int>( varD + 0.5 );
+            stride = m_workingBuf->get( compID ).stride;
+            mean = calcMean ( m_workingBuf->get( compID ).buf + ( ( j + m * blockSize ) * stride ) + i + ( k * blockSize ),
+                              stride,
+                              blockSize,
+                              blockSize );
+            mean = static_cast<int>(static_cast<double>( mean ) / ( blockSize * blockSize ) + 0.5 );
+
+            // regularize high variations; controls excessively fluctuating points
+            double tmp = 2.75 * pow( static_cast<double>( var ), 0.5 ) + 0.5;
+            var = static_cast<int>( tmp );
+            // limit data points to meaningful values. higher variance can be result of not perfect mask estimation (non-flat regions fall in estimation process)
+            if ( var < ( MAX_REAL_SCALE << ( bitDepth - BIT_DEPTH_8 ) ) )
+            {
+              tile.mean.push_back( mean );    // mean of the filtered frame
+              tile.var.push_back( var );      // variance of the film grain estimate
+            }
+          }
+        }
+      }
+    }
+  }
+}
 
+// gather the tile results in raster order of the windows and estimate the parameters of each component
+void FGAnalyzer::finishAnalysis ()
+{
   for ( int compIdx = 0; compIdx < getNumberValidComponents( m_inputChromaFormat ); compIdx++ )
   {
     ComponentID  compID          = ComponentID( compIdx );
-    uint32_t     width           = m_workingBuf->getBuf( compID ).width;    // Width of current frame
-    uint32_t     height          = m_workingBuf->getBuf( compID ).height;   // Height of current frame
-    uint32_t     windowSize      = DATA_BASE_SIZE;                          // Size for Film Grain block
     int          bitDepth        = m_bitDepths[toChannelType( compID )];
-    int          detect_edges    = 0;
-    int          mean            = 0;
-    int          var             = 0;
+    const int    blockOffset     = m_compBlockOffset[compIdx];
     m_numDctGrainBlocks          = 0;
 
     // Clear vectors before computing for each component
@@ -1119,77 +1247,19 @@ void FGAnalyzer::estimateGrainParameters ( Picture *pic )
     quantVec.clear();
     coeffs.clear();
 
-    for ( int i = 0; i <= width - windowSize; i += windowSize )
-    { // loop over windowSize x windowSize blocks
-      for ( int j = 0; j <= height - windowSize; j += windowSize )
+    for ( auto& tile : m_tiles )
+    {
+      if ( tile.compID != compID )
       {
-        if ( compID == COMP_Y )
-        {
-          detect_edges = countEdges ( windowSize,
-                                      i,
-                                      j,
-                                      compID );  // for flat region without edges
-        }
-        else
-        {
-          detect_edges = 1;                      // always process for chroma
-        }
-        if ( detect_edges )   // selection of uniform, flat and low-complexity area; extend to other features, e.g., variance.
-        { // find transformed blocks; cut-off frequency estimation is done on 64 x 64 blocks as low-pass filtering on synthesis side is done on 64 x 64 blocks.
-          CoeffBuf& currentCoeffBuf = m_dctGrainBlockList[m_numDctGrainBlocks++];
-          blockTransform ( currentCoeffBuf,
-                           i,
-                           j,
-                           bitDepth,
-                           compID );
-        }
-
-        int step = windowSize / blockSize;
-        for ( int k = 0; k < step; k++ )
-        {
-          for ( int m = 0; m < step; m++ )
-          {
-            if ( compID == COMP_Y )
-            {
-              detect_edges = countEdges ( blockSize,
-                                          i + k * blockSize,
-                                          j + m * blockSize,
-                                          compID );   // for flat region without edges
-            }
-            else
-            {
-              detect_edges = 1;  // always process for chroma
-            }
-            if ( detect_edges )   // selection of uniform, flat and low-complexity area; extend to other features, e.g., variance.
-            {
-              // collect all data for parameter estimation; mean and variance are caluclated on blockSize x blockSize blocks
-              uint32_t stride = m_grainEstimateBuf->get( compID ).stride;
-              double varD = calcVar ( m_grainEstimateBuf->get( compID ).buf + ( ( j + m * blockSize ) * stride ) + i + ( k * blockSize ),
-                                      stride,
-                                      blockSize,
-                                      blockSize );
-              varD = varD / (( blockSize * blockSize ));
-              var = static_cast<int>( varD + 0.5 );
-              stride = m_workingBuf->get( compID ).stride;
-              mean = calcMean ( m_workingBuf->get( compID ).buf + ( ( j + m * blockSize ) * stride ) + i + ( k * blockSize ),
-                                stride,
-                                blockSize,
-                                blockSize );
-              mean = static_cast<int>(static_cast<double>( mean ) / ( blockSize * blockSize ) + 0.5 );
-
-              // regularize high variations; controls excessively fluctuating points
-              double tmp = 2.75 * pow( static_cast<double>( var ), 0.5 ) + 0.5;
-              var = static_cast<int>( tmp ); 
-              // limit data points to meaningful values. higher variance can be result of not perfect mask estimation (non-flat regions fall in estimation process)
-              if ( var < ( MAX_REAL_SCALE << ( bitDepth - BIT_DEPTH_8 ) ) )
-              {
-                vecMean.push_back( mean );    // mean of the filtered frame
-                vecVar.push_back( var );      // variance of the film grain estimate
-              }
-            }
-          }
-        }
+        continue;
+      }
+      // close the gaps between the tiles, only the buffer views are exchanged
+      for ( int k = 0; k < tile.numBlocks; k++ )
+      {
+        std::swap( m_dctGrainBlockList[blockOffset + m_numDctGrainBlocks++], m_dctGrainBlockList[tile.firstBlock + k] );
       }
+      vecMean.insert( vecMean.end(), tile.mean.begin(), tile.mean.end() );
+      vecVar.insert( vecVar.end(), tile.var.begin(), tile.var.end() );
     }
 
     // calculate film grain parameters
@@ -1313,7 +1383,7 @@ void FGAnalyzer::estimateCutoffFreqAdaptive( ComponentID compId )
     {
       for ( int i = 0; i < m_numDctGrainBlocks; i++ )
       {
-        meanSquaredDctGrain[x][y] += m_dctGrainBlockList[i].at( x, y );
+        meanSquaredDctGrain[x][y] += m_dctGrainBlockList[m_compBlockOffset[compId] + i].at( x, y );
       }
       meanSquaredDctGrain[x][y] /= m_numDctGrainBlocks;
     }
@@ -1376,6 +1446,8 @@ void FGAnalyzer::estimateCutoffFreqAdaptive( ComponentID compId )
 
 // DCT-2 64x64 as defined in VVC
 void FGAnalyzer::blockTransform ( CoeffBuf &currentCoeffBuf,
+                                  TCoeff* dctInout,
+                                  TCoeff* dctTemp,
                                   int offsetX,
                                   int offsetY,
                                   uint32_t bitDepth,
@@ -1389,19 +1461,19 @@ void FGAnalyzer::blockTransform ( CoeffBuf &currentCoeffBuf,
   {
     for ( uint32_t x = 0; x < DATA_BASE_SIZE; x++ )
     {
-      m_DCTinout[x + DATA_BASE_SIZE * y] = m_grainEstimateBuf->get( compId ).at( offsetX + x,
+      dctInout[x + DATA_BASE_SIZE * y] = m_grainEstimateBuf->get( compId ).at( offsetX + x,
                                                                                  offsetY + y );
     }
   }
 
-  fastForwardDCT2_B64 ( m_DCTinout,
-                        m_DCTtemp,
+  fastForwardDCT2_B64 ( dctInout,
+                        dctTemp,
                         transform_scale,
                         windowSize,
                         0,
                         0 );
-  fastForwardDCT2_B64 ( m_DCTtemp,
-                        m_DCTinout,
+  fastForwardDCT2_B64 ( dctTemp,
+                        dctInout,
                         transform_scale,
                         windowSize,
                         0,
@@ -1412,7 +1484,7 @@ void FGAnalyzer::blockTransform ( CoeffBuf &currentCoeffBuf,
   {
     for ( int x = 0; x < DATA_BASE_SIZE; x++ )
     {
-      currentCoeffBuf.at( x, y ) = m_DCTinout[x + DATA_BASE_SIZE * y] * m_DCTinout[x + DATA_BASE_SIZE * y];
+      currentCoeffBuf.at( x, y ) = dctInout[x + DATA_BASE_SIZE * y] * dctInout[x + DATA_BASE_SIZE * y];
     }
   }
 }
@@ -180,8 +180,6 @@ public:
   FGAnalyzer( bool enableOpt = true );
   ~FGAnalyzer();
 
-  int                             prevAnalysisPoc                = -1;
-
   void init( const int                        width,
              const int                        height,
              const ChromaFormat               inputChroma,
@@ -191,6 +189,17 @@ public:
 
   void estimateGrainParameters ( Picture* pic );
 
+  // the estimation split into steps for asynchronous processing: the picture wide mask, the independent
+  // tiles of 64-sample window columns, which may run concurrently, and the final parameter estimation
+  void initAnalysis   ( const PelStorage& orig,
+                        const PelStorage& filtered );
+  int  getNumTiles    () const { return (int)m_tiles.size(); }
+  void analyseTile    ( int tileIdx );
+  void finishAnalysis ();
+
+  static void initDefaultModel ( int& log2ScaleFactor,
+                                 SeiFgc::CompModel compModel[] );
+
   int getLog2scaleFactor()  { return m_log2ScaleFactor; };
 
   SeiFgc::CompModel  getCompModel( int idx ) { return m_compModel[idx];  };
@@ -221,8 +230,27 @@ private:
   Morph                           m_morphOperation;
   double                          m_lowIntensityRatio            = 0.1;           // supress everything below 0.1*maxIntensityOffset
 
-  CoeffBuf                        * m_dctGrainBlockList;
-  TCoeff                          * m_coeffBuf;
+  // window columns of one component, analysed independently of the other tiles
+  struct AnalysisTile
+  {
+    ComponentID                   compID;
+    int                           startX;
+    int                           endX;
+    int                           firstBlock;    // first entry of m_dctGrainBlockList reserved for the tile
+    int                           numBlocks;
+    std::vector<int>              mean;
+    std::vector<int>              var;
+    TCoeff                        * dctInout;
+    TCoeff                        * dctTemp;
+  };
+  static constexpr int            TILE_WINDOW_COLS              = 4;
+
+  std::vector<AnalysisTile>       m_tiles;
+  int                             m_blockSize;
+
+  CoeffBuf                        * m_dctGrainBlockList         = nullptr;
+  TCoeff                          * m_coeffBuf                  = nullptr;
+  int                             m_compBlockOffset[ComponentID::MAX_NUM_COMP];
   int                             m_numDctGrainBlocks;
 
   std::vector<double>             coeffs;
@@ -258,13 +286,11 @@ private:
   PelStorage                      *m_workingBufSubsampled4   = nullptr;
   PelStorage                      *m_maskSubsampled4         = nullptr;
   PelStorage                      *m_maskUpsampled           = nullptr;
-  // for DCT
-  TCoeff                          *m_DCTinout                = nullptr;
-  TCoeff                          *m_DCTtemp                 = nullptr;
-
   void findMask ( ComponentID compID );
 
   void blockTransform ( CoeffBuf& currentCoeffBuf,
+                        TCoeff* dctInout,
+                        TCoeff* dctTemp,
                         int offsetX,
                         int offsetY,
                         uint32_t bitDepth,
@@ -0,0 +1,133 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     ThreadBudgetCtrl.cpp
+    \brief    runtime control of the number of active worker threads
+*/
+
+
+#include "ThreadBudgetCtrl.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+// a worker is only removed if the frame time expected without it stays below this fraction of the deadline
+static const double THREAD_BUDGET_REMOVE_MARGIN = 0.85;
+
+ThreadBudgetCtrl::ThreadBudgetCtrl()
+  : m_adaptive      ( false )
+  , m_maxThreads    ( 0 )
+  , m_evalFrames    ( 0 )
+  , m_frameDeadline ( 0.0 )
+  , m_budget        ( 0 )
+  , m_numActive     ( 0 )
+  , m_encTime       ( 0.0 )
+  , m_numFrames     ( 0 )
+{
+}
+
+void ThreadBudgetCtrl::init( const VVEncCfg& encCfg )
+{
+  m_adaptive      = encCfg.m_adaptiveThreads && encCfg.m_numThreads > 1;
+  m_maxThreads    = std::max( 1, encCfg.m_numThreads );
+  // give the frame parallel pipeline time to settle after each change
+  m_evalFrames    = std::max( 8, 2 * encCfg.m_maxParallelFrames );
+  m_frameDeadline = (double) encCfg.m_FrameScale / encCfg.m_FrameRate;
+  m_budget        = m_maxThreads;
+  m_numActive     = m_maxThreads;
+  m_encTime       = 0.0;
+  m_numFrames     = 0;
+}
+
+void ThreadBudgetCtrl::setBudget( int numThreads )
+{
+  m_budget = numThreads <= 0 ? m_maxThreads : std::min( numThreads, m_maxThreads );
+}
+
+bool ThreadBudgetCtrl::update( double encTime, int numFrames )
+{
+  const int budget = m_budget;
+  int numActive    = m_numActive;
+
+  if( m_adaptive )
+  {
+    m_encTime   += encTime;
+    m_numFrames += numFrames;
+
+    if( m_numFrames >= m_evalFrames )
+    {
+      const double frameTime = m_encTime / m_numFrames;
+      if( frameTime > m_frameDeadline )
+      {
+        // behind real-time, grow proportionally to the number of active workers
+        numActive += std::max( 1, numActive / 4 );
+      }
+      else if( numActive > 1 && frameTime * numActive / ( numActive - 1 ) < m_frameDeadline * THREAD_BUDGET_REMOVE_MARGIN )
+      {
+        numActive -= 1;
+      }
+      m_encTime   = 0.0;
+      m_numFrames = 0;
+    }
+  }
+  else
+  {
+    numActive = budget;
+  }
+
+  numActive = std::max( 1, std::min( numActive, budget ) );
+  if( numActive == m_numActive )
+  {
+    return false;
+  }
+
+  m_numActive = numActive;
+  m_encTime   = 0.0;
+  m_numFrames = 0;
+  return true;
+}
+
+} // namespace vvenc
+
+//! \}
+
@@ -0,0 +1,90 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     ThreadBudgetCtrl.h
+    \brief    runtime control of the number of active worker threads (header)
+*/
+
+
+#pragma once
+
+#include "CommonLib/CommonDef.h"
+
+#include <atomic>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+// ====================================================================================================================
+
+// limits the active worker threads to a CPU budget given at runtime. In adaptive mode the number of active threads
+// follows the measured encoding time per frame: workers are added while the encoder misses the real-time deadline
+// and removed while the remaining workers are expected to still meet it.
+class ThreadBudgetCtrl
+{
+  private:
+    bool            m_adaptive;
+    int             m_maxThreads;
+    int             m_evalFrames;
+    double          m_frameDeadline;     // real-time duration of one frame in seconds
+    std::atomic_int m_budget;
+    int             m_numActive;
+    double          m_encTime;
+    int             m_numFrames;
+
+  public:
+    ThreadBudgetCtrl();
+
+    void init              ( const VVEncCfg& encCfg );
+    void setBudget         ( int numThreads );
+    int  getBudget         () const { return m_budget; }
+    int  getNumActive      () const { return m_numActive; }
+
+    // add the time spent encoding the given number of output frames, returns true if the number of active threads changed
+    bool update            ( double encTime, int numFrames );
+};
+
+} // namespace vvenc
+
+//! \}
+
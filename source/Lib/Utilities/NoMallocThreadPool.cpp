@@ -46,6 +46,7 @@ POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "NoMallocThreadPool.h"
+#include "NumaHelper.h"
 
 #ifdef HAVE_PTHREADS
 #  include <pthread.h>
@@ -62,6 +63,10 @@ namespace vvenc {
 thread_local std::unique_ptr<TProfiler> ptls;
 #endif
 
+// pool and thread id of the current worker thread, used to put new tasks into the local queue of the adding thread
+static thread_local const NoMallocThreadPool* tls_pool     = nullptr;
+static thread_local int                       tls_threadId = -1;
+
 NoMallocThreadPool::NoMallocThreadPool( int numThreads, const char * threadPoolName, const VVEncCfg* encCfg )
   : m_poolName( threadPoolName )
 {
@@ -70,6 +75,22 @@ NoMallocThreadPool::NoMallocThreadPool( int numThreads, const char * threadPoolN
     numThreads = std::thread::hardware_concurrency();
   }
 
+  m_workStealing = encCfg && encCfg->m_tpWorkStealing && numThreads > 1;
+  if( m_workStealing )
+  {
+    for( int i = 0; i < numThreads; ++i )
+    {
+      m_localQueues.emplace_back( new LocalTaskQueue );
+    }
+  }
+
+  if( encCfg && encCfg->m_numaAware && numThreads > 1 && NumaHelper::getNumNodes() > 1 )
+  {
+    m_numaThreads = numThreads;
+  }
+
+  m_numActiveThreads = numThreads;
+
   for( int i = 0; i < numThreads; ++i )
   {
     m_threads.emplace_back( &NoMallocThreadPool::threadProc, this, i, *encCfg );
@@ -79,10 +100,27 @@ NoMallocThreadPool::NoMallocThreadPool( int numThreads, const char * threadPoolN
 NoMallocThreadPool::~NoMallocThreadPool()
 {
   m_exitThreads = true;
+  wakeParkedThreads();
 
   waitForThreads();
 }
 
+void NoMallocThreadPool::setNumActiveThreads( int numActiveThreads )
+{
+  // keep at least one worker active, otherwise the pending tasks would never be processed
+  numActiveThreads = std::max( 1, std::min( numActiveThreads, numThreads() ) );
+
+  std::unique_lock<std::mutex> l( m_activeMutex );
+  m_numActiveThreads = numActiveThreads;
+  m_activeCond.notify_all();
+}
+
+void NoMallocThreadPool::wakeParkedThreads()
+{
+  std::unique_lock<std::mutex> l( m_activeMutex );
+  m_activeCond.notify_all();
+}
+
 bool NoMallocThreadPool::processTasksOnMainThread()
 {
   CHECK( m_threads.size() != 0, "should not be used with multiple threads" );
@@ -125,6 +163,7 @@ bool NoMallocThreadPool::processTasksOnMainThread()
 void NoMallocThreadPool::shutdown( bool block )
 {
   m_exitThreads = true;
+  wakeParkedThreads();
   if( block )
   {
     waitForThreads();
@@ -158,11 +197,45 @@ void NoMallocThreadPool::threadProc( int threadId, const VVEncCfg& encCfg )
   }
 #endif
 
-  auto nextTaskIt = m_tasks.begin();
-  while( !m_exitThreads )
+  if( m_numaThreads )
   {
+    // contiguous blocks of worker threads share one node
+    NumaHelper::bindThreadToNode( NumaHelper::getNodeForThread( threadId, m_numaThreads ) );
+  }
+
+  tls_pool     = this;
+  tls_threadId = threadId;
+
+  uint32_t rngState   = 0x9E3779B9u * ( threadId + 1 );
+  auto     nextTaskIt = m_tasks.begin();
+  auto     findTask   = [&]() -> Slot*
+  {
+    if( m_workStealing )
+    {
+      return stealTask( threadId, rngState );
+    }
     auto taskIt = findNextTask( threadId, nextTaskIt );
     if( !taskIt.isValid() )
+    {
+      return nullptr;
+    }
+    nextTaskIt = taskIt;
+    nextTaskIt.incWrap();
+    return &*taskIt;
+  };
+
+  while( !m_exitThreads )
+  {
+    if( threadId >= m_numActiveThreads.load( std::memory_order_relaxed ) )
+    {
+      // parked worker: tasks already queued for this thread are stolen by the active workers
+      std::unique_lock<std::mutex> l( m_activeMutex );
+      m_activeCond.wait( l, [&]() { return m_exitThreads || threadId < m_numActiveThreads.load( std::memory_order_relaxed ); } );
+      continue;
+    }
+
+    Slot* task = findTask();
+    if( !task )
     {
       std::unique_lock<std::mutex> l( m_idleMutex, std::defer_lock );
 
@@ -171,8 +244,8 @@ void NoMallocThreadPool::threadProc( int threadId, const VVEncCfg& encCfg )
       const auto startWait = std::chrono::steady_clock::now();
       while( !m_exitThreads )
       {
-        taskIt = findNextTask( threadId, nextTaskIt );
-        if( taskIt.isValid() || m_exitThreads )
+        task = findTask();
+        if( task || m_exitThreads || threadId >= m_numActiveThreads.load( std::memory_order_relaxed ) )
         {
           break;
         }
@@ -198,11 +271,15 @@ void NoMallocThreadPool::threadProc( int threadId, const VVEncCfg& encCfg )
     {
       return;
     }
+    if( !task )
+    {
+      continue;
+    }
 
-    processTask( threadId, *taskIt );
-
-    nextTaskIt = taskIt;
-    nextTaskIt.incWrap();
+    if( !processTask( threadId, *task ) && m_workStealing )
+    {
+      m_localQueues[threadId]->push( task );
+    }
   }
 }
 
@@ -215,37 +292,106 @@ NoMallocThreadPool::TaskIterator NoMallocThreadPool::findNextTask( int threadId,
   bool first = true;
   for( auto it = startSearch; it != startSearch || first; it.incWrap() )
   {
-#if ENABLE_VALGRIND_CODE
-    MutexLock lock( m_extraMutex );
-#endif
-
     first = false;
 
-    Slot& t = *it;
-    auto expected = WAITING;
-    if( t.state.load( std::memory_order_relaxed ) == WAITING && t.state.compare_exchange_strong( expected, RUNNING ) )
+    if( claimTask( threadId, *it ) )
     {
-      if( !t.barriers.empty() )
+      return it;
+    }
+  }
+  return {};
+}
+
+NoMallocThreadPool::Slot* NoMallocThreadPool::stealTask( int threadId, uint32_t& rngState )
+{
+  // try the own queue first, checking each queued task at most once
+  LocalTaskQueue& localQueue = *m_localQueues[threadId];
+  for( size_t n = localQueue.size(); n > 0; n-- )
+  {
+    Slot* task = localQueue.pop();
+    if( !task )
+    {
+      break;
+    }
+    if( claimTask( threadId, *task ) )
+    {
+      return task;
+    }
+    localQueue.push( task );
+  }
+
+  // then steal from the other threads, starting with a random victim
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+
+  const int numQueues = (int) m_localQueues.size();
+  const int start     = (int) ( rngState % numQueues );
+  for( int i = 0; i < numQueues; i++ )
+  {
+    const int victimId = ( start + i ) % numQueues;
+    if( victimId == threadId )
+    {
+      continue;
+    }
+
+    LocalTaskQueue& victimQueue = *m_localQueues[victimId];
+    for( size_t n = victimQueue.size(); n > 0; n-- )
+    {
+      Slot* task = victimQueue.pop();
+      if( !task )
       {
-        if( std::any_of( t.barriers.cbegin(), t.barriers.cend(), []( const Barrier* b ) { return b && b->isBlocked(); } ) )
-        {
-          // reschedule
-          t.state.store( WAITING );
-          continue;
-        }
-        t.barriers.clear();   // clear barriers, so we don't need to check them on the next try (we assume they won't get locked again)
+        break;
       }
-      if( t.readyCheck && t.readyCheck( threadId, t.param ) == false )
+      if( claimTask( threadId, *task ) )
+      {
+        return task;
+      }
+      // not ready, give it back to the victim
+      victimQueue.push( task );
+    }
+  }
+
+  return nullptr;
+}
+
+bool NoMallocThreadPool::claimTask( int threadId, Slot& t )
+{
+#if ENABLE_VALGRIND_CODE
+  MutexLock lock( m_extraMutex );
+#endif
+
+  auto expected = WAITING;
+  if( t.state.load( std::memory_order_relaxed ) == WAITING && t.state.compare_exchange_strong( expected, RUNNING ) )
+  {
+    if( !t.barriers.empty() )
+    {
+      if( std::any_of( t.barriers.cbegin(), t.barriers.cend(), []( const Barrier* b ) { return b && b->isBlocked(); } ) )
       {
         // reschedule
         t.state.store( WAITING );
-        continue;
+        return false;
       }
-
-      return it;
+      t.barriers.clear();   // clear barriers, so we don't need to check them on the next try (we assume they won't get locked again)
+    }
+    if( t.readyCheck && t.readyCheck( threadId, t.param ) == false )
+    {
+      // reschedule
+      t.state.store( WAITING );
+      return false;
     }
+
+    return true;
   }
-  return {};
+  return false;
+}
+
+void NoMallocThreadPool::pushLocalTask( Slot& task )
+{
+  // tasks added by a worker go to its own queue, tasks added by other threads are distributed round robin
+  const int queueIdx = tls_pool == this ? tls_threadId
+                                        : (int) ( m_nextLocalQueue.fetch_add( 1, std::memory_order_relaxed ) % m_localQueues.size() );
+  m_localQueues[queueIdx]->push( &task );
 }
 
 bool NoMallocThreadPool::processTask( int threadId, NoMallocThreadPool::Slot& task )
@@ -51,6 +51,9 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <atomic>
 #include <chrono>
 #include <array>
+#include <vector>
+#include <memory>
+#include <algorithm>
 
 #ifdef HAVE_PTHREADS
 #include <pthread.h>
@@ -459,6 +462,11 @@ public:
           t.barriers   = std::move( barriers );
           t.state      = WAITING;
 
+          if( m_workStealing )
+          {
+            pushLocalTask( t );
+          }
+
 #if ADD_TASK_THREAD_SAFE
           l.lock();
 #endif
@@ -481,6 +489,10 @@ public:
   void waitForThreads();
 
   int numThreads() const { return (int)m_threads.size(); }
+
+  // limit the number of workers processing tasks, the remaining workers are parked until they get activated again
+  void setNumActiveThreads( int numActiveThreads );
+  int  numActiveThreads() const { return m_numActiveThreads.load( std::memory_order_relaxed ); }
 #if ENABLE_TIME_PROFILING_MT_MODE
   const std::vector< TProfiler* >& getProfilers() { return profilers; }
 #endif
@@ -518,6 +530,54 @@ private:
 
   using TaskIterator = ChunkedTaskQueue::Iterator;
 
+  // per-thread queue of waiting task slots for the work stealing mode (ring buffer, only grows if it runs full)
+  class LocalTaskQueue
+  {
+    constexpr static size_t InitSize = 256;
+
+  public:
+    LocalTaskQueue() : m_ring( InitSize, nullptr ) {}
+
+    LocalTaskQueue( const LocalTaskQueue& ) = delete;
+    LocalTaskQueue( LocalTaskQueue&& )      = delete;
+
+    void push( Slot* slot )
+    {
+      std::unique_lock<std::mutex> l( m_mutex );
+      const size_t size = m_size.load( std::memory_order_relaxed );
+      if( size == m_ring.size() )
+      {
+        std::rotate( m_ring.begin(), m_ring.begin() + m_head, m_ring.end() );
+        m_ring.resize( 2 * size, nullptr );
+        m_head = 0;
+      }
+      m_ring[( m_head + size ) % m_ring.size()] = slot;
+      m_size.store( size + 1, std::memory_order_relaxed );
+    }
+
+    Slot* pop()
+    {
+      std::unique_lock<std::mutex> l( m_mutex );
+      const size_t size = m_size.load( std::memory_order_relaxed );
+      if( size == 0 )
+      {
+        return nullptr;
+      }
+      Slot* slot = m_ring[m_head];
+      m_head     = ( m_head + 1 ) % m_ring.size();
+      m_size.store( size - 1, std::memory_order_relaxed );
+      return slot;
+    }
+
+    size_t size() const { return m_size.load( std::memory_order_relaxed ); }
+
+  private:
+    std::vector<Slot*>  m_ring;
+    size_t              m_head = 0;
+    std::atomic<size_t> m_size{ 0 };
+    std::mutex          m_mutex;
+  };
+
   // members
   std::string              m_poolName;
   std::atomic_bool         m_exitThreads{ false };
@@ -529,6 +589,14 @@ private:
 #endif
   std::mutex               m_idleMutex;
   std::atomic_uint         m_waitingThreads{ 0 };
+  bool                     m_workStealing = false;
+  std::vector<std::unique_ptr<LocalTaskQueue>>
+                           m_localQueues;
+  std::atomic_uint         m_nextLocalQueue{ 0 };
+  int                      m_numaThreads = 0;
+  std::atomic_int          m_numActiveThreads{ 0 };
+  std::mutex               m_activeMutex;
+  std::condition_variable  m_activeCond;
 #if ENABLE_VALGRIND_CODE
   std::mutex               m_extraMutex;
 #endif
@@ -539,7 +607,11 @@ private:
   // internal functions
   void         threadProc  ( int threadId, const VVEncCfg& encCfg );
   TaskIterator findNextTask( int threadId, TaskIterator startSearch );
+  Slot*        stealTask   ( int threadId, uint32_t& rngState );
+  bool         claimTask   ( int threadId, Slot& task );
   bool         processTask ( int threadId, Slot& task );
+  void         pushLocalTask( Slot& task );
+  void         wakeParkedThreads();
 };
 
 } // namespace vvenc
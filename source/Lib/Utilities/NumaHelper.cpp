@@ -0,0 +1,232 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     NumaHelper.cpp
+    \brief    NUMA topology detection, thread placement and memory policy helpers
+*/
+
+#include "NumaHelper.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if defined( __linux__ )
+#  include <sched.h>
+#  include <unistd.h>
+#  include <sys/syscall.h>
+#endif
+
+//! \ingroup Utilities
+//! \{
+
+namespace vvenc {
+
+#if defined( __linux__ ) && defined( SYS_mbind ) && defined( SYS_set_mempolicy )
+// memory policy modes and flags from linux/mempolicy.h, to avoid a dependency on libnuma
+static constexpr int      VVENC_MPOL_DEFAULT    = 0;
+static constexpr int      VVENC_MPOL_PREFERRED  = 1;
+static constexpr int      VVENC_MPOL_INTERLEAVE = 3;
+static constexpr unsigned VVENC_MPOL_MF_MOVE    = 1 << 1;
+static constexpr int      VVENC_MAX_NUMA_NODES  = 64;
+#  define VVENC_NUMA_SUPPORT 1
+#else
+#  define VVENC_NUMA_SUPPORT 0
+#endif
+
+#if VVENC_NUMA_SUPPORT
+// parse a sysfs cpu list, e.g. "0-15,32-47"
+static std::vector<int> parseCpuList( const std::string& list )
+{
+  std::vector<int> cpus;
+  std::stringstream ss( list );
+  std::string range;
+  while( std::getline( ss, range, ',' ) )
+  {
+    if( range.empty() || range[0] == '\n' )
+    {
+      continue;
+    }
+    const size_t dash = range.find( '-' );
+    const int    first = std::stoi( range.substr( 0, dash ) );
+    const int    last  = dash == std::string::npos ? first : std::stoi( range.substr( dash + 1 ) );
+    for( int cpu = first; cpu <= last; cpu++ )
+    {
+      cpus.push_back( cpu );
+    }
+  }
+  return cpus;
+}
+#endif
+
+const NumaHelper::Topology& NumaHelper::getTopology()
+{
+  static const Topology topology = []
+  {
+    Topology topo;
+#if VVENC_NUMA_SUPPORT
+    for( int node = 0; node < VVENC_MAX_NUMA_NODES; node++ )
+    {
+      std::ifstream file( "/sys/devices/system/node/node" + std::to_string( node ) + "/cpulist" );
+      if( !file.is_open() )
+      {
+        continue;
+      }
+      std::string list;
+      std::getline( file, list );
+      try
+      {
+        std::vector<int> cpus = parseCpuList( list );
+        if( !cpus.empty() )
+        {
+          topo.nodeCpus.resize( node + 1 );
+          topo.nodeCpus[node] = std::move( cpus );
+        }
+      }
+      catch( ... )
+      {
+        // malformed cpu list, ignore this node
+      }
+    }
+#endif
+    return topo;
+  }();
+
+  return topology;
+}
+
+int NumaHelper::getNumNodes()
+{
+  const Topology& topo = getTopology();
+  return topo.nodeCpus.empty() ? 1 : (int) topo.nodeCpus.size();
+}
+
+int NumaHelper::getNodeForThread( int threadIdx, int numThreads )
+{
+  const int numNodes = getNumNodes();
+  if( numNodes <= 1 || numThreads <= 0 )
+  {
+    return 0;
+  }
+  return std::min( numNodes - 1, threadIdx * numNodes / numThreads );
+}
+
+bool NumaHelper::bindThreadToNode( int node )
+{
+#if VVENC_NUMA_SUPPORT
+  const Topology& topo = getTopology();
+  if( node < 0 || node >= (int) topo.nodeCpus.size() || topo.nodeCpus[node].empty() )
+  {
+    return false;
+  }
+
+  cpu_set_t cpuSet;
+  CPU_ZERO( &cpuSet );
+  for( int cpu : topo.nodeCpus[node] )
+  {
+    if( cpu < CPU_SETSIZE )
+    {
+      CPU_SET( cpu, &cpuSet );
+    }
+  }
+  return 0 == sched_setaffinity( 0, sizeof( cpuSet ), &cpuSet );
+#else
+  (void) node;
+  return false;
+#endif
+}
+
+void NumaHelper::setPreferredNode( int node )
+{
+#if VVENC_NUMA_SUPPORT
+  if( getNumNodes() <= 1 )
+  {
+    return;
+  }
+  if( node < 0 )
+  {
+    syscall( SYS_set_mempolicy, VVENC_MPOL_DEFAULT, nullptr, 0 );
+    return;
+  }
+  unsigned long nodeMask = 1ul << node;
+  syscall( SYS_set_mempolicy, VVENC_MPOL_PREFERRED, &nodeMask, (unsigned long) VVENC_MAX_NUMA_NODES + 1 );
+#else
+  (void) node;
+#endif
+}
+
+void NumaHelper::interleaveMemory( void* ptr, size_t size )
+{
+#if VVENC_NUMA_SUPPORT
+  const int numNodes = getNumNodes();
+  if( numNodes <= 1 || !ptr || !size )
+  {
+    return;
+  }
+
+  const Topology& topo     = getTopology();
+  unsigned long   nodeMask = 0;
+  for( int node = 0; node < numNodes; node++ )
+  {
+    if( !topo.nodeCpus[node].empty() )
+    {
+      nodeMask |= 1ul << node;
+    }
+  }
+
+  // mbind requires a page aligned start address
+  const uintptr_t pageSize = (uintptr_t) sysconf( _SC_PAGESIZE );
+  const uintptr_t start    = (uintptr_t) ptr & ~( pageSize - 1 );
+  const uintptr_t end      = (uintptr_t) ptr + size;
+  syscall( SYS_mbind, (void*) start, (unsigned long) ( end - start ), VVENC_MPOL_INTERLEAVE, &nodeMask,
+           (unsigned long) VVENC_MAX_NUMA_NODES + 1, VVENC_MPOL_MF_MOVE );
+#else
+  (void) ptr;
+  (void) size;
+#endif
+}
+
+} // namespace vvenc
+
+//! \}
+
@@ -0,0 +1,81 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/** \file     NumaHelper.h
+    \brief    NUMA topology detection, thread placement and memory policy helpers
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+//! \ingroup Utilities
+//! \{
+
+namespace vvenc {
+
+// ---------------------------------------------------------------------------
+// NUMA helpers (Linux only, no-ops on all other platforms or single node systems)
+// ---------------------------------------------------------------------------
+
+class NumaHelper
+{
+public:
+  static int  getNumNodes    ();                                  ///< number of NUMA nodes with CPUs (1 if unknown)
+  static int  getNodeForThread( int threadIdx, int numThreads );  ///< node for worker threadIdx, threads are split in contiguous blocks
+  static bool bindThreadToNode( int node );                       ///< restrict the calling thread to the CPUs of the given node
+  static void setPreferredNode( int node );                       ///< prefer the given node for memory first touched by the calling thread, node < 0 resets to default
+  static void interleaveMemory( void* ptr, size_t size );         ///< interleave (and migrate) the pages of the given memory range across all nodes
+
+private:
+  struct Topology
+  {
+    std::vector<std::vector<int>> nodeCpus;
+  };
+
+  static const Topology& getTopology();
+};
+
+} // namespace vvenc
+
+//! \}
+
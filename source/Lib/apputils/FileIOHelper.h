@@ -52,6 +52,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include <algorithm>
 #include <regex>
+#include <cstring>
 
 #include "vvenc/vvencCfg.h"
 #include "vvenc/vvenc.h"
@@ -60,6 +61,10 @@ POSSIBILITY OF SUCH DAMAGE.
 #if defined (_WIN32) || defined (WIN32) || defined (_WIN64) || defined (WIN64)
 #include <io.h>
 #include <fcntl.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
 #endif
 
 //! \ingroup Interface
@@ -294,6 +299,38 @@ public:
     return true;
   }
   
+  // bitstream file of an additional rendition: the rendition index is inserted before the file extension
+  static std::string getRenditionFileName( const std::string& fileName, int rendition )
+  {
+    const size_t extPos = fileName.find_last_of( "." );
+    const size_t dirPos = fileName.find_last_of( "/\\" );
+    const bool   hasExt = extPos != std::string::npos && ( dirPos == std::string::npos || extPos > dirPos );
+    return ( hasExt ? fileName.substr( 0, extPos ) : fileName ) + "_r" + std::to_string( rendition ) + ( hasExt ? fileName.substr( extPos ) : "" );
+  }
+
+  // discard the data of a file behind the given size (e.g. behind a checkpoint position)
+  static bool truncateFile( const std::string& fileName, int64_t size )
+  {
+    std::ifstream file( fileName, std::ios::binary | std::ios::ate );
+    if( ! file.is_open() || (int64_t)file.tellg() < size )
+    {
+      return false;
+    }
+    file.close();
+#if defined (_WIN32) || defined (WIN32) || defined (_WIN64) || defined (WIN64)
+    int fd = -1;
+    if( _sopen_s( &fd, fileName.c_str(), _O_RDWR | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE ) != 0 )
+    {
+      return false;
+    }
+    const bool ok = _chsize_s( fd, size ) == 0;
+    _close( fd );
+    return ok;
+#else
+    return ::truncate( fileName.c_str(), (off_t)size ) == 0;
+#endif
+  }
+
   static bool verifyYuvPlane( vvencYUVPlane& yuvPlane, const int bitDepth )
   {
     const int stride = yuvPlane.stride;
@@ -317,6 +354,54 @@ public:
     return true;
   }
   
+  // source of the file data, reads from a stream into the given line buffer
+  struct StreamSource
+  {
+    std::istream& fd;
+
+    const uint8_t* read( uint8_t* buf, size_t size )
+    {
+      fd.read( reinterpret_cast<char*>( buf ), size );
+      return ( fd.eof() || fd.fail() ) ? nullptr : buf;
+    }
+
+    bool skip( size_t size )
+    {
+      fd.seekg( size, std::ios::cur );
+      return ! ( fd.eof() || fd.fail() );
+    }
+  };
+
+  // source of the file data, returns pointers into a memory mapped file without copying
+  struct MemorySource
+  {
+    const uint8_t* cur = nullptr;
+    const uint8_t* end = nullptr;
+
+    const uint8_t* read( uint8_t*, size_t size )
+    {
+      if( (size_t)( end - cur ) < size )
+      {
+        cur = end;
+        return nullptr;
+      }
+      const uint8_t* buf = cur;
+      cur += size;
+      return buf;
+    }
+
+    bool skip( size_t size )
+    {
+      return read( nullptr, size ) != nullptr;
+    }
+  };
+
+  static bool isLittleEndian()
+  {
+    const uint16_t val = 1;
+    return *reinterpret_cast<const uint8_t*>( &val ) == 1;
+  }
+
   static bool readYuvPlane( std::istream&     fd,
                      vvencYUVPlane&           yuvPlane,
                      bool                     is16bit,
@@ -326,6 +411,34 @@ public:
                      const vvencChromaFormat& inputChFmt,
                      const vvencChromaFormat& internChFmt
                    )
+  {
+    StreamSource src{ fd };
+    return xReadYuvPlane( src, yuvPlane, is16bit, fileBitDepth, packedYUVInput, compID, inputChFmt, internChFmt );
+  }
+
+  static bool readYuvPlane( MemorySource&     src,
+                     vvencYUVPlane&           yuvPlane,
+                     bool                     is16bit,
+                     int                      fileBitDepth,
+                     int                      packedYUVInput,
+                     const int&               compID,
+                     const vvencChromaFormat& inputChFmt,
+                     const vvencChromaFormat& internChFmt
+                   )
+  {
+    return xReadYuvPlane( src, yuvPlane, is16bit, fileBitDepth, packedYUVInput, compID, inputChFmt, internChFmt );
+  }
+
+  template<typename Source>
+  static bool xReadYuvPlane( Source&          src,
+                     vvencYUVPlane&           yuvPlane,
+                     bool                     is16bit,
+                     int                      fileBitDepth,
+                     int                      packedYUVInput,
+                     const int&               compID,
+                     const vvencChromaFormat& inputChFmt,
+                     const vvencChromaFormat& internChFmt
+                   )
   {
     const int csx_file = ( (compID == 0) || (inputChFmt==VVENC_CHROMA_444) ) ? 0 : 1;
     const int csy_file = ( (compID == 0) || (inputChFmt!=VVENC_CHROMA_420) ) ? 0 : 1;
@@ -357,8 +470,7 @@ public:
   
       if ( inputChFmt != VVENC_CHROMA_400 )
       {
-        fd.seekg( fileHeight * fileStride, std::ios::cur );
-        if ( fd.eof() || fd.fail() )
+        if ( ! src.skip( fileHeight * fileStride ) )
         {
           return false;
         }
@@ -371,11 +483,9 @@ public:
   
       for( int y = 0; y < height; y++ )
       {
-        uint8_t *buf = &( bufVec[0] );
-  
         // read a new line
-        fd.read( reinterpret_cast<char*>( buf ), fileStride_packed );
-        if ( fd.eof() || fd.fail() )
+        const uint8_t *buf = src.read( &( bufVec[0] ), fileStride_packed );
+        if ( ! buf )
         {
           return false;
         }
@@ -402,7 +512,8 @@ public:
     else
     {
       std::vector<uint8_t> bufVec( fileStride );
-      uint8_t *buf = &( bufVec[0] );
+      const uint8_t *buf = nullptr;
+      const bool directCopy = is16bit && csx_file == csx_dest && isLittleEndian();
       const unsigned mask_y_file = ( 1 << csy_file ) - 1;
       const unsigned mask_y_dest = ( 1 << csy_dest ) - 1;
       for( int y444 = 0; y444 < ( height << csy_dest ); y444++ )
@@ -410,8 +521,8 @@ public:
         if ( ( y444 & mask_y_file ) == 0 )
         {
           // read a new line
-          fd.read( reinterpret_cast<char*>( buf ), fileStride );
-          if ( fd.eof() || fd.fail() )
+          buf = src.read( &( bufVec[0] ), fileStride );
+          if ( ! buf )
           {
             return false;
           }
@@ -420,7 +531,12 @@ public:
         if ( ( y444 & mask_y_dest ) == 0 )
         {
           // process current destination line
-          if ( csx_file < csx_dest )
+          if ( directCopy )
+          {
+            // 16-bit little endian file samples match the buffer layout
+            memcpy( dst, buf, width * sizeof( LPel ) );
+          }
+          else if ( csx_file < csx_dest )
           {
             // eg file is 444, dest is 422.
             const int sx = csx_dest - csx_file;
@@ -466,6 +466,8 @@ public:
   bool         m_packedYUVInput                = false;        ///< If true, packed 10-bit YUV ( 4 samples packed into 5-bytes consecutively )
   bool         m_packedYUVOutput               = false;        ///< If true, output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data
   bool         m_forceY4mInput                 = false;        ///< If true, y4m input file syntax is forced (only needed for input via std::cin)
+  bool         m_mmapInput                     = false;        ///< If true, the input file is memory mapped instead of read through a stream
+  int          m_inputReadAhead                = 0;            ///< number of input frames read ahead in a background thread (0: off)
   bool         m_showVersion                   = false;
   bool         m_showHelp                      = false;
   bool         m_printStats                    = true;
@@ -575,6 +577,9 @@ int parse( int argc, char* argv[], vvenc_config* c, std::ostream& rcOstr )
 
   IStreamToArr<int>                 toMCTFFrames                 ( &c->m_vvencMCTF.MCTFFrames[0], VVENC_MAX_MCTF_FRAMES, &c->m_vvencMCTF.numFrames );
   IStreamToArr<double>              toMCTFStrengths              ( &c->m_vvencMCTF.MCTFStrengths[0], VVENC_MAX_MCTF_FRAMES, &c->m_vvencMCTF.numStrength );
+  IStreamToArr<int>                 toRenditionWidth             ( &c->m_renditionWidth[0], VVENC_MAX_RENDITIONS, &c->m_numRenditions );
+  IStreamToArr<int>                 toRenditionHeight            ( &c->m_renditionHeight[0], VVENC_MAX_RENDITIONS );
+  IStreamToArr<int>                 toRenditionQP                ( &c->m_renditionQP[0], VVENC_MAX_RENDITIONS );
   IStreamToEnum<int>                toColourPrimaries            ( &c->m_colourPrimaries,        &ColourPrimariesToIntMap );
   IStreamToEnum<int>                toTransferCharacteristics    ( &c->m_transferCharacteristics,&TransferCharacteristicsToIntMap );
   IStreamToEnum<int>                toColourMatrix               ( &c->m_matrixCoefficients,     &ColourMatrixToIntMap );
@@ -587,6 +592,7 @@ int parse( int argc, char* argv[], vvenc_config* c, std::ostream& rcOstr )
   IStreamToArr<char>                toTraceFile                   ( &c->m_traceFile[0], VVENC_MAX_STRING_LEN  );
   IStreamToArr<char>                toSummaryOutFilename          ( &c->m_summaryOutFilename[0], VVENC_MAX_STRING_LEN  );
   IStreamToArr<char>                toSummaryPicFilenameBase      ( &c->m_summaryPicFilenameBase[0], VVENC_MAX_STRING_LEN  );
+  IStreamToArr<char>                toCheckpointFile              ( &c->m_checkpointFile[0], VVENC_MAX_STRING_LEN  );
 
   IStreamToFunc<int>                toSaoWithScc                  ( setSAO, this, c, &SaoToIntMap, 0 );
 
@@ -683,7 +689,7 @@ int parse( int argc, char* argv[], vvenc_config* c, std::ostream& rcOstr )
                                                                                                              "to specify as a multiple of target bitrate")
     ("passes,p",                                        c->m_RCNumPasses,                                    "number of encoding passes with rate control (1: single-pass, -1, 2: two-pass RC)")
     ("pass",                                            c->m_RCPass,                                         "rate control pass for two-pass rate control (-1: both, 1: first, 2: second pass)")
-    ("rcstatsfile",                                     m_RCStatsFileName,                                   "rate control statistics file name")
+    ("rcstatsfile",                                     m_RCStatsFileName,                                   "rate control statistics file name (binary format, json format for .json file names if supported)")
     ("qp,q",                                            c->m_QP,                                             "quantization parameter, QP (0, 1, .. 63)")
     ("qpa",                                             toQPA,                                               "enable perceptually motivated QP adaptation based on XPSNR model (0: off, 1: on)", true)
     ("threads,t",                                       c->m_numThreads,                                     "number of threads (multithreading; -1: resolution < 720p: 4, < 5K 2880p: 8, >= 5K 2880p: 12 threads)")
@@ -719,7 +725,7 @@ int parse( int argc, char* argv[], vvenc_config* c, std::ostream& rcOstr )
     ("Passes",                                          c->m_RCNumPasses,                                    "number of rate control passes (1,2)" )
     ("Pass",                                            c->m_RCPass,                                         "rate control pass for two-pass rate control (-1,1,2)" )
     ("LookAhead",                                       c->m_LookAhead,                                      "Enable pre-analysis pass with picture look-ahead (-1,0,1)")
-    ("RCStatsFile",                                     m_RCStatsFileName,                                   "rate control statistics file" )
+    ("RCStatsFile",                                     m_RCStatsFileName,                                   "rate control statistics file (binary format, json format for .json file names if supported)" )
     ("TargetBitrate",                                   toBitrate,                                           "Rate control: target bitrate [bits/second], use e.g. 1.5M, 1.5Mbps, 1500k, 1500kbps, 1500000bps, 1500000" )
     ("MaxBitrate",                                      toMaxRate,                                           "Rate control: approximate maximum instantaneous bitrate [bits/second] (0: no rate cap; least constraint)" )
     ("PerceptQPA,-qpa",                                 c->m_usePerceptQPA,                                  "Enable perceptually motivated QP adaptation, XPSNR based (0:off, 1:on)", true)
@@ -799,6 +805,8 @@ int parse( int argc, char* argv[], vvenc_config* c, std::ostream& rcOstr )
                                                                                                            " last : last segment")
   ("y4m",                                               m_forceY4mInput,                                   "force y4m input (only needed for input pipe, else enabled by .y4m file extension)")
   ("logofile",                                          m_logoFileName,                                    "set logo overlay filename (json)")
+  ("mmap",                                              m_mmapInput,                                       "memory map the input file instead of reading it through a stream (not for input pipe)")
+  ("readahead",                                         m_inputReadAhead,                                  "number of input frames read ahead in a background thread (0: off)")
   ;
 
   if( !m_easyMode )
@@ -854,6 +862,7 @@ int parse( int argc, char* argv[], vvenc_config* c, std::ostream& rcOstr )
     ("PrintHexPSNR",                                    c->m_printHexPsnr,                                   "Emit hexadecimal PSNR for each frame (0: off , 1:on")
     ("PrintFrameMSE",                                   c->m_printFrameMSE,                                  "Emit MSE values for each frame (0: off , 1:on")
     ("PrintSequenceMSE",                                c->m_printSequenceMSE,                               "Emit MSE values for the whole sequence (0: off , 1:on)")
+    ("QualityMetrics",                                  c->m_qualityMetrics,                                 "Compute luma SSIM, MS-SSIM and the VMAF like features VIF and detail preservation for each frame (0: off , 1:on)")
     ;
 
     opts.setSubSection("Bitstream options");
@@ -995,16 +1004,33 @@ int parse( int argc, char* argv[], vvenc_config* c, std::ostream& rcOstr )
     opts.addOptions()
     ("FastSearch",                                      c->m_motionEstimationSearchMethod,                   "Search mode (0:Full search 1:Diamond 2:Deprecated 3:Enhanced Diamond 4: FastDiamond)")
     ("FastSearchSCC",                                   c->m_motionEstimationSearchMethodSCC,                "Search mode for SCC (0:use non SCC-search 1:Deprecated 2:DiamondSCC 3:FastDiamondSCC)")
+    ("HashME",                                          c->m_hashME,                                         "Hash based motion search for exact block matches in the reference pictures (0: off, 1: screen content pictures, 2: all pictures, not used with IFP)")
     ("SearchRange,-sr",                                 c->m_SearchRange,                                    "Motion search range")
     ("BipredSearchRange",                               c->m_bipredSearchRange,                              "Motion search range for bipred refinement")
     ("MinSearchWindow",                                 c->m_minSearchWindow,                                "Minimum motion search window size for the adaptive window ME")
     ("ClipForBiPredMEEnabled",                          c->m_bClipForBiPredMeEnabled,                        "Enable clipping in the Bi-Pred ME.")
     ("FastMEAssumingSmootherMVEnabled",                 c->m_bFastMEAssumingSmootherMVEnabled,               "Enable fast ME assuming a smoother MV.")
     ("IntegerET",                                       c->m_bIntegerET,                                     "Enable early termination for integer motion search")
+    ("MCTFMvHints",                                     c->m_mctfMvHints,                                    "Use the MCTF motion field as start candidate for the integer motion search and reduce the search range around it (requires MCTF)")
     ("FastSubPel",                                      c->m_fastSubPel,                                     "Enable fast sub-pel ME (1: enable fast sub-pel ME, 2: completely disable sub-pel ME)")
+    ("SubPelPlanes",                                    c->m_subPelPlanes,                                   "Precompute sub-pel interpolated planes of the reference pictures for the fractional ME (0: off, 1: half-pel, 2: half- and quarter-pel, not used with IFP)")
     ("ReduceFilterME",                                  c->m_meReduceTap,                                    "Use reduced filter taps during subpel refinement (0 - use 8-tap; 1 - 6-tap; 2 - 4-tap)")
     ;
 
+    opts.setSubSection("Multi-resolution encoding");
+    opts.addOptions()
+    ("RenditionWidth",                                  toRenditionWidth,                                    "Source widths of additional downscaled renditions encoded from the shared pre-analysis (down to 1/8 of the source size, written to <BitstreamFile>_r<N>)")
+    ("RenditionHeight",                                 toRenditionHeight,                                   "Source heights of the additional renditions")
+    ("RenditionQP",                                     toRenditionQP,                                       "QPs of the additional renditions (-1: use QP)")
+    ("RenditionFilter",                                 c->m_renditionFilter,                                "Resampling filter generating the renditions (0: box, dyadic sizes only, 1: bicubic, 2: lanczos3)")
+    ;
+
+    opts.setSubSection("Checkpoint / restart");
+    opts.addOptions()
+    ("CheckpointFile",                                  toCheckpointFile,                                    "Write the encoder state to this file at each IDR picture of the final pass (requires DecodingRefreshType 6, no look-ahead RC)")
+    ("CheckpointResume",                                c->m_checkpointResume,                               "Resume an interrupted encoding from the checkpoint file, the bitstream file is truncated to the checkpoint position")
+    ;
+
     // Deblocking filter parameters
     opts.setSubSection("Loop filters (deblock and SAO)");
     opts.addOptions()
@@ -1119,6 +1145,7 @@ int parse( int argc, char* argv[], vvenc_config* c, std::ostream& rcOstr )
     ("MCTFFrame",                                       toMCTFFrames,                                        "Frame to filter Strength for frame in GOP based temporal filter")
     ("MCTFStrength",                                    toMCTFStrengths,                                     "Strength for  frame in GOP based temporal filter.")
     ("BIM",                                             c->m_blockImportanceMapping,                         "Block importance mapping (basic temporal RDO based on MCTF).")
+    ("CuTree",                                          c->m_cuTree,                                         "CU-tree QP propagation over a look-ahead window of N frames, replaces the BIM QP offsets (0: off, requires BIM)")
 
     ("FastLocalDualTreeMode",                           c->m_fastLocalDualTreeMode,                          "Fast intra pass coding for local dual-tree in intra coding region (0:off, 1:use threshold, 2:one intra mode only)")
     ("QtbttExtraFast",                                  c->m_qtbttSpeedUp,                                   "Non-VTM compatible QTBTT speed-ups" )
@@ -1137,6 +1164,10 @@ int parse( int argc, char* argv[], vvenc_config* c, std::ostream& rcOstr )
     ("IFPLines",                                        toIfpLines,                                          "Inter-Frame Parallelization(IFP) explicit CTU-lines synchronization offset (-1: default mode with two lines, 0: off)")
     ("IFP",                                             toUseIfp,                                            "Inter-Frame Parallelization(IFP) (-1: auto, 0: off, 1: on, with default setting of IFPLines)")
     ("NumParallelGOPs",                                 toNumParallelGOPs,                                   "Number of additional GOPs processed in parallel")
+    ("WorkStealing",                                    c->m_tpWorkStealing,                                 "Thread pool scheduling with per-thread task queues and work stealing (0: single shared task queue, 1: work stealing)")
+    ("NUMA",                                            c->m_numaAware,                                      "NUMA aware processing (Linux only): pin worker threads to nodes, keep parallel picture encoders node local and interleave shared picture buffers")
+    ("LowLatencyOutput",                                c->m_lowLatencyOutput,                               "Write CTU lines as soon as they are final and output access units without stage parallel delay (requires ALF 0, multiple tiles fall back to writing at picture end)")
+    ("AdaptiveThreads",                                 c->m_adaptiveThreads,                                "Adapt the number of active worker threads and parallel frames at runtime to meet the real-time frame rate with the least threads")
     ;
 
     opts.setSubSection("Coding tools");
@@ -1651,16 +1682,6 @@ bool xCheckCfg( vvenc_config* c, std::ostream& rcOstr )
   }
 
 #ifndef VVENC_ENABLE_THIRDPARTY_JSON
-  if( c->m_RCPass > 0 )
-  {
-    rcOstr << "error: reading/writing rate control statistics file not supported, please disable pass parameter or compile with json enabled" << std::endl;
-    ret = false;
-  }
-  if( ! m_RCStatsFileName.empty() )
-  {
-    rcOstr << "error: reading/writing rate control statistics file not supported, please disable rcstatsfile parameter or compile with json enabled" << std::endl;
-    ret = false;
-  }
   if( ! m_logoFileName.empty() )
   {
     rcOstr << "error: reading of logo overlay file not supported, please disable logofile parameter or compile with json enabled" << std::endl;
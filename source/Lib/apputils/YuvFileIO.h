@@ -52,6 +52,10 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include <algorithm>
 #include <regex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
 
 #include "vvenc/vvencCfg.h"
 #include "vvenc/vvenc.h"
@@ -62,6 +66,12 @@ POSSIBILITY OF SUCH DAMAGE.
 #if defined (_WIN32) || defined (WIN32) || defined (_WIN64) || defined (WIN64)
 #include <io.h>
 #include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define YUV_FILE_IO_MMAP 1
 #endif
 
 //! \ingroup Interface
@@ -92,8 +102,42 @@ private:
   size_t              m_packetCount         = 0;
   LogoRenderer        m_cLogoRenderer;
 
+  bool                m_useMmap             = false;            ///< map the input file into memory instead of reading through the stream
+  const uint8_t*      m_mapData             = nullptr;          ///< memory mapped input file
+  size_t              m_mapSize             = 0;
+  FileIOHelper::MemorySource m_mapSrc;                          ///< read position within the mapped file
+  bool                m_mapEof              = false;
+
+  struct ReadAheadSlot
+  {
+    vvencYUVBuffer    yuvBuf;
+    int               ret = 0;
+    bool              eof = false;
+  };
+
+  int                 m_readAhead           = 0;                ///< number of frames read ahead in a background thread
+  std::vector<ReadAheadSlot> m_raSlots;
+  std::thread         m_raThread;
+  std::mutex          m_raMutex;
+  std::condition_variable m_raCond;
+  size_t              m_raHead              = 0;                ///< next slot to be consumed
+  size_t              m_raCount             = 0;                ///< number of filled slots
+  bool                m_raStop              = false;
+  bool                m_raEof               = false;            ///< end of stream as seen by the consumer
+
 public:
 
+  ~YuvFileIO()
+  {
+    xStopReadAhead();
+    xUnmapFile();
+  }
+
+  // memory map the input file (regular files only, ignored for stdin and on platforms without mmap support)
+  void setMemoryMapping( bool useMmap )  { m_useMmap   = useMmap; }
+  // read up to numFrames frames ahead of the caller in a background thread
+  void setReadAhead    ( int numFrames ) { m_readAhead = std::max( 0, numFrames ); }
+
   int open( const std::string &fileName, bool bWriteMode, int fileBitDepth, int MSBExtendedBitDepth, int internalBitDepth, 
             vvencChromaFormat fileChrFmt, vvencChromaFormat bufferChrFmt, bool clipToRec709, bool packedYUVMode, bool y4mMode,
             std::string cLogoFilename = "" )
@@ -178,11 +222,16 @@ public:
         return -1;
       }
 
+      if( m_useMmap && !xMapFile( fileName ) )
+      {
+        m_lastError =  "\nFailed to memory map input YUV file:  " + fileName;
+        return -1;
+      }
+
       if ( m_y4mMode || FileIOHelper::isY4mInputFilename( fileName ) )
       {
-        std::istream& inStream = m_cHandle;
         std::string headerline;
-        getline(inStream, headerline);  // jump over y4m header
+        xGetLine( headerline );  // jump over y4m header
         m_y4mMode   = true;
       }
     }
@@ -191,6 +240,9 @@ public:
 
   void close()
   {
+    xStopReadAhead();
+    xUnmapFile();
+
     if( !m_readStdin )
       m_cHandle.close();
 
@@ -201,7 +253,7 @@ public:
   }
 
   bool  isOpen()  { return m_cHandle.is_open(); }
-  bool  isEof()   { return m_cHandle.eof();     }
+  bool  isEof()   { return m_readAhead ? m_raEof : m_mapData ? m_mapEof : m_cHandle.eof(); }
   bool  isFail()  { return m_cHandle.fail();    }
   std::string getLastError() const { return m_lastError; }
 
@@ -245,6 +297,16 @@ public:
 
     const std::streamoff offset = frameSize * numFrames;
 
+    if( m_mapData )
+    {
+      if( offset >= m_mapSrc.end - m_mapSrc.cur )
+      {
+        return -1;
+      }
+      m_mapSrc.cur += offset;
+      return 0;
+    }
+
     std::istream& inStream = m_readStdin ? std::cin : m_cHandle;
 
     // check for file size
@@ -283,10 +345,66 @@ public:
 
 
   int readYuvBuf ( vvencYUVBuffer& yuvInBuf, bool& eof )
+  {
+    if( m_readAhead <= 0 || m_readStdin )
+    {
+      m_readAhead = 0;
+      return xReadYuvBuf( yuvInBuf, eof );
+    }
+
+    eof = false;
+    if( m_raEof )
+    {
+      m_lastError = "end of file";
+      eof = true;
+      return 0;
+    }
+
+    if( m_raSlots.empty() )
+    {
+      xStartReadAhead( yuvInBuf );
+    }
+
+    std::unique_lock<std::mutex> lock( m_raMutex );
+    m_raCond.wait( lock, [this]{ return m_raCount > 0; } );
+
+    ReadAheadSlot& slot = m_raSlots[ m_raHead ];
+    int ret = slot.ret;
+    eof     = slot.eof;
+    if( ret == 0 && !eof )
+    {
+      for( int comp = 0; comp < 3; comp++ )
+      {
+        const vvencYUVPlane& src = slot.yuvBuf.planes[ comp ];
+        vvencYUVPlane&       dst = yuvInBuf.planes[ comp ];
+        if( !src.ptr || !dst.ptr )
+          continue;
+        for( int y = 0; y < dst.height; y++ )
+        {
+          memcpy( dst.ptr + y * dst.stride, src.ptr + y * src.stride, dst.width * sizeof( LPel ) );
+        }
+      }
+    }
+    else
+    {
+      // the reader thread stops after delivering an error or the end of the stream
+      m_raEof = true;
+    }
+    m_raHead = ( m_raHead + 1 ) % m_raSlots.size();
+    m_raCount--;
+    lock.unlock();
+    m_raCond.notify_all();
+
+    return ret;
+  }
+
+private:
+
+  int xReadYuvBuf ( vvencYUVBuffer& yuvInBuf, bool& eof )
   {
     eof = false;
     // check end-of-file
-    if ( isEof() )
+    if ( m_mapData ? m_mapEof : m_cHandle.eof() )
     {
       m_lastError = "end of file";
       eof = true;
@@ -318,12 +436,10 @@ public:
         yuvPlane.stride = yuvPlane.width;
       }
 
-      std::istream& inStream = m_readStdin ? std::cin : m_cHandle;
-
       if( m_y4mMode && comp == 0 )
       {
         std::string y4mPrefix;
-        getline(inStream, y4mPrefix);   /* assume basic FRAME\n headers */
+        xGetLine( y4mPrefix );   /* assume basic FRAME\n headers */
         if( y4mPrefix != "FRAME")
         {
           m_lastError = "Source image does not contain valid y4m header (FRAME) - end of stream";
@@ -332,8 +448,12 @@ public:
         }
       }
 
-      if ( ! FileIOHelper::readYuvPlane( inStream, yuvPlane, is16bit, m_fileBitdepth, m_packedYUVMode, comp, m_fileChrFmt, m_bufferChrFmt ) )
+      const bool readOk = m_mapData
+                        ? FileIOHelper::readYuvPlane( m_mapSrc, yuvPlane, is16bit, m_fileBitdepth, m_packedYUVMode, comp, m_fileChrFmt, m_bufferChrFmt )
+                        : FileIOHelper::readYuvPlane( m_readStdin ? std::cin : m_cHandle, yuvPlane, is16bit, m_fileBitdepth, m_packedYUVMode, comp, m_fileChrFmt, m_bufferChrFmt );
+      if ( ! readOk )
       {
+        m_mapEof = true;
         eof = true;
         return 0;
       }
@@ -368,6 +488,141 @@ public:
     return 0;
   }
 
+  void xGetLine( std::string& line )
+  {
+    if( !m_mapData )
+    {
+      getline( m_readStdin ? std::cin : m_cHandle, line );
+      return;
+    }
+
+    const uint8_t* lineEnd = (const uint8_t*)memchr( m_mapSrc.cur, '\n', m_mapSrc.end - m_mapSrc.cur );
+    if( !lineEnd )
+    {
+      line.clear();
+      m_mapSrc.cur = m_mapSrc.end;
+      m_mapEof     = true;
+      return;
+    }
+    line.assign( (const char*)m_mapSrc.cur, lineEnd - m_mapSrc.cur );
+    m_mapSrc.cur = lineEnd + 1;
+  }
+
+  bool xMapFile( const std::string& fileName )
+  {
+#if YUV_FILE_IO_MMAP
+    int fd = ::open( fileName.c_str(), O_RDONLY );
+    if( fd < 0 )
+    {
+      return false;
+    }
+    struct stat st;
+    if( fstat( fd, &st ) != 0 || !S_ISREG( st.st_mode ) )
+    {
+      ::close( fd );
+      return false;
+    }
+    m_mapSize = st.st_size;
+    if( m_mapSize > 0 )
+    {
+      void* addr = mmap( nullptr, m_mapSize, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if( addr == MAP_FAILED )
+      {
+        ::close( fd );
+        m_mapSize = 0;
+        return false;
+      }
+      madvise( addr, m_mapSize, MADV_SEQUENTIAL );
+      m_mapData = (const uint8_t*)addr;
+    }
+    ::close( fd );
+    m_mapSrc.cur = m_mapData;
+    m_mapSrc.end = m_mapData + m_mapSize;
+    m_mapEof     = m_mapSize == 0;
+    return true;
+#else
+    // no mmap support, keep reading through the stream
+    return true;
+#endif
+  }
+
+  void xUnmapFile()
+  {
+#if YUV_FILE_IO_MMAP
+    if( m_mapData )
+    {
+      munmap( (void*)m_mapData, m_mapSize );
+    }
+#endif
+    m_mapData = nullptr;
+    m_mapSize = 0;
+    m_mapSrc  = FileIOHelper::MemorySource();
+  }
+
+  void xStartReadAhead( const vvencYUVBuffer& yuvInBuf )
+  {
+    m_raSlots.resize( m_readAhead );
+    for( auto& slot : m_raSlots )
+    {
+      vvenc_YUVBuffer_default( &slot.yuvBuf );
+      vvenc_YUVBuffer_alloc_buffer( &slot.yuvBuf, m_bufferChrFmt, yuvInBuf.planes[ 0 ].width, yuvInBuf.planes[ 0 ].height );
+    }
+    m_raHead  = 0;
+    m_raCount = 0;
+    m_raStop  = false;
+    m_raThread = std::thread( &YuvFileIO::xReadAheadProc, this );
+  }
+
+  void xReadAheadProc()
+  {
+    size_t tail = 0;
+    while( true )
+    {
+      {
+        std::unique_lock<std::mutex> lock( m_raMutex );
+        m_raCond.wait( lock, [this]{ return m_raStop || m_raCount < m_raSlots.size(); } );
+        if( m_raStop )
+          return;
+      }
+
+      // the slot at the tail is not visible to the consumer until it is committed below
+      ReadAheadSlot& slot = m_raSlots[ tail ];
+      slot.ret = xReadYuvBuf( slot.yuvBuf, slot.eof );
+      const bool done = slot.ret != 0 || slot.eof;
+
+      {
+        std::unique_lock<std::mutex> lock( m_raMutex );
+        m_raCount++;
+      }
+      m_raCond.notify_all();
+      tail = ( tail + 1 ) % m_raSlots.size();
+
+      if( done )
+        return;
+    }
+  }
+
+  void xStopReadAhead()
+  {
+    if( m_raThread.joinable() )
+    {
+      {
+        std::unique_lock<std::mutex> lock( m_raMutex );
+        m_raStop = true;
+      }
+      m_raCond.notify_all();
+      m_raThread.join();
+    }
+    for( auto& slot : m_raSlots )
+    {
+      vvenc_YUVBuffer_free_buffer( &slot.yuvBuf );
+    }
+    m_raSlots.clear();
+    m_raCount = 0;
+    m_raEof   = false;
+  }
+
+public:
 
   bool writeYuvBuf ( const vvencYUVBuffer& yuvOutBuf )
   {
@@ -445,6 +700,12 @@ public:
       frameSize += (sizeof(Y4MHeader) + 1);  /* assume basic FRAME\n headers */;
     }
 
+    if( m_mapData )
+    {
+      const std::streamoff filelength = countFromStart ? m_mapSize : m_mapSrc.end - m_mapSrc.cur;
+      return (int)(filelength / frameSize);
+    }
+
     std::streamoff lastPos = m_cHandle.tellg();  // backup last position
 
     if( countFromStart )
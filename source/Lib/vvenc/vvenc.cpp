@@ -50,6 +50,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "vvenc/version.h"
 
 #include "vvencimpl.h"
+#include "vvencsegments.h"
 
 VVENC_NAMESPACE_BEGIN
 
@@ -130,6 +131,43 @@ VVENC_DECL void vvenc_YUVBuffer_free_buffer( vvencYUVBuffer *yuvBuffer )
 }
 
 
+VVENC_DECL void vvenc_YUVBuffer_alloc_padded_buffer( vvencYUVBuffer *yuvBuffer, const vvencChromaFormat chFmt, const int frameWidth, const int frameHeight )
+{
+  if ( nullptr == yuvBuffer )
+  {
+    return;
+  }
+
+  const int margin = VVENC_INPUT_BUFFER_MARGIN;
+  for ( int i = 0; i < 3; i++ )
+  {
+    vvencYUVPlane&    yuvPlane = yuvBuffer->planes[ i ];
+    yuvPlane.width  = vvenc_get_width_of_component ( chFmt, frameWidth,  i );
+    yuvPlane.height = vvenc_get_height_of_component( chFmt, frameHeight, i );
+    yuvPlane.stride = ( ( yuvPlane.width + 2 * margin + 7 ) >> 3 ) << 3;
+    const int size  = yuvPlane.stride * ( yuvPlane.height + 2 * margin );
+    yuvPlane.ptr    = ( yuvPlane.width > 0 && yuvPlane.height > 0 ) ? new int16_t[ size ] + margin * yuvPlane.stride + margin : nullptr;
+  }
+}
+
+VVENC_DECL void vvenc_YUVBuffer_free_padded_buffer( vvencYUVBuffer *yuvBuffer )
+{
+  if ( nullptr == yuvBuffer )
+  {
+    return;
+  }
+
+  const int margin = VVENC_INPUT_BUFFER_MARGIN;
+  for ( int i = 0; i < 3; i++ )
+  {
+    if( yuvBuffer->planes[ i ].ptr )
+    {
+      delete [] ( yuvBuffer->planes[ i ].ptr - margin * yuvBuffer->planes[ i ].stride - margin );
+    }
+    yuvBuffer->planes[ i ].ptr = nullptr;
+  }
+}
+
 VVENC_DECL vvencAccessUnit* vvenc_accessUnit_alloc()
 {
   vvencAccessUnit* accessUnit = (vvencAccessUnit*)malloc(sizeof(vvencAccessUnit));
@@ -191,6 +229,13 @@ VVENC_DECL void vvenc_accessUnit_reset(vvencAccessUnit *accessUnit )
   accessUnit->refPic          = false;
   accessUnit->temporalLayer   = 0;
   accessUnit->poc             = 0;
+  accessUnit->rendition       = 0;
+  accessUnit->qualityValid    = false;
+  accessUnit->psnr[0]         = accessUnit->psnr[1] = accessUnit->psnr[2] = 0.0;
+  accessUnit->ssim            = 0.0;
+  accessUnit->msSsim          = 0.0;
+  accessUnit->vif             = 0.0;
+  accessUnit->detail          = 0.0;
   accessUnit->status          = 0;
   accessUnit->essentialBytes  = 0;
 #if VVENC_USE_UNSTABLE_API
@@ -262,6 +307,17 @@ VVENC_DECL int vvenc_encoder_set_RecYUVBufferCallback(vvencEncoder *enc, void *
   return VVENC_OK;
 }
 
+VVENC_DECL int vvenc_encoder_set_YUVBufferReleaseCallback(vvencEncoder *enc, void * ctx, vvencYUVBufferReleaseCallback callback )
+{
+  auto e = (vvenc::VVEncImpl*)enc;
+  if (!e)
+  {
+    return VVENC_ERR_INITIALIZE;
+  }
+
+  return e->setYUVBufferReleaseCallback( ctx, callback );
+}
+
 VVENC_DECL int vvenc_init_pass( vvencEncoder *enc, int pass, const char * statsFName )
 {
   auto e = (vvenc::VVEncImpl*)enc;
@@ -285,6 +341,28 @@ VVENC_DECL int vvenc_encode( vvencEncoder *enc, vvencYUVBuffer* YUVBuffer, vvenc
   return e->encode( YUVBuffer, accessUnit, encodeDone );
 }
 
+VVENC_DECL int vvenc_encoder_set_AccessUnitCallback(vvencEncoder *enc, void * ctx, vvencAccessUnitCallback callback )
+{
+  auto e = (vvenc::VVEncImpl*)enc;
+  if (!e)
+  {
+    return VVENC_ERR_INITIALIZE;
+  }
+
+  return e->setAccessUnitCallback( ctx, callback );
+}
+
+VVENC_DECL int vvenc_push_frame( vvencEncoder *enc, vvencYUVBuffer* YUVBuffer )
+{
+  auto e = (vvenc::VVEncImpl*)enc;
+  if (!e)
+  {
+    return VVENC_ERR_INITIALIZE;
+  }
+
+  return e->pushFrame( YUVBuffer );
+}
+
 VVENC_DECL int vvenc_get_config( vvencEncoder *enc, vvenc_config* cfg )
 {
   auto e = (vvenc::VVEncImpl*)enc;
@@ -378,6 +456,60 @@ VVENC_DECL int vvenc_get_num_trail_frames( vvencEncoder *enc )
   return e->getNumTrailFrames();
 }
 
+VVENC_DECL int vvenc_get_checkpoint_info( vvencEncoder *enc, vvencCheckpointInfo *checkpointInfo )
+{
+  auto e = (vvenc::VVEncImpl*)enc;
+  if (!e || !checkpointInfo)
+  {
+    return VVENC_ERR_UNSPECIFIED;
+  }
+
+  return e->getCheckpointInfo( *checkpointInfo );
+}
+
+VVENC_DECL int vvenc_set_cpu_budget( vvencEncoder *enc, int numThreads )
+{
+  auto e = (vvenc::VVEncImpl*)enc;
+  if (!e)
+  {
+    return VVENC_ERR_UNSPECIFIED;
+  }
+
+  return e->setCpuBudget( numThreads );
+}
+
+VVENC_DECL int vvenc_get_segment_config( const vvenc_config *config, int totalFrames, int numSegments, int segmentIdx, int qp, vvenc_config *segmentConfig, vvencSegmentInfo *segmentInfo )
+{
+  if( nullptr == config || nullptr == segmentConfig || nullptr == segmentInfo )
+  {
+    return VVENC_ERR_PARAMETER;
+  }
+
+  return vvenc::VVEncSegments::getSegmentConfig( *config, totalFrames, numSegments, segmentIdx, qp, *segmentConfig, *segmentInfo );
+}
+
+VVENC_DECL int vvenc_get_segment_qp( const vvenc_config *config, int totalFrames, int firstPassQP, uint64_t firstPassBits )
+{
+  if( nullptr == config )
+  {
+    return VVENC_ERR_PARAMETER;
+  }
+
+  return vvenc::VVEncSegments::getSegmentQP( *config, totalFrames, firstPassQP, firstPassBits );
+}
+
+VVENC_DECL int vvenc_encode_segments( const vvenc_config *config, int totalFrames, int numSegments, int numParallel, void *ctx,
+                                      vvencSegmentInputCallback inputCallback, vvencSegmentOutputCallback outputCallback )
+{
+  if( nullptr == config )
+  {
+    return VVENC_ERR_PARAMETER;
+  }
+
+  vvenc::VVEncSegments segments;
+  return segments.encode( *config, totalFrames, numSegments, numParallel, ctx, inputCallback, outputCallback );
+}
+
 VVENC_DECL int vvenc_print_summary( vvencEncoder *enc )
 {
   auto e = (vvenc::VVEncImpl*)enc;
@@ -656,6 +656,25 @@ VVENC_DECL void vvenc_config_default(vvenc_config *c )
   c->m_ifp                                     = -1;
   c->m_mtProfile                               =  0;
   c->m_numParallelGOPs                         =  0;
+  c->m_tpWorkStealing                          = false;
+  c->m_numaAware                               = false;
+  c->m_mctfMvHints                             = false;
+  c->m_cuTree                                  = 0;
+  c->m_lowLatencyOutput                        = false;
+  c->m_hashME                                  = 0;
+  c->m_subPelPlanes                            = 0;
+  c->m_numRenditions                           = 0;
+  memset( c->m_renditionWidth,  0, sizeof( c->m_renditionWidth ) );
+  memset( c->m_renditionHeight, 0, sizeof( c->m_renditionHeight ) );
+  for( int i = 0; i < VVENC_MAX_RENDITIONS; i++ )
+  {
+    c->m_renditionQP[ i ]                      = -1;
+  }
+  c->m_renditionFilter                         = 1;
+  memset( c->m_checkpointFile, '\0', sizeof( c->m_checkpointFile ) );
+  c->m_checkpointResume                        = false;
+  c->m_adaptiveThreads                         = false;
+  c->m_qualityMetrics                          = false;
 
   c->m_picPartitionFlag                        = false;
   memset( c->m_tileColumnWidth, 0, sizeof(c->m_tileColumnWidth) );
@@ -1511,6 +1530,46 @@ VVENC_DECL bool vvenc_init_config_parameter( vvenc_config *c )
 
   vvenc_confirmParameter( c, c->m_blockImportanceMapping && !c->m_vvencMCTF.MCTF, "BIM (block importance mapping) cannot be enabled when MCTF is disabled!" );
   vvenc_confirmParameter( c, c->m_blockImportanceMapping && c->m_vvencMCTF.MCTFUnitSize > c->m_CTUSize, "MCTFUnitSize cannot exceed CTUSize if BIM is enabled!" );
+  vvenc_confirmParameter( c, c->m_cuTree < 0 || c->m_cuTree > 64, "CuTree look-ahead window must be in the range 0..64" );
+  vvenc_confirmParameter( c, c->m_cuTree && !c->m_blockImportanceMapping, "CuTree cannot be enabled when BIM is disabled!" );
+  vvenc_confirmParameter( c, c->m_hashME < 0 || c->m_hashME > 2, "HashME must be in the range 0..2" );
+  vvenc_confirmParameter( c, c->m_subPelPlanes < 0 || c->m_subPelPlanes > 2, "SubPelPlanes must be in the range 0..2" );
+  vvenc_confirmParameter( c, c->m_numRenditions < 0 || c->m_numRenditions > VVENC_MAX_RENDITIONS, "number of renditions exceeds supported range" );
+  if( c->m_numRenditions > 0 )
+  {
+    vvenc_confirmParameter( c, c->m_RCTargetBitrate != 0 || c->m_RCNumPasses > 1, "renditions are only supported for fixed QP encoding (no rate control)" );
+    vvenc_confirmParameter( c, c->m_renditionFilter < 0 || c->m_renditionFilter > 2, "RenditionFilter must be in the range 0..2" );
+    const int chromaAlignX = c->m_internChromaFormat == VVENC_CHROMA_420 || c->m_internChromaFormat == VVENC_CHROMA_422 ? 2 : 1;
+    const int chromaAlignY = c->m_internChromaFormat == VVENC_CHROMA_420 ? 2 : 1;
+    for( int i = 0; i < std::min( c->m_numRenditions, VVENC_MAX_RENDITIONS ); i++ )
+    {
+      if( c->m_renditionFilter == 0 )
+      {
+        // the box filter only supports dyadic downscaling of the source
+        bool isDyadic = false;
+        for( int scale = 1; scale <= 3; scale++ )
+        {
+          isDyadic |= c->m_renditionWidth[ i ] == ( c->m_SourceWidth >> scale ) && c->m_renditionHeight[ i ] == ( c->m_SourceHeight >> scale );
+        }
+        vvenc_confirmParameter( c, !isDyadic, "rendition size must be the source size divided by 2, 4 or 8 for the box filter" );
+      }
+      vvenc_confirmParameter( c, c->m_renditionWidth[ i ] > c->m_SourceWidth || c->m_renditionHeight[ i ] > c->m_SourceHeight, "rendition size must not exceed the source size" );
+      vvenc_confirmParameter( c, c->m_renditionWidth[ i ] * 8 < c->m_SourceWidth || c->m_renditionHeight[ i ] * 8 < c->m_SourceHeight, "rendition size must be at least one eighth of the source size" );
+      vvenc_confirmParameter( c, c->m_renditionWidth[ i ] % chromaAlignX || c->m_renditionHeight[ i ] % chromaAlignY, "rendition size must be a multiple of the chroma subsampling" );
+      vvenc_confirmParameter( c, c->m_renditionQP[ i ] < -1 || c->m_renditionQP[ i ] > vvenc::MAX_QP, "rendition QP must be -1 (use QP) or in the range 0..63" );
+    }
+  }
+  vvenc_confirmParameter( c, c->m_checkpointResume && c->m_checkpointFile[ 0 ] == '\0', "CheckpointResume requires a checkpoint file" );
+  if( c->m_checkpointFile[ 0 ] != '\0' )
+  {
+    // the encoder restarts at an IDR picture, no picture after it may depend on the pictures before it
+    vvenc_confirmParameter( c, c->m_DecodingRefreshType != VVENC_DRT_IDR_NO_RADL || c->m_IntraPeriod <= 0, "checkpoints require IDR pictures without leading pictures (DecodingRefreshType 6) and an intra period" );
+    vvenc_confirmParameter( c, c->m_LookAhead,                               "checkpoints are not supported with look-ahead rate control" );
+    vvenc_confirmParameter( c, c->m_cuTree,                                  "checkpoints are not supported with CuTree" );
+    vvenc_confirmParameter( c, c->m_numRenditions > 0,                       "checkpoints are not supported with renditions" );
+    vvenc_confirmParameter( c, c->m_SegmentMode != VVENC_SEG_OFF || c->m_leadFrames > 0 || c->m_trailFrames > 0, "checkpoints are not supported in segment mode" );
+    vvenc_confirmParameter( c, c->m_fga,                                     "checkpoints are not supported with film grain analysis" );
+  }
 
   bool disableF2O = c->m_usePerceptQPATempFiltISlice < -1;
   if ( c->m_usePerceptQPATempFiltISlice < 0 )
@@ -1802,6 +1861,7 @@ VVENC_DECL bool vvenc_init_config_parameter( vvenc_config *c )
   vvenc_checkCharArrayStr( c->m_traceFile, VVENC_MAX_STRING_LEN);
   vvenc_checkCharArrayStr( c->m_summaryOutFilename, VVENC_MAX_STRING_LEN);
   vvenc_checkCharArrayStr( c->m_summaryPicFilenameBase, VVENC_MAX_STRING_LEN);
+  vvenc_checkCharArrayStr( c->m_checkpointFile, VVENC_MAX_STRING_LEN);
 
   const int maxTLayer = c->m_picReordering && c->m_GOPSize > 1 ? vvenc::ceilLog2( c->m_GOPSize ) : 0;
   
@@ -2198,6 +2258,9 @@ static bool checkCfgParameter( vvenc_config *c )
       msg.log( VVENC_WARNING, "Using NumParallelGOPs at low number of threads (<%d) does not provide more speedup, consider disabling NumParallelGOPs.\n", minNumThreadsGOPPP );
   }
 
+  vvenc_confirmParameter(c, c->m_lowLatencyOutput && c->m_alf, "LowLatencyOutput: ALF is not supported (must be disabled)" );
+  vvenc_confirmParameter(c, c->m_adaptiveThreads && c->m_numThreads <= 0, "AdaptiveThreads: multi-threading is required (NumThreads > 0)" );
+
   vvenc_confirmParameter(c, c->m_explicitAPSid < 0 || c->m_explicitAPSid > 7, "ExplicitAPDid out of range [0 .. 7]" );
 
   vvenc_confirmParameter(c, c->m_maxNumMergeCand < 1,                              "MaxNumMergeCand must be 1 or greater.");
@@ -3233,6 +3296,7 @@ VVENC_DECL const char* vvenc_get_config_as_string( vvenc_config *c, vvencMsgLeve
     css << loglvl << "Hexadecimal PSNR output                : " << (c->m_printHexPsnr ? "Enabled" : "Disabled") << "\n";
     css << loglvl << "Sequence MSE output                    : " << (c->m_printSequenceMSE ? "Enabled" : "Disabled") << "\n";
     css << loglvl << "Frame MSE output                       : " << (c->m_printFrameMSE ? "Enabled" : "Disabled") << "\n";
+    css << loglvl << "Quality metrics (SSIM, MS-SSIM, VIF)   : " << (c->m_qualityMetrics ? "Enabled" : "Disabled") << "\n";
     css << loglvl << "Cabac-zero-word-padding                : " << (c->m_cabacZeroWordPaddingEnabled ? "Enabled" : "Disabled") << "\n";
     //css << loglvl << "Frame/Field                            : Frame based coding\n";
     if ( c->m_framesToBeEncoded > 0 )
@@ -3343,6 +3407,7 @@ VVENC_DECL const char* vvenc_get_config_as_string( vvenc_config *c, vvencMsgLeve
     css << "EDO:" << c->m_EDO << " ";
     css << "MCTF:" << c->m_vvencMCTF.MCTF << " ";
     css << "BIM:" << c->m_blockImportanceMapping << " ";
+    css << "CuTree:" << c->m_cuTree << " ";
 
     css << "\n" << loglvl << "PRE-ANALYSIS CFG: ";
     css << "STA:" << (int)c->m_sliceTypeAdapt << " ";
@@ -3372,7 +3437,24 @@ VVENC_DECL const char* vvenc_get_config_as_string( vvenc_config *c, vvencMsgLeve
     css << "IntraEstDecBit:" << c->m_IntraEstDecBit << " ";
     css << "FastLocalDualTree:" << c->m_fastLocalDualTreeMode << " ";
     css << "IntegerET:" << c->m_bIntegerET << " ";
+    css << "MCTFMvHints:" << c->m_mctfMvHints << " ";
+    css << "HashME:" << c->m_hashME << " ";
     css << "FastSubPel:" << c->m_fastSubPel << " ";
+    css << "SubPelPlanes:" << c->m_subPelPlanes << " ";
+    if( c->m_numRenditions )
+    {
+      css << "Renditions:";
+      for( int i = 0; i < c->m_numRenditions; i++ )
+      {
+        css << ( i ? "," : "" ) << c->m_renditionWidth[ i ] << "x" << c->m_renditionHeight[ i ] << "@" << ( c->m_renditionQP[ i ] < 0 ? c->m_QP : c->m_renditionQP[ i ] );
+      }
+      css << " ";
+      css << "RenditionFilter:" << c->m_renditionFilter << " ";
+    }
+    if( c->m_checkpointFile[ 0 ] != '\0' )
+    {
+      css << "Checkpoint:" << ( c->m_checkpointResume ? "resume" : "on" ) << " ";
+    }
     css << "ReduceFilterME:" << c->m_meReduceTap << " ";
     css << "QtbttExtraFast:" << c->m_qtbttSpeedUp << " ";
     css << "FastTTSplit:" << c->m_fastTTSplit << " ";
@@ -3428,6 +3510,10 @@ VVENC_DECL const char* vvenc_get_config_as_string( vvenc_config *c, vvencMsgLeve
     css << "MaxParallelFrames:" << c->m_maxParallelFrames << " ";
     css << "IFP:" << (c->m_ifp ? 1: 0) << " (IFPLines:" << (int)c->m_ifpLines << ")" << " ";
     css << "NumParallelGOPs:" << (int) c->m_numParallelGOPs << " ";
+    css << "WorkStealing:" << c->m_tpWorkStealing << " ";
+    css << "NUMA:" << c->m_numaAware << " ";
+    css << "LowLatencyOutput:" << c->m_lowLatencyOutput << " ";
+    css << "AdaptiveThreads:" << c->m_adaptiveThreads << " ";
     if( c->m_picPartitionFlag )
     {
       css << "TileParallelCtuEnc:" << c->m_tileParallelCtuEnc << " ";
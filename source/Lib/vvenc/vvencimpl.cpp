@@ -89,17 +89,26 @@ namespace vvenc {
 
 static_assert( sizeof(Pel)  == sizeof(*(vvencYUVPlane::ptr)),   "internal bits per pel differ from interface definition" );
 
+static const int ASYNC_INPUT_QUEUE_SIZE = 4;   // max. number of pictures waiting for the asynchronous encoder
+
 // ====================================================================================================================
 
 VVEncImpl::VVEncImpl()
 {
   setSIMDExtension( nullptr );   // ensure SIMD-detection is finished
   m_cEncoderInfo = createEncoderInfoStr();
+  vvenc_accessUnit_default( &m_asyncAu );
 }
 
 VVEncImpl::~VVEncImpl()
 {
-
+  xAsyncStop( true );
+  for( auto input : m_asyncFreeInputs )
+  {
+    delete input;
+  }
+  m_asyncFreeInputs.clear();
+  vvenc_accessUnit_free_payload( &m_asyncAu );
 }
 
 int VVEncImpl::getConfig( vvenc_config& config ) const
@@ -110,10 +119,104 @@ int VVEncImpl::getConfig( vvenc_config& config ) const
   return VVENC_OK;
 }
 
-int VVEncImpl::reconfig( const vvenc_config&  )
+static unsigned getMaxDigit( unsigned val )
+{
+  unsigned maxVal = 0;
+  for( ; val > 0; val /= 10 )
+  {
+    maxVal = std::max( maxVal, val % 10 );
+  }
+  return maxVal;
+}
+
+int VVEncImpl::reconfig( const vvenc_config& config )
 {
   if( !m_bInitialized ){ return VVENC_ERR_INITIALIZE; }
-  return VVENC_ERR_NOT_SUPPORTED;
+
+  std::unique_lock<std::mutex> lock( m_encLibMutex );
+  if( m_eState == INTERNAL_STATE_FLUSHING || m_eState == INTERNAL_STATE_FINALIZED ) { m_cErrorString = "encoder already received flush indication, please reinit."; return VVENC_ERR_RESTART_REQUIRED; }
+
+  std::string& rcErrorString = m_cErrorString;
+  const vvenc_config& curCfg = m_cVVEncCfg;
+
+  // parameters defining the coded sequence or the encoder setup cannot be changed,
+  // compare against both, the given configuration and the derived one returned by vvenc_get_config()
+  auto isChanged = [&]( auto member ) { return config.*member != curCfg.*member && config.*member != m_cVVEncCfgExt.*member; };
+  if( isChanged( &vvenc_config::m_SourceWidth ) || isChanged( &vvenc_config::m_SourceHeight )
+   || isChanged( &vvenc_config::m_FrameRate )   || isChanged( &vvenc_config::m_FrameScale )
+   || isChanged( &vvenc_config::m_GOPSize )     || isChanged( &vvenc_config::m_IntraPeriod )
+   || isChanged( &vvenc_config::m_CTUSize )     || isChanged( &vvenc_config::m_internChromaFormat )
+   || isChanged( &vvenc_config::m_numThreads )  || isChanged( &vvenc_config::m_maxParallelFrames )
+   || isChanged( &vvenc_config::m_RCNumPasses ) )
+  {
+    m_cErrorString = "reconfig: only bitrate, QP and search parameters can be changed while encoding";
+    return VVENC_ERR_NOT_SUPPORTED;
+  }
+  if( ( config.m_RCTargetBitrate > 0 ) != ( curCfg.m_RCTargetBitrate > 0 ) )
+  {
+    m_cErrorString = "reconfig: rate control cannot be switched on or off while encoding";
+    return VVENC_ERR_NOT_SUPPORTED;
+  }
+  if( curCfg.m_RCNumPasses > 1 )
+  {
+    m_cErrorString = "reconfig: not supported in two pass rate control";
+    return VVENC_ERR_NOT_SUPPORTED;
+  }
+
+  vvenc_config newCfg = curCfg;
+  newCfg.m_RCMaxBitrate = config.m_RCMaxBitrate == 0 ? INT32_MAX : config.m_RCMaxBitrate;
+  if( curCfg.m_RCTargetBitrate > 0 )
+  {
+    newCfg.m_RCTargetBitrate = config.m_RCTargetBitrate;
+    if( newCfg.m_RCMaxBitrate < 0 )
+    {
+      newCfg.m_RCMaxBitrate = (int)( ( -(int64_t)newCfg.m_RCMaxBitrate * (int64_t)newCfg.m_RCTargetBitrate + 8 ) >> 4 );
+    }
+    ROTPARAMS( newCfg.m_RCTargetBitrate > 800000000, "TargetBitrate must be between 0 and 800000000" );
+    ROTPARAMS( (int64_t)newCfg.m_RCMaxBitrate * 2 < (int64_t)newCfg.m_RCTargetBitrate * 3, "MaxBitrate must be at least 1.5*TargetBitrate" );
+  }
+  else
+  {
+    newCfg.m_QP = config.m_QP;
+    ROTPARAMS( newCfg.m_QP < -6 * ( newCfg.m_internalBitDepth[0] - 8 ) || newCfg.m_QP > MAX_QP, "QP exceeds supported range (-QpBDOffsety to 63)" );
+    ROTPARAMS( newCfg.m_RCMaxBitrate < 0, "Cannot specify a relative max rate when using CQF, please specify an absolute value" );
+    if( ( newCfg.m_RCMaxBitrate < INT32_MAX ) != ( curCfg.m_RCMaxBitrate > 0 && curCfg.m_RCMaxBitrate < INT32_MAX ) )
+    {
+      m_cErrorString = "reconfig: capped CQF cannot be switched on or off while encoding";
+      return VVENC_ERR_NOT_SUPPORTED;
+    }
+  }
+
+  // speed parameters, the partitioning depth is limited by the setup of the encoder
+  const int maxTLayer = newCfg.m_picReordering && newCfg.m_GOPSize > 1 ? ceilLog2( newCfg.m_GOPSize ) : 0;
+  newCfg.m_maxMTTDepth         = config.m_maxMTTDepth;
+  newCfg.m_SearchRange         = config.m_SearchRange;
+  newCfg.m_fastInterSearchMode = config.m_fastInterSearchMode;
+  ROTPARAMS( getMaxDigit( newCfg.m_maxMTTDepth ) > getMaxDigit( curCfg.m_maxMTTDepth ), "reconfig: MaxMTTHierarchyDepth cannot be increased beyond the initial depth" );
+  ROTPARAMS( newCfg.m_maxMTTDepth >= 10 && newCfg.m_maxMTTDepth < pow( 10, maxTLayer ), "MaxMTTHierarchyDepth>=10 & not set for all TLs" );
+  ROTPARAMS( newCfg.m_SearchRange < 0, "Search Range must be more than 0" );
+  ROTPARAMS( newCfg.m_fastInterSearchMode < VVENC_FASTINTERSEARCH_OFF || newCfg.m_fastInterSearchMode > VVENC_FASTINTERSEARCH_MODE3, "FastInterSearchMode parameter out of range [0...3]" );
+
+  if ( m_pEncLib )
+  {
+#if HANDLE_EXCEPTION
+    try
+#endif
+    {
+      m_pEncLib->reconfig( newCfg );
+    }
+#if HANDLE_EXCEPTION
+    catch( std::exception& e )
+    {
+      msg.log( VVENC_ERROR, "\n%s\n", e.what() );
+      m_cErrorString = e.what();
+      return VVENC_ERR_UNSPECIFIED;
+    }
+#endif
+  }
+
+  m_cVVEncCfg = newCfg;
+  return VVENC_OK;
 }
 
 int VVEncImpl::checkConfig( const vvenc_config& config )
@@ -157,6 +260,31 @@ int VVEncImpl::init( vvenc_config* config )
   }
 #endif
 
+  // additional renditions are derived from the user config, they only differ in size and QP
+  std::vector<vvenc_config> renditionCfgs( m_cVVEncCfg.m_numRenditions, m_cVVEncCfgExt );
+  for( int i = 0; i < m_cVVEncCfg.m_numRenditions; i++ )
+  {
+    vvenc_config& cfg = renditionCfgs[ i ];
+    cfg.m_SourceWidth                 = m_cVVEncCfg.m_renditionWidth[ i ];
+    cfg.m_SourceHeight                = m_cVVEncCfg.m_renditionHeight[ i ];
+    cfg.m_QP                          = m_cVVEncCfg.m_renditionQP[ i ] < 0 ? m_cVVEncCfgExt.m_QP : m_cVVEncCfg.m_renditionQP[ i ];
+    cfg.m_numThreads                  = m_cVVEncCfg.m_numThreads;
+    cfg.m_numRenditions               = 0;
+    cfg.m_conformanceWindowMode       = 1;
+    cfg.m_aiPad[ 0 ]                  = cfg.m_aiPad[ 1 ] = 0;
+    cfg.m_summaryOutFilename[ 0 ]     = '\0';
+    cfg.m_summaryPicFilenameBase[ 0 ] = '\0';
+
+    if( vvenc_init_config_parameter( &cfg ) )
+    {
+      std::stringstream css;
+      css << "invalid configuration of rendition " << i + 1 << " (" << cfg.m_SourceWidth << "x" << cfg.m_SourceHeight << ")";
+      m_cErrorString = css.str();
+      msg.log( VVENC_ERROR, "%s\n", m_cErrorString.c_str() );
+      return VVENC_ERR_INITIALIZE;
+    }
+  }
+
   // initialize the encoder
   m_pEncLib = new EncLib ( msg );
 
@@ -164,7 +292,11 @@ int VVEncImpl::init( vvenc_config* config )
   try
 #endif
   {
-    m_pEncLib->initEncoderLib( m_cVVEncCfg );
+    m_pEncLib->initEncoderLib( m_cVVEncCfg, renditionCfgs );
+
+    // a resumed encoding continues the bitstream at the checkpoint position
+    int pass, firstFrame, firstInputFrame;
+    m_pEncLib->getCheckpointInfo( pass, firstFrame, firstInputFrame, m_bitstreamSize );
   }
 #if HANDLE_EXCEPTION
   catch( std::exception& e )
@@ -191,6 +323,9 @@ int VVEncImpl::initPass( int pass, const char* statsFName )
     return VVENC_ERR_NOT_SUPPORTED;
   }
 
+  // a flushed asynchronous encoding is finished, otherwise it is cancelled
+  xAsyncStop( !m_asyncFlush );
+
   if ( m_pEncLib )
   {
 #if HANDLE_EXCEPTION
@@ -217,6 +352,12 @@ int VVEncImpl::uninit()
 {
   if( !m_bInitialized ){ return VVENC_ERR_INITIALIZE; }
 
+  xAsyncStop( true );
+  m_auCtx          = nullptr;
+  m_auFunc         = nullptr;
+  m_yuvReleaseCtx  = nullptr;
+  m_yuvReleaseFunc = nullptr;
+
   if ( m_pEncLib )
   {
 #if HANDLE_EXCEPTION
@@ -259,10 +400,36 @@ int VVEncImpl::setRecYUVBufferCallback( void * ctx, vvencRecYUVBufferCallback ca
   return VVENC_OK;
 }
 
+int VVEncImpl::setYUVBufferReleaseCallback( void * ctx, vvencYUVBufferReleaseCallback callback )
+{
+  if( !m_bInitialized || !m_pEncLib ){ return VVENC_ERR_INITIALIZE; }
+
+  m_pEncLib->setYUVBufferReleaseCallback( ctx, callback );
+  m_yuvReleaseCtx  = ctx;
+  m_yuvReleaseFunc = callback;
+  return VVENC_OK;
+}
+
+int VVEncImpl::setAccessUnitCallback( void * ctx, vvencAccessUnitCallback callback )
+{
+  if( !m_bInitialized || !m_pEncLib ){ return VVENC_ERR_INITIALIZE; }
+
+  if( m_asyncThread.joinable() || m_eState != INTERNAL_STATE_INITIALIZED )
+  {
+    m_cErrorString = "access unit callback can only be set before the first picture of an encoder pass is passed.";
+    return VVENC_ERR_RESTART_REQUIRED;
+  }
+
+  m_auCtx  = ctx;
+  m_auFunc = callback;
+  return VVENC_OK;
+}
+
 int VVEncImpl::encode( vvencYUVBuffer* pcYUVBuffer, vvencAccessUnit* pcAccessUnit, bool* pbEncodeDone )
 {
   if( !m_bInitialized )                      { return VVENC_ERR_INITIALIZE; }
   if( m_eState == INTERNAL_STATE_FINALIZED ) { m_cErrorString = "encoder already flushed, please reinit."; return VVENC_ERR_RESTART_REQUIRED; }
+  if( m_auFunc )                             { m_cErrorString = "encode is not available in asynchronous mode, use pushFrame."; return VVENC_ERR_NOT_SUPPORTED; }
 
   if( !pcAccessUnit )
   {
@@ -275,78 +442,315 @@ int VVEncImpl::encode( vvencYUVBuffer* pcYUVBuffer, vvencAccessUnit* pcAccessUni
     return VVENC_NOT_ENOUGH_MEM;
   }
 
-  int iRet= VVENC_OK;
+  AccessUnitList cAu;
+  int iRet = xEncode( pcYUVBuffer, pcAccessUnit, cAu, pbEncodeDone );
+  if( iRet != VVENC_OK )
+  {
+    return iRet;
+  }
+
+  /* copy output AU */
+  if ( !cAu.empty() )
+  {
+    int sizeAu = xGetAccessUnitsSize( cAu );
+    if( pcAccessUnit->payloadSize < sizeAu )
+    {
+      std::stringstream css;
+      css << "vvencAccessUnit payload size is too small to store data. (payload size: " << pcAccessUnit->payloadSize << ", needed " << sizeAu << ")";
+      m_cErrorString =css.str();
+      return VVENC_NOT_ENOUGH_MEM;
+    }
+
+    iRet = xWriteCheckpoint( cAu );
+    if( iRet != VVENC_OK )
+    {
+      return iRet;
+    }
+
+    iRet = xCopyAu( *pcAccessUnit, cAu  );
+  }
+
+#if defined( __linux__ ) && defined( __GLIBC__ )
+  malloc_trim(0);   // free unused heap memory
+#endif
+
+  return iRet;
+}
+
+int VVEncImpl::pushFrame( vvencYUVBuffer* pcYUVBuffer )
+{
+  if( !m_bInitialized ) { return VVENC_ERR_INITIALIZE; }
+  if( !m_auFunc )       { m_cErrorString = "pushFrame requires the asynchronous mode, set the access unit callback first."; return VVENC_ERR_NOT_SUPPORTED; }
 
-  bool bFlush = false;
   if( pcYUVBuffer )
   {
-    if( m_eState == INTERNAL_STATE_FLUSHING ) { m_cErrorString = "encoder already received flush indication, please reinit."; return VVENC_ERR_RESTART_REQUIRED; }
+    int iRet = xVerifyInputBuffer( pcYUVBuffer );
+    if( iRet != VVENC_OK )
+    {
+      return iRet;
+    }
+  }
+
+  std::unique_lock<std::mutex> lock( m_asyncMutex );
+  if( m_asyncRet != VVENC_OK )
+  {
+    return m_asyncRet;
+  }
+  if( m_asyncFlush )
+  {
+    m_cErrorString = "encoder already received flush indication, please reinit.";
+    return VVENC_ERR_RESTART_REQUIRED;
+  }
 
-    if( pcYUVBuffer->planes[0].ptr == nullptr )
+  if( pcYUVBuffer )
+  {
+    if( (int)m_asyncInputQueue.size() >= ASYNC_INPUT_QUEUE_SIZE )
     {
-      m_cErrorString = "InputPicture: invalid input buffers";
-      return VVENC_ERR_UNSPECIFIED;
+      return VVENC_QUEUE_FULL;
+    }
+
+    AsyncInput* input = nullptr;
+    if( m_asyncFreeInputs.empty() )
+    {
+      input = new AsyncInput;
     }
+    else
+    {
+      input = m_asyncFreeInputs.back();
+      m_asyncFreeInputs.pop_back();
+    }
+    lock.unlock();
 
-    if( m_cVVEncCfg.m_internChromaFormat != VVENC_CHROMA_400 )
+    input->yuvBuf = *pcYUVBuffer;
+    if( !m_yuvReleaseFunc )
     {
-      if( pcYUVBuffer->planes[1].ptr == nullptr ||
-          pcYUVBuffer->planes[2].ptr == nullptr )
+      // the caller gets the buffer back immediately, so the picture has to be copied
+      for( int i = 0; i < VVENC_MAX_NUM_COMP; i++ )
       {
-        m_cErrorString = "InputPicture: invalid input buffers for chroma";
-        return VVENC_ERR_UNSPECIFIED;
+        const vvencYUVPlane& src = pcYUVBuffer->planes[ i ];
+        vvencYUVPlane&       dst = input->yuvBuf.planes[ i ];
+        if( src.ptr == nullptr )
+        {
+          continue;
+        }
+        input->samples[ i ].resize( src.width * src.height );
+        for( int y = 0; y < src.height; y++ )
+        {
+          std::copy_n( src.ptr + y * src.stride, src.width, &input->samples[ i ][ y * src.width ] );
+        }
+        dst.ptr    = input->samples[ i ].data();
+        dst.stride = src.width;
       }
     }
 
-    if( pcYUVBuffer->planes[0].width != m_cVVEncCfg.m_SourceWidth )
+    lock.lock();
+    m_asyncInputQueue.push_back( input );
+  }
+  else
+  {
+    m_asyncFlush = true;
+  }
+
+  if( !m_asyncThread.joinable() )
+  {
+    m_asyncThread = std::thread( &VVEncImpl::xAsyncEncode, this );
+  }
+  lock.unlock();
+  m_asyncCond.notify_one();
+
+  return VVENC_OK;
+}
+
+void VVEncImpl::xAsyncEncode()
+{
+  bool encodeDone = false;
+  int  iRet       = VVENC_OK;
+  while( !encodeDone && iRet == VVENC_OK )
+  {
+    AsyncInput* input = nullptr;
     {
-      m_cErrorString = "InputPicture: unsupported width";
-      return VVENC_ERR_UNSPECIFIED;
+      std::unique_lock<std::mutex> lock( m_asyncMutex );
+      m_asyncCond.wait( lock, [this]{ return m_asyncAbort || m_asyncFlush || !m_asyncInputQueue.empty(); } );
+      if( m_asyncAbort )
+      {
+        return;
+      }
+      if( !m_asyncInputQueue.empty() )
+      {
+        input = m_asyncInputQueue.front();
+        m_asyncInputQueue.pop_front();
+      }
     }
 
-    if( pcYUVBuffer->planes[0].height != m_cVVEncCfg.m_SourceHeight )
+    // the picture is copied or referenced by the encoder, so the input can be reused afterwards
+    AccessUnitList cAu;
+    iRet = xEncode( input ? &input->yuvBuf : nullptr, nullptr, cAu, &encodeDone );
+
+    if( input )
     {
-      m_cErrorString = "InputPicture: unsupported height";
-      return VVENC_ERR_UNSPECIFIED;
+      std::unique_lock<std::mutex> lock( m_asyncMutex );
+      m_asyncFreeInputs.push_back( input );
     }
 
-    if( pcYUVBuffer->planes[0].width > pcYUVBuffer->planes[0].stride )
+    if( iRet == VVENC_OK && !cAu.empty() )
     {
-      m_cErrorString = "InputPicture: unsupported width stride combination";
+      iRet = xAsyncDeliverAu( cAu );
+    }
+  }
+
+  if( iRet != VVENC_OK )
+  {
+    std::unique_lock<std::mutex> lock( m_asyncMutex );
+    m_asyncRet = iRet;
+  }
+
+  // signal end of stream
+  m_auFunc( m_auCtx, nullptr );
+}
+
+int VVEncImpl::xAsyncDeliverAu( const AccessUnitList& rcAu )
+{
+  const int sizeAu = xGetAccessUnitsSize( rcAu );
+  if( m_asyncAu.payloadSize < sizeAu )
+  {
+    vvenc_accessUnit_free_payload( &m_asyncAu );
+    m_asyncAu.payload = nullptr;
+    vvenc_accessUnit_alloc_payload( &m_asyncAu, sizeAu );
+    if( m_asyncAu.payload == nullptr )
+    {
+      m_cErrorString = "cannot allocate the access unit payload";
+      return VVENC_ERR_ALLOCATE;
+    }
+  }
+
+  vvenc_accessUnit_reset( &m_asyncAu );
+  int iRet = xWriteCheckpoint( rcAu );
+  if( iRet != VVENC_OK )
+  {
+    return iRet;
+  }
+  iRet = xCopyAu( m_asyncAu, rcAu );
+  if( iRet == VVENC_OK )
+  {
+    m_auFunc( m_auCtx, &m_asyncAu );
+  }
+  return iRet;
+}
+
+void VVEncImpl::xAsyncStop( bool abort )
+{
+  if( m_asyncThread.joinable() )
+  {
+    {
+      std::unique_lock<std::mutex> lock( m_asyncMutex );
+      m_asyncAbort = abort;
+    }
+    m_asyncCond.notify_one();
+    m_asyncThread.join();
+  }
+
+  // return pictures, which have not been passed to the encoder
+  for( auto input : m_asyncInputQueue )
+  {
+    if( m_yuvReleaseFunc )
+    {
+      vvencYUVBuffer yuvBuf = input->yuvBuf;
+      m_yuvReleaseFunc( m_yuvReleaseCtx, &yuvBuf );
+    }
+    m_asyncFreeInputs.push_back( input );
+  }
+  m_asyncInputQueue.clear();
+
+  m_asyncFlush = false;
+  m_asyncAbort = false;
+  m_asyncRet   = VVENC_OK;
+}
+
+int VVEncImpl::xVerifyInputBuffer( const vvencYUVBuffer* pcYUVBuffer )
+{
+  if( pcYUVBuffer->planes[0].ptr == nullptr )
+  {
+    m_cErrorString = "InputPicture: invalid input buffers";
+    return VVENC_ERR_UNSPECIFIED;
+  }
+
+  if( m_cVVEncCfg.m_internChromaFormat != VVENC_CHROMA_400 )
+  {
+    if( pcYUVBuffer->planes[1].ptr == nullptr ||
+        pcYUVBuffer->planes[2].ptr == nullptr )
+    {
+      m_cErrorString = "InputPicture: invalid input buffers for chroma";
       return VVENC_ERR_UNSPECIFIED;
     }
+  }
 
-    if( m_cVVEncCfg.m_internChromaFormat != VVENC_CHROMA_400 )
+  if( pcYUVBuffer->planes[0].width != m_cVVEncCfg.m_SourceWidth )
+  {
+    m_cErrorString = "InputPicture: unsupported width";
+    return VVENC_ERR_UNSPECIFIED;
+  }
+
+  if( pcYUVBuffer->planes[0].height != m_cVVEncCfg.m_SourceHeight )
+  {
+    m_cErrorString = "InputPicture: unsupported height";
+    return VVENC_ERR_UNSPECIFIED;
+  }
+
+  if( pcYUVBuffer->planes[0].width > pcYUVBuffer->planes[0].stride )
+  {
+    m_cErrorString = "InputPicture: unsupported width stride combination";
+    return VVENC_ERR_UNSPECIFIED;
+  }
+
+  if( m_cVVEncCfg.m_internChromaFormat != VVENC_CHROMA_400 )
+  {
+    if( m_cVVEncCfg.m_internChromaFormat == VVENC_CHROMA_444 )
     {
-      if( m_cVVEncCfg.m_internChromaFormat == VVENC_CHROMA_444 )
+      if( pcYUVBuffer->planes[1].stride && pcYUVBuffer->planes[0].width > pcYUVBuffer->planes[1].stride )
       {
-        if( pcYUVBuffer->planes[1].stride && pcYUVBuffer->planes[0].width > pcYUVBuffer->planes[1].stride )
-        {
-          m_cErrorString = "InputPicture: unsupported width cstride combination for 2nd plane";
-          return VVENC_ERR_UNSPECIFIED;
-        }
+        m_cErrorString = "InputPicture: unsupported width cstride combination for 2nd plane";
+        return VVENC_ERR_UNSPECIFIED;
+      }
 
-        if( pcYUVBuffer->planes[2].stride && pcYUVBuffer->planes[0].width > pcYUVBuffer->planes[2].stride )
-        {
-          m_cErrorString = "InputPicture: unsupported width cstride combination for 3rd plane";
-          return VVENC_ERR_UNSPECIFIED;
-        }
+      if( pcYUVBuffer->planes[2].stride && pcYUVBuffer->planes[0].width > pcYUVBuffer->planes[2].stride )
+      {
+        m_cErrorString = "InputPicture: unsupported width cstride combination for 3rd plane";
+        return VVENC_ERR_UNSPECIFIED;
       }
-      else
+    }
+    else
+    {
+      if( pcYUVBuffer->planes[1].stride && pcYUVBuffer->planes[0].width/2 > pcYUVBuffer->planes[1].stride )
       {
-        if( pcYUVBuffer->planes[1].stride && pcYUVBuffer->planes[0].width/2 > pcYUVBuffer->planes[1].stride )
-        {
-          m_cErrorString = "InputPicture: unsupported width cstride combination for 2nd plane";
-          return VVENC_ERR_UNSPECIFIED;
-        }
+        m_cErrorString = "InputPicture: unsupported width cstride combination for 2nd plane";
+        return VVENC_ERR_UNSPECIFIED;
+      }
 
-        if( pcYUVBuffer->planes[2].stride && pcYUVBuffer->planes[0].width/2 > pcYUVBuffer->planes[2].stride )
-        {
-          m_cErrorString = "InputPicture: unsupported width cstride combination for 3rd plane";
-          return VVENC_ERR_UNSPECIFIED;
-        }
+      if( pcYUVBuffer->planes[2].stride && pcYUVBuffer->planes[0].width/2 > pcYUVBuffer->planes[2].stride )
+      {
+        m_cErrorString = "InputPicture: unsupported width cstride combination for 3rd plane";
+        return VVENC_ERR_UNSPECIFIED;
       }
     }
+  }
+
+  return VVENC_OK;
+}
+
+int VVEncImpl::xEncode( vvencYUVBuffer* pcYUVBuffer, vvencAccessUnit* pcAccessUnit, AccessUnitList& cAu, bool* pbEncodeDone )
+{
+  std::unique_lock<std::mutex> lock( m_encLibMutex );
+
+  bool bFlush = false;
+  if( pcYUVBuffer )
+  {
+    if( m_eState == INTERNAL_STATE_FLUSHING ) { m_cErrorString = "encoder already received flush indication, please reinit."; return VVENC_ERR_RESTART_REQUIRED; }
+
+    int iRet = xVerifyInputBuffer( pcYUVBuffer );
+    if( iRet != VVENC_OK )
+    {
+      return iRet;
+    }
 
     if ( ! xConvertVerifyYUVBuffer( pcYUVBuffer ) )
     {     
@@ -369,7 +773,6 @@ int VVEncImpl::encode( vvencYUVBuffer* pcYUVBuffer, vvencAccessUnit* pcAccessUni
   }
   *pbEncodeDone  = false;
 
-  AccessUnitList cAu;
 #if HANDLE_EXCEPTION
   try
 #endif
@@ -426,31 +829,14 @@ int VVEncImpl::encode( vvencYUVBuffer* pcYUVBuffer, vvencAccessUnit* pcAccessUni
     }
   }
 
-  /* copy output AU */
-  if ( !cAu.empty() )
-  {
-    int sizeAu = xGetAccessUnitsSize( cAu );
-    if( pcAccessUnit->payloadSize < sizeAu )
-    {
-      std::stringstream css;
-      css << "vvencAccessUnit payload size is too small to store data. (payload size: " << pcAccessUnit->payloadSize << ", needed " << sizeAu << ")";
-      m_cErrorString =css.str();
-      return VVENC_NOT_ENOUGH_MEM;
-    }
-
-    iRet = xCopyAu( *pcAccessUnit, cAu  );
-  }
-
-#if defined( __linux__ ) && defined( __GLIBC__ )
-  malloc_trim(0);   // free unused heap memory
-#endif
-
-  return iRet;
+  return VVENC_OK;
 }
 
 int VVEncImpl::getParameterSets( vvencAccessUnit *pcAccessUnit )
 {
   if( !m_bInitialized )                      { return VVENC_ERR_INITIALIZE; }
+
+  std::unique_lock<std::mutex> lock( m_encLibMutex );
   if( m_eState == INTERNAL_STATE_FINALIZED ) { m_cErrorString = "encoder already flushed, please reinit."; return VVENC_ERR_RESTART_REQUIRED; }
 
   if( !pcAccessUnit )
@@ -529,13 +915,14 @@ const char* VVEncImpl::getErrorMsg( int nRet )
   case VVENC_ERR_INITIALIZE:       return vvencErrorMsg[2]; break;
   case VVENC_ERR_ALLOCATE:         return vvencErrorMsg[3]; break;
   case VVENC_NOT_ENOUGH_MEM:       return vvencErrorMsg[4]; break;
-  case VVENC_ERR_PARAMETER:        return vvencErrorMsg[5]; break;
-  case VVENC_ERR_NOT_SUPPORTED:    return vvencErrorMsg[6]; break;
-  case VVENC_ERR_RESTART_REQUIRED: return vvencErrorMsg[7]; break;
-  case VVENC_ERR_CPU:              return vvencErrorMsg[8]; break;
-  default:                         return vvencErrorMsg[9]; break;
+  case VVENC_QUEUE_FULL:           return vvencErrorMsg[5]; break;
+  case VVENC_ERR_PARAMETER:        return vvencErrorMsg[6]; break;
+  case VVENC_ERR_NOT_SUPPORTED:    return vvencErrorMsg[7]; break;
+  case VVENC_ERR_RESTART_REQUIRED: return vvencErrorMsg[8]; break;
+  case VVENC_ERR_CPU:              return vvencErrorMsg[9]; break;
+  default:                         return vvencErrorMsg[10]; break;
   }
-  return vvencErrorMsg[9];
+  return vvencErrorMsg[10];
 }
 
 int VVEncImpl::setAndRetErrorMsg( int iRet )
@@ -558,6 +945,33 @@ int VVEncImpl::getNumTrailFrames() const
   return m_cVVEncCfg.m_trailFrames;
 }
 
+int VVEncImpl::getCheckpointInfo( vvencCheckpointInfo& rcInfo ) const
+{
+  if( !m_bInitialized || !m_pEncLib ){ return VVENC_ERR_INITIALIZE; }
+
+  m_pEncLib->getCheckpointInfo( rcInfo.pass, rcInfo.firstFrame, rcInfo.firstInputFrame, rcInfo.bitstreamSize );
+  return VVENC_OK;
+}
+
+int VVEncImpl::setCpuBudget( int numThreads )
+{
+  if( !m_bInitialized || !m_pEncLib ){ return VVENC_ERR_INITIALIZE; }
+  if( numThreads < 0 )
+  {
+    m_cErrorString = "setCpuBudget: number of threads must not be negative";
+    return VVENC_ERR_PARAMETER;
+  }
+  if( m_cVVEncCfg.m_numThreads <= 0 )
+  {
+    m_cErrorString = "setCpuBudget: not supported without multi-threading";
+    return VVENC_ERR_NOT_SUPPORTED;
+  }
+
+  // no need to lock the EncLib, the budget is picked up by the encoding thread
+  m_pEncLib->setCpuBudget( numThreads );
+  return VVENC_OK;
+}
+
 int VVEncImpl::printSummary() const
 {
   if( !m_bInitialized ){ return -1; }
@@ -611,6 +1025,34 @@ bool VVEncImpl::xConvertVerifyYUVBuffer( vvencYUVBuffer* pcYUVBuffer )
   return (dstSum != 0) ? false : true;
 }
 
+int VVEncImpl::xWriteCheckpoint( const vvenc::AccessUnitList& rcAuList )
+{
+  // the checkpoint refers to the bitstream up to this access unit
+  if( ! rcAuList.checkpointData.empty() )
+  {
+#if HANDLE_EXCEPTION
+    try
+#endif
+    {
+      m_pEncLib->writeCheckpoint( rcAuList.checkpointData, m_bitstreamSize );
+    }
+#if HANDLE_EXCEPTION
+    catch( std::exception& e )
+    {
+      msg.log( VVENC_ERROR, "\n%s\n", e.what() );
+      m_cErrorString = e.what();
+      return VVENC_ERR_UNSPECIFIED;
+    }
+#endif
+  }
+
+  if( rcAuList.rendition == 0 )
+  {
+    m_bitstreamSize += xGetAccessUnitsSize( rcAuList );
+  }
+  return VVENC_OK;
+}
+
 int VVEncImpl::xGetAccessUnitsSize( const vvenc::AccessUnitList& rcAuList )
 {
   uint32_t sizeSum = 0;
@@ -633,7 +1075,7 @@ int VVEncImpl::xGetAccessUnitsSize( const vvenc::AccessUnitList& rcAuList )
       {
         sizeSum += 3;
       }
-      sizeSum += uint32_t(nalu.m_nalUnitData.str().size());
+      sizeSum += uint32_t(nalu.m_nalUnitData.size());
     }
   }
 
@@ -670,7 +1112,7 @@ int VVEncImpl::xCopyAu( vvencAccessUnit& rcAccessUnit, const vvenc::AccessUnitLi
       {
         size += 3;
       }
-      size += uint32_t(nalu.m_nalUnitData.str().size());
+      size += uint32_t(nalu.m_nalUnitData.size());
       sizeSum += size;
       annexBsizes.push_back( size );
 
@@ -731,8 +1173,8 @@ int VVEncImpl::xCopyAu( vvencAccessUnit& rcAccessUnit, const vvenc::AccessUnitLi
         ::memcpy( rcAccessUnit.payload + iUsedSize, reinterpret_cast<const char*>(start_code_prefix+1), 3 );
         iUsedSize += 3;
       }
-      uint32_t nalDataSize = uint32_t(nalu.m_nalUnitData.str().size()) ;
-      ::memcpy( rcAccessUnit.payload + iUsedSize, nalu.m_nalUnitData.str().c_str() , nalDataSize );
+      uint32_t nalDataSize = uint32_t(nalu.m_nalUnitData.size()) ;
+      ::memcpy( rcAccessUnit.payload + iUsedSize, nalu.m_nalUnitData.data(), nalDataSize );
       iUsedSize += nalDataSize;
 
       if( nalu.m_nalUnitType == VVENC_NAL_UNIT_CODED_SLICE_IDR_W_RADL ||
@@ -760,6 +1202,15 @@ int VVEncImpl::xCopyAu( vvencAccessUnit& rcAccessUnit, const vvenc::AccessUnitLi
     rcAccessUnit.refPic          = rcAuList.refPic;
     rcAccessUnit.temporalLayer   = rcAuList.temporalLayer;
     rcAccessUnit.poc             = rcAuList.poc;
+    rcAccessUnit.rendition       = rcAuList.rendition;
+    rcAccessUnit.qualityValid    = rcAuList.qualityValid;
+    rcAccessUnit.psnr[0]         = rcAuList.psnr[COMP_Y];
+    rcAccessUnit.psnr[1]         = rcAuList.psnr[COMP_Cb];
+    rcAccessUnit.psnr[2]         = rcAuList.psnr[COMP_Cr];
+    rcAccessUnit.ssim            = rcAuList.ssim;
+    rcAccessUnit.msSsim          = rcAuList.msSsim;
+    rcAccessUnit.vif             = rcAuList.vif;
+    rcAccessUnit.detail          = rcAuList.detail;
     rcAccessUnit.status          = rcAuList.status;
 #if VVENC_USE_UNSTABLE_API
     rcAccessUnit.userData        = rcAuList.userData;
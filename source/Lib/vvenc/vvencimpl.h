@@ -47,6 +47,10 @@ POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "vvenc/vvencCfg.h"
 #include "vvenc/vvenc.h"
 #include "EncoderLib/EncLib.h"
@@ -59,6 +63,7 @@ static const char * const vvencErrorMsg[] = { "expected behavior",
                                               "encoder not initialized or tried to initialize multiple times",
                                               "internal allocation error",
                                               "allocated memory to small to receive encoded data",
+                                              "input queue full, retry after the next access unit has been delivered",
                                               "inconsistent or invalid parameters",
                                               "unsupported request",
                                               "encoder requires restart",
@@ -100,8 +105,11 @@ public:
   bool isInitialized() const;
 
   int setRecYUVBufferCallback( void *, vvencRecYUVBufferCallback );
+  int setYUVBufferReleaseCallback( void *, vvencYUVBufferReleaseCallback );
+  int setAccessUnitCallback( void *, vvencAccessUnitCallback );
 
   int encode( vvencYUVBuffer* pcYUVBuffer, vvencAccessUnit* pcAccessUnit, bool* pbEncodeDone );
+  int pushFrame( vvencYUVBuffer* pcYUVBuffer );
 
   int getParameterSets( vvencAccessUnit *pcAccessUnit );
 
@@ -113,6 +121,8 @@ public:
 
   int getNumLeadFrames() const;
   int getNumTrailFrames() const;
+  int getCheckpointInfo( vvencCheckpointInfo& rcInfo ) const;
+  int setCpuBudget( int numThreads );
 
   int printSummary() const;
 
@@ -129,9 +139,23 @@ public:
   static int         decodeBitstream( const char* FileName, const char* trcFile, const char* trcRule);
 
 private:
+  // input picture waiting in the queue of the asynchronous encoder
+  struct AsyncInput
+  {
+    vvencYUVBuffer       yuvBuf;                    // buffer passed to the encoder
+    std::vector<int16_t> samples[ VVENC_MAX_NUM_COMP ]; // copy of the input picture, unused for lent buffers
+  };
+
   int xGetAccessUnitsSize( const vvenc::AccessUnitList& rcAuList );
   int xCopyAu( vvencAccessUnit& rcAccessUnit, const AccessUnitList& rcAu );
+  int xWriteCheckpoint( const AccessUnitList& rcAu );
   bool xConvertVerifyYUVBuffer( vvencYUVBuffer* pcYUVBuffer );
+  int xVerifyInputBuffer( const vvencYUVBuffer* pcYUVBuffer );
+  int xEncode( vvencYUVBuffer* pcYUVBuffer, vvencAccessUnit* pcAccessUnit, AccessUnitList& rcAu, bool* pbEncodeDone );
+
+  void xAsyncEncode();
+  int  xAsyncDeliverAu( const AccessUnitList& rcAu );
+  void xAsyncStop( bool abort );
 
 private:
   VVEncInternalState     m_eState               = INTERNAL_STATE_UNINITIALIZED;
@@ -144,6 +168,25 @@ private:
   std::string            m_cEncoderInfo;
 
   EncLib*                m_pEncLib = nullptr;
+  std::mutex             m_encLibMutex;       // serializes the EncLib access of the api and the asynchronous encoder thread
+
+  void*                         m_yuvReleaseCtx  = nullptr;
+  vvencYUVBufferReleaseCallback m_yuvReleaseFunc = nullptr;
+
+  // asynchronous encoding mode
+  void*                   m_auCtx            = nullptr;
+  vvencAccessUnitCallback m_auFunc           = nullptr;
+  std::thread             m_asyncThread;
+  std::mutex              m_asyncMutex;
+  std::condition_variable m_asyncCond;
+  std::deque<AsyncInput*> m_asyncInputQueue;
+  std::vector<AsyncInput*> m_asyncFreeInputs;
+  bool                    m_asyncFlush       = false;
+  bool                    m_asyncAbort       = false;
+  int                     m_asyncRet         = VVENC_OK;
+  vvencAccessUnit         m_asyncAu;
+
+  int64_t                 m_bitstreamSize    = 0;   // bytes of the main stream delivered so far, stored with a checkpoint
 
   MsgLog                 msg;
 };
@@ -0,0 +1,372 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/**
+  \file    vvencsegments.cpp
+  \brief   This file contains the segment parallel encoding of the vvenc SDK.
+*/
+
+#include "vvencsegments.h"
+#include "vvencimpl.h"
+
+#include <thread>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "CommonLib/CommonDef.h"
+#include "Utilities/MsgLog.h"
+
+namespace vvenc {
+
+int VVEncSegments::getSegmentConfig( const vvenc_config& config, int totalFrames, int numSegments, int segmentIdx, int qp, vvenc_config& segmentConfig, vvencSegmentInfo& segmentInfo )
+{
+  if( totalFrames <= 0 || numSegments < 1 || config.m_SegmentMode != VVENC_SEG_OFF || config.m_configDone )
+  {
+    return VVENC_ERR_PARAMETER;
+  }
+
+  vvenc_config initCfg = config;
+  initCfg.m_framesToBeEncoded = totalFrames;
+  if( vvenc_init_config_parameter( &initCfg ) )
+  {
+    return VVENC_ERR_PARAMETER;
+  }
+
+  // segments start at key frames and cover at least the MCTF range, a too short last segment is merged into its predecessor
+  const int keyFrameDist = initCfg.m_IntraPeriod > 0 ? initCfg.m_IntraPeriod : initCfg.m_GOPSize;
+  int segmentLen         = std::max( VVENC_MCTF_RANGE, ( totalFrames + numSegments - 1 ) / numSegments );
+  segmentLen             = ( ( segmentLen + keyFrameDist - 1 ) / keyFrameDist ) * keyFrameDist;
+  int numSegs            = ( totalFrames + segmentLen - 1 ) / segmentLen;
+  if( numSegs > 1 && totalFrames - ( numSegs - 1 ) * segmentLen < VVENC_MCTF_RANGE )
+  {
+    numSegs--;
+  }
+  if( segmentIdx < 0 || segmentIdx >= numSegs )
+  {
+    return VVENC_ERR_PARAMETER;
+  }
+
+  segmentInfo.numSegments = numSegs;
+  segmentInfo.firstFrame  = segmentIdx * segmentLen;
+  segmentInfo.numFrames   = segmentIdx == numSegs - 1 ? totalFrames - segmentInfo.firstFrame : segmentLen;
+
+  segmentConfig = config;
+  segmentConfig.m_framesToBeEncoded = segmentInfo.numFrames;
+  if( numSegs > 1 )
+  {
+    segmentConfig.m_SegmentMode = segmentIdx == 0 ? VVENC_SEG_FIRST : ( segmentIdx == numSegs - 1 ? VVENC_SEG_LAST : VVENC_SEG_MID );
+
+    if( initCfg.m_RCTargetBitrate != VVENC_RC_OFF )
+    {
+      // rate control is not available in segment mode, the bit budget is distributed by a common QP
+      segmentConfig.m_RCTargetBitrate = VVENC_RC_OFF;
+      segmentConfig.m_RCMaxBitrate    = 0;
+      segmentConfig.m_RCInitialQP     = 0;
+      segmentConfig.m_RCNumPasses     = 1;
+      segmentConfig.m_RCPass          = -1;
+      segmentConfig.m_LookAhead       = -1;
+      segmentConfig.m_QP              = qp >= 0 ? std::min( qp, MAX_QP ) : initCfg.m_QP;
+    }
+
+    // forcing the 2nd order filter in key frames is not supported in segment mode
+    if( segmentConfig.m_usePerceptQPATempFiltISlice == -1 )
+    {
+      segmentConfig.m_usePerceptQPATempFiltISlice = -2;
+    }
+    else if( segmentConfig.m_usePerceptQPATempFiltISlice == 1 || segmentConfig.m_usePerceptQPATempFiltISlice == 2 )
+    {
+      segmentConfig.m_usePerceptQPATempFiltISlice += 2;
+    }
+  }
+
+  vvenc_config checkCfg = segmentConfig;
+  if( vvenc_init_config_parameter( &checkCfg ) )
+  {
+    return VVENC_ERR_PARAMETER;
+  }
+  segmentInfo.segmentMode     = checkCfg.m_SegmentMode;
+  segmentInfo.firstInputFrame = segmentInfo.firstFrame - checkCfg.m_leadFrames;
+  segmentInfo.numInputFrames  = checkCfg.m_leadFrames + segmentInfo.numFrames + checkCfg.m_trailFrames;
+  if( segmentInfo.firstInputFrame < 0 || segmentInfo.firstInputFrame + segmentInfo.numInputFrames > totalFrames )
+  {
+    return VVENC_ERR_PARAMETER;
+  }
+
+  return VVENC_OK;
+}
+
+int VVEncSegments::getSegmentQP( const vvenc_config& config, int totalFrames, int firstPassQP, uint64_t firstPassBits )
+{
+  vvenc_config initCfg = config;
+  if( totalFrames <= 0 || firstPassQP < 0 || firstPassQP > MAX_QP || firstPassBits == 0 || vvenc_init_config_parameter( &initCfg ) || initCfg.m_RCTargetBitrate == VVENC_RC_OFF )
+  {
+    return VVENC_ERR_PARAMETER;
+  }
+
+  // same rate model as used to derive the base QP from first pass data in the rate control
+  const double targetBits = (double) initCfg.m_RCTargetBitrate * totalFrames * initCfg.m_FrameScale / initCfg.m_FrameRate;
+  const double qp         = firstPassQP - ( 105.0 / 128.0 ) * sqrt( (double) std::max( 1, firstPassQP ) ) * log( targetBits / firstPassBits ) / log( 2.0 );
+
+  return Clip3( 0, MAX_QP, int( floor( qp + 0.5 ) ) );
+}
+
+int VVEncSegments::encode( const vvenc_config& config, int totalFrames, int numSegments, int numParallel, void* ctx,
+                           vvencSegmentInputCallback inputCallback, vvencSegmentOutputCallback outputCallback )
+{
+  if( nullptr == inputCallback || nullptr == outputCallback || numParallel < 1 )
+  {
+    return VVENC_ERR_PARAMETER;
+  }
+
+  vvenc_config segmentCfg;
+  vvencSegmentInfo segmentInfo;
+  int ret = getSegmentConfig( config, totalFrames, numSegments, 0, -1, segmentCfg, segmentInfo );
+  if( ret != VVENC_OK )
+  {
+    return ret;
+  }
+
+  m_cfg            = config;
+  m_totalFrames    = totalFrames;
+  m_numSegments    = segmentInfo.numSegments;
+  m_numParallel    = std::min( numParallel, m_numSegments );
+  m_ctx            = ctx;
+  m_inputCallback  = inputCallback;
+  m_outputCallback = outputCallback;
+
+  vvenc_config initCfg = config;
+  vvenc_init_config_parameter( &initCfg );
+
+  if( m_numSegments > 1 && initCfg.m_RCTargetBitrate != VVENC_RC_OFF )
+  {
+    // first pass over all segments with the initial rate control QP
+    ret = xEncodePass( -1, false );
+    if( ret != VVENC_OK )
+    {
+      return ret;
+    }
+    uint64_t firstPassBits = 0;
+    for( auto& job : m_jobs )
+    {
+      firstPassBits += job.numBits;
+    }
+    const int qp = getSegmentQP( config, totalFrames, m_jobs[ 0 ].cfg.m_QP, firstPassBits );
+    if( qp < 0 )
+    {
+      return qp;
+    }
+    MsgLog msg( config.m_msgCtx, config.m_msgFnc );
+    msg.log( VVENC_DETAILS, "segment parallel encoding: first pass %llu bits at QP %d, using QP %d for %d segments\n", (unsigned long long) firstPassBits, m_jobs[ 0 ].cfg.m_QP, qp, m_numSegments );
+    return xEncodePass( qp, true );
+  }
+
+  return xEncodePass( -1, true );
+}
+
+int VVEncSegments::xEncodePass( int qp, bool output )
+{
+  m_jobs.clear();
+  m_jobs.resize( m_numSegments );
+  for( int i = 0; i < m_numSegments; i++ )
+  {
+    int ret = getSegmentConfig( m_cfg, m_totalFrames, m_numSegments, i, qp, m_jobs[ i ].cfg, m_jobs[ i ].info );
+    if( ret != VVENC_OK )
+    {
+      return ret;
+    }
+    if( m_jobs[ i ].info.numSegments != m_numSegments )
+    {
+      return VVENC_ERR_UNSPECIFIED;
+    }
+  }
+
+  m_nextJob    = 0;
+  m_nextOutput = 0;
+  m_abort      = false;
+
+  std::vector<int>         results( m_numParallel, VVENC_OK );
+  std::vector<std::thread> workers;
+  for( int t = 0; t < m_numParallel; t++ )
+  {
+    workers.emplace_back( [this, t, output, &results]()
+    {
+      int segmentIdx;
+      while( ! m_abort && ( segmentIdx = m_nextJob++ ) < m_numSegments )
+      {
+        const int ret = xEncodeSegment( segmentIdx, output );
+        if( ret != VVENC_OK )
+        {
+          results[ t ] = ret;
+          m_abort      = true;
+        }
+      }
+    } );
+  }
+  for( auto& worker : workers )
+  {
+    worker.join();
+  }
+
+  for( auto ret : results )
+  {
+    if( ret != VVENC_OK )
+    {
+      return ret;
+    }
+  }
+  return VVENC_OK;
+}
+
+int VVEncSegments::xEncodeSegment( int segmentIdx, bool output )
+{
+  SegmentJob& job = m_jobs[ segmentIdx ];
+  const vvenc_config& cfg = job.cfg;
+
+  VVEncImpl encoder;
+  vvenc_config encCfg = cfg;
+  int ret = encoder.init( &encCfg );
+  if( ret == VVENC_OK )
+  {
+    ret = encoder.initPass( 0, nullptr );
+  }
+  if( ret != VVENC_OK )
+  {
+    encoder.uninit();
+    return ret;
+  }
+
+  vvencYUVBuffer yuvBuf;
+  vvenc_YUVBuffer_default( &yuvBuf );
+  vvenc_YUVBuffer_alloc_buffer( &yuvBuf, cfg.m_internChromaFormat, cfg.m_SourceWidth, cfg.m_SourceHeight );
+
+  vvencAccessUnit au;
+  vvenc_accessUnit_default( &au );
+  vvenc_accessUnit_alloc_payload( &au, cfg.m_SourceWidth * cfg.m_SourceHeight );
+
+  int  framesRcvd = 0;
+  bool encDone    = false;
+  while( ret == VVENC_OK && ! encDone && ! m_abort )
+  {
+    vvencYUVBuffer* inputPtr = nullptr;
+    if( framesRcvd < job.info.numInputFrames )
+    {
+      const int frameIdx = job.info.firstInputFrame + framesRcvd;
+      {
+        std::lock_guard<std::mutex> lock( m_inputMutex );
+        if( 0 != m_inputCallback( m_ctx, frameIdx, &yuvBuf ) )
+        {
+          ret = VVENC_ERR_UNSPECIFIED;
+          break;
+        }
+      }
+      // time stamps relative to the start of the sequence
+      yuvBuf.sequenceNumber = frameIdx;
+      yuvBuf.cts            = cfg.m_TicksPerSecond > 0 ? frameIdx * (int64_t) cfg.m_TicksPerSecond * (int64_t) cfg.m_FrameScale / (int64_t) cfg.m_FrameRate : frameIdx;
+      yuvBuf.ctsValid       = true;
+      inputPtr = &yuvBuf;
+      framesRcvd++;
+    }
+
+    ret = encoder.encode( inputPtr, &au, &encDone );
+    if( ret == VVENC_OK && au.payloadUsedSize > 0 )
+    {
+      job.numBits += (uint64_t) au.payloadUsedSize * 8;
+      if( output )
+      {
+        ret = xOutputAU( segmentIdx, au );
+      }
+    }
+  }
+
+  encoder.uninit();
+  vvenc_accessUnit_free_payload( &au );
+  vvenc_YUVBuffer_free_buffer( &yuvBuf );
+
+  if( ret == VVENC_OK && ! m_abort )
+  {
+    ret = xFinishSegment( segmentIdx, output );
+  }
+  return ret;
+}
+
+int VVEncSegments::xOutputAU( int segmentIdx, vvencAccessUnit& au )
+{
+  std::lock_guard<std::mutex> lock( m_outputMutex );
+  if( segmentIdx == m_nextOutput )
+  {
+    return m_outputCallback( m_ctx, &au ) ? VVENC_ERR_UNSPECIFIED : VVENC_OK;
+  }
+
+  // keep the access units until all preceding segments have been delivered
+  m_jobs[ segmentIdx ].pendingAUs.emplace_back();
+  BufferedAU& bufAU = m_jobs[ segmentIdx ].pendingAUs.back();
+  bufAU.au = au;
+  bufAU.payload.assign( au.payload, au.payload + au.payloadUsedSize );
+  return VVENC_OK;
+}
+
+int VVEncSegments::xFinishSegment( int segmentIdx, bool output )
+{
+  std::lock_guard<std::mutex> lock( m_outputMutex );
+  m_jobs[ segmentIdx ].done = true;
+  while( m_nextOutput < m_numSegments && m_jobs[ m_nextOutput ].done )
+  {
+    m_nextOutput++;
+    if( output && m_nextOutput < m_numSegments )
+    {
+      // deliver what the next segment has encoded so far, further access units are delivered directly
+      for( auto& bufAU : m_jobs[ m_nextOutput ].pendingAUs )
+      {
+        bufAU.au.payload     = bufAU.payload.data();
+        bufAU.au.payloadSize = (int) bufAU.payload.size();
+        if( m_outputCallback( m_ctx, &bufAU.au ) )
+        {
+          return VVENC_ERR_UNSPECIFIED;
+        }
+      }
+      m_jobs[ m_nextOutput ].pendingAUs.clear();
+    }
+  }
+  return VVENC_OK;
+}
+
+} // namespace vvenc
@@ -0,0 +1,110 @@
+/* -----------------------------------------------------------------------------
+The copyright in this software is being made available under the Clear BSD
+License, included below. No patent rights, trademark rights and/or 
+other Intellectual Property Rights other than the copyrights concerning 
+the Software are granted under this license.
+
+The Clear BSD License
+
+Copyright (c) 2019-2026, Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. & The VVenC Authors.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted (subject to the limitations in the disclaimer below) provided that
+the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+     * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+
+     * Neither the name of the copyright holder nor the names of its
+     contributors may be used to endorse or promote products derived from this
+     software without specific prior written permission.
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+------------------------------------------------------------------------------------------- */
+/**
+  \file    vvencsegments.h
+  \brief   This file contains the segment parallel encoding of the vvenc SDK.
+*/
+
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+#include "vvenc/vvencCfg.h"
+#include "vvenc/vvenc.h"
+
+namespace vvenc {
+
+/**
+  \ingroup VVEncExternalInterfaces
+  The class VVEncSegments splits a sequence at key frames into segments, which are encoded independently in segment mode by separate encoder instances.
+  The access units are delivered in segment order, which forms one conformant bitstream. With rate control, all segments are encoded with a common QP
+  derived from a first pass over all segments.
+*/
+class VVEncSegments
+{
+public:
+  static int getSegmentConfig( const vvenc_config& config, int totalFrames, int numSegments, int segmentIdx, int qp, vvenc_config& segmentConfig, vvencSegmentInfo& segmentInfo );
+  static int getSegmentQP    ( const vvenc_config& config, int totalFrames, int firstPassQP, uint64_t firstPassBits );
+
+  int encode( const vvenc_config& config, int totalFrames, int numSegments, int numParallel, void* ctx,
+              vvencSegmentInputCallback inputCallback, vvencSegmentOutputCallback outputCallback );
+
+private:
+  struct BufferedAU
+  {
+    vvencAccessUnit      au;
+    std::vector<uint8_t> payload;
+  };
+
+  struct SegmentJob
+  {
+    vvenc_config            cfg;
+    vvencSegmentInfo        info;
+    uint64_t                numBits = 0;
+    bool                    done    = false;
+    std::vector<BufferedAU> pendingAUs;
+  };
+
+  int  xEncodePass     ( int qp, bool output );
+  int  xEncodeSegment  ( int segmentIdx, bool output );
+  int  xOutputAU       ( int segmentIdx, vvencAccessUnit& au );
+  int  xFinishSegment  ( int segmentIdx, bool output );
+
+private:
+  vvenc_config               m_cfg;
+  int                        m_totalFrames    = 0;
+  int                        m_numSegments    = 0;
+  int                        m_numParallel    = 1;
+  void*                      m_ctx            = nullptr;
+  vvencSegmentInputCallback  m_inputCallback  = nullptr;
+  vvencSegmentOutputCallback m_outputCallback = nullptr;
+  std::vector<SegmentJob>    m_jobs;
+  std::mutex                 m_inputMutex;
+  std::mutex                 m_outputMutex;
+  std::atomic<int>           m_nextJob        { 0 };
+  std::atomic<bool>          m_abort          { false };
+  int                        m_nextOutput     = 0;
+};
+
+} // namespace vvenc
@@ -55,6 +55,11 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 #include <string>
 #include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <vector>
 
 #include "CommonLib/AdaptiveLoopFilter.h"
 #include "CommonLib/LoopFilter.h"
@@ -2423,6 +2428,203 @@ static bool check_reco( PelBufferOps* ref, PelBufferOps* opt, unsigned num_cases
   return passed;
 }
 
+static bool check_downsample2x2( PelBufferOps* ref, PelBufferOps* opt, unsigned num_cases )
+{
+  static constexpr int max_width  = 136;
+  static constexpr int max_height = 24;
+  static constexpr int src_stride = 2 * max_width + 8;
+  static constexpr int dst_stride = max_width + 8;
+
+  std::vector<Pel> src( src_stride * 2 * max_height );
+  std::vector<Pel> dst_ref( dst_stride * max_height );
+  std::vector<Pel> dst_opt( dst_stride * max_height );
+
+  bool passed = true;
+
+  for( unsigned bd : { 8, 10 } )
+  {
+    InputGenerator<Pel> g{ bd, /*is_signed=*/false };
+
+    for( int width : { 1, 4, 7, 8, 15, 16, 23, 32, 64, 136 } )
+    {
+      const int height = width > max_height ? max_height : width;
+
+      std::ostringstream sstm_test;
+      sstm_test << "PelBufferOps::downsample2x2" << " bd=" << bd << " w=" << width << " h=" << height;
+      std::cout << "Testing " << sstm_test.str() << std::endl;
+
+      for( unsigned n = 0; n < num_cases; n++ )
+      {
+        std::generate( src.begin(), src.end(), g );
+        std::fill( dst_ref.begin(), dst_ref.end(), 0 );
+        std::fill( dst_opt.begin(), dst_opt.end(), 0 );
+
+        ref->downsample2x2( src.data(), src_stride, dst_ref.data(), dst_stride, width, height );
+        opt->downsample2x2( src.data(), src_stride, dst_opt.data(), dst_stride, width, height );
+
+        // compare the full rows to also catch writes beyond the block width
+        passed = compare_values_2d( sstm_test.str(), dst_ref.data(), dst_opt.data(), height, dst_stride ) && passed;
+      }
+    }
+  }
+
+  return passed;
+}
+
+static bool check_ssd( PelBufferOps* ref, PelBufferOps* opt, unsigned num_cases )
+{
+  static constexpr int max_width  = 300;
+  static constexpr int max_height = 16;
+  static constexpr int stride     = max_width + 8;
+
+  std::vector<Pel> src0( stride * max_height );
+  std::vector<Pel> src1( stride * max_height );
+
+  bool passed = true;
+
+  for( unsigned bd : { 8, 10, 12 } )
+  {
+    InputGenerator<Pel> g{ bd, /*is_signed=*/false };
+
+    for( int width : { 1, 7, 8, 15, 16, 24, 64, 300 } )
+    {
+      const int height = width > max_height ? max_height : width;
+
+      std::ostringstream sstm_test;
+      sstm_test << "PelBufferOps::ssd" << " bd=" << bd << " w=" << width << " h=" << height;
+      std::cout << "Testing " << sstm_test.str() << std::endl;
+
+      for( unsigned n = 0; n < num_cases; n++ )
+      {
+        std::generate( src0.begin(), src0.end(), g );
+        std::generate( src1.begin(), src1.end(), g );
+
+        const uint64_t ssd_ref = ref->ssd( src0.data(), stride, src1.data(), stride, width, height );
+        const uint64_t ssd_opt = opt->ssd( src0.data(), stride, src1.data(), stride, width, height );
+
+        passed = compare_value( sstm_test.str(), ssd_ref, ssd_opt ) && passed;
+      }
+    }
+  }
+
+  return passed;
+}
+
+static bool check_ssimSums4x4( PelBufferOps* ref, PelBufferOps* opt, unsigned num_cases )
+{
+  static constexpr int max_blocks  = 37;
+  static constexpr int stride      = 4 * max_blocks + 8;
+  static constexpr int sums_stride = max_blocks + 3;
+
+  std::vector<Pel> src0( stride * 4 );
+  std::vector<Pel> src1( stride * 4 );
+  std::vector<int> sums_ref( sums_stride * 5 );
+  std::vector<int> sums_opt( sums_stride * 5 );
+
+  bool passed = true;
+
+  for( unsigned bd : { 8, 10, 12 } )
+  {
+    InputGenerator<Pel> g{ bd, /*is_signed=*/false };
+
+    for( int num_blocks : { 1, 2, 3, 4, 5, 8, 13, 37 } )
+    {
+      std::ostringstream sstm_test;
+      sstm_test << "PelBufferOps::ssimSums4x4" << " bd=" << bd << " blocks=" << num_blocks;
+      std::cout << "Testing " << sstm_test.str() << std::endl;
+
+      for( unsigned n = 0; n < num_cases; n++ )
+      {
+        std::generate( src0.begin(), src0.end(), g );
+        std::generate( src1.begin(), src1.end(), g );
+        std::fill( sums_ref.begin(), sums_ref.end(), 0 );
+        std::fill( sums_opt.begin(), sums_opt.end(), 0 );
+
+        ref->ssimSums4x4( src0.data(), stride, src1.data(), stride, num_blocks, sums_ref.data(), sums_stride );
+        opt->ssimSums4x4( src0.data(), stride, src1.data(), stride, num_blocks, sums_opt.data(), sums_stride );
+
+        // compare the full planes to also catch writes beyond the number of blocks
+        passed = compare_values_2d( sstm_test.str(), sums_ref.data(), sums_opt.data(), 5, sums_stride ) && passed;
+      }
+    }
+  }
+
+  return passed;
+}
+
+static bool check_resample( PelBufferOps* ref, PelBufferOps* opt, unsigned num_cases )
+{
+  static constexpr int max_width  = 136;
+  static constexpr int max_height = 24;
+  static constexpr int max_taps   = 48;
+  static constexpr int src_stride = max_width + max_taps + 8;
+  static constexpr int dst_stride = max_width + 8;
+
+  std::vector<Pel>     src( src_stride * ( max_height + max_taps ) );
+  std::vector<Pel>     dst_ref( dst_stride * max_height );
+  std::vector<Pel>     dst_opt( dst_stride * max_height );
+  std::vector<int16_t> coeffs( max_width * max_taps );
+  std::vector<int>     offsets( max_width );
+
+  // coefficients are kept small enough to not overflow the 16 bit intermediate of the horizontal pass
+  InputGenerator<int16_t> coeff_gen{ 10, /*is_signed=*/true };
+  InputGenerator<Pel>     tmp_gen{ 15, /*is_signed=*/true };
+
+  bool passed = true;
+
+  for( unsigned bd : { 8, 10 } )
+  {
+    const ClpRng clpRng{ ( int )bd };
+    InputGenerator<Pel> src_gen{ bd, /*is_signed=*/false };
+
+    for( int numTaps : { 6, 7, 8, 16, 24, 48 } )
+    {
+      for( int width : { 1, 4, 7, 8, 15, 16, 23, 32, 64, 136 } )
+      {
+        const int height = width > max_height ? max_height : width;
+
+        std::ostringstream sstm_test;
+        sstm_test << "PelBufferOps::resample" << " bd=" << bd << " taps=" << numTaps << " w=" << width << " h=" << height;
+        std::cout << "Testing " << sstm_test.str() << std::endl;
+
+        for( unsigned n = 0; n < num_cases; n++ )
+        {
+          std::generate( coeffs.begin(), coeffs.end(), coeff_gen );
+          for( int x = 0; x < max_width; x++ )
+          {
+            offsets[x] = rand() % ( max_width + 8 );
+          }
+
+          std::generate( src.begin(), src.end(), src_gen );
+          std::fill( dst_ref.begin(), dst_ref.end(), 0 );
+          std::fill( dst_opt.begin(), dst_opt.end(), 0 );
+
+          ref->resampleHor( src.data(), src_stride, dst_ref.data(), dst_stride, width, height, offsets.data(), coeffs.data(), numTaps, 10 );
+          opt->resampleHor( src.data(), src_stride, dst_opt.data(), dst_stride, width, height, offsets.data(), coeffs.data(), numTaps, 10 );
+
+          passed = compare_values_2d( sstm_test.str() + " hor", dst_ref.data(), dst_opt.data(), height, dst_stride ) && passed;
+
+          for( int y = 0; y < max_height; y++ )
+          {
+            offsets[y] = rand() % ( max_height + 1 );
+          }
+
+          std::generate( src.begin(), src.end(), tmp_gen );
+          std::fill( dst_ref.begin(), dst_ref.end(), 0 );
+          std::fill( dst_opt.begin(), dst_opt.end(), 0 );
+
+          ref->resampleVer( src.data(), src_stride, dst_ref.data(), dst_stride, width, height, offsets.data(), coeffs.data(), numTaps, 18, clpRng );
+          opt->resampleVer( src.data(), src_stride, dst_opt.data(), dst_stride, width, height, offsets.data(), coeffs.data(), numTaps, 18, clpRng );
+
+          passed = compare_values_2d( sstm_test.str() + " ver", dst_ref.data(), dst_opt.data(), height, dst_stride ) && passed;
+        }
+      }
+    }
+  }
+
+  return passed;
+}
+
 static bool test_PelBufferOps()
 {
   PelBufferOps ref;
@@ -2436,6 +2638,10 @@ static bool test_PelBufferOps()
 
   passed = check_addAvg( &ref, &opt, num_cases ) && passed;
   passed = check_reco( &ref, &opt, num_cases ) && passed;
+  passed = check_downsample2x2( &ref, &opt, num_cases ) && passed;
+  passed = check_resample( &ref, &opt, num_cases ) && passed;
+  passed = check_ssd( &ref, &opt, num_cases ) && passed;
+  passed = check_ssimSums4x4( &ref, &opt, num_cases ) && passed;
 
   return passed;
 }
@@ -3627,6 +3833,428 @@ static bool test_FGAnalyzer()
 
 #endif // ENABLE_SIMD_OPT_FGA
 
+// ====================================================================================================================
+// Kernel micro-benchmarks
+// ====================================================================================================================
+
+struct BenchResult
+{
+  std::string isa;
+  std::string suite;
+  std::string kernel;
+  std::string params;
+  double      medianNs;
+  double      p99Ns;
+  double      minNs;
+  unsigned    batch;
+};
+
+struct BenchSettings
+{
+  unsigned warmup = 20;
+  unsigned runs   = 200;
+};
+
+static BenchSettings            g_benchSettings;
+static std::string              g_benchIsa;
+static std::string              g_benchSuite;
+static std::vector<BenchResult> g_benchResults;
+
+// Times a single kernel invocation. The batch size is calibrated such that one timed sample covers at least
+// ~10 microseconds, so the timer resolution does not dominate the measurement of small blocks.
+template<typename F>
+static void bench_kernel( const std::string& kernel, const std::string& params, F fn )
+{
+  using Clock = std::chrono::steady_clock;
+  static constexpr int64_t minSampleNs = 10000;
+
+  unsigned batch = 1;
+  while( batch < ( 1u << 20 ) )
+  {
+    const auto start = Clock::now();
+    for( unsigned i = 0; i < batch; i++ )
+    {
+      fn();
+    }
+    const int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - start ).count();
+    if( elapsed >= minSampleNs )
+    {
+      break;
+    }
+    batch <<= 1;
+  }
+
+  for( unsigned w = 0; w < g_benchSettings.warmup; w++ )
+  {
+    for( unsigned i = 0; i < batch; i++ )
+    {
+      fn();
+    }
+  }
+
+  const unsigned runs = std::max( 1u, g_benchSettings.runs );
+  std::vector<double> samples( runs );
+  for( unsigned r = 0; r < runs; r++ )
+  {
+    const auto start = Clock::now();
+    for( unsigned i = 0; i < batch; i++ )
+    {
+      fn();
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - start ).count();
+    samples[r] = double( elapsed ) / batch;
+  }
+
+  std::sort( samples.begin(), samples.end() );
+  const size_t p99Idx = std::min<size_t>( runs - 1, ( size_t ) std::ceil( 0.99 * runs ) - 1 );
+
+  g_benchResults.push_back( { g_benchIsa, g_benchSuite, kernel, params, samples[runs / 2], samples[p99Idx],
+                              samples.front(), batch } );
+}
+
+static std::string bench_size( int w, int h )
+{
+  std::ostringstream sstm;
+  sstm << w << "x" << h;
+  return sstm.str();
+}
+
+#if ENABLE_SIMD_OPT_QUANT
+static void bench_DepQuant()
+{
+  DepQuant opt( /*other=*/nullptr, /*enc=*/true, /*useScalingLists=*/false, /*enableOpt=*/true );
+  opt.init();
+
+  InputGenerator<TCoeff> g20{ 20, /*is_signed=*/false };
+  InputGenerator<TCoeff> g12{ 12 };
+
+  DQIntern::Decisions decisions;
+  DQIntern::StateMem state;
+  BinFracBits sigBuf[4][DQIntern::RateEstimator::sm_maxNumSigCtx];
+
+  for( int j = 0; j < 4; ++j )
+  {
+    state.rdCost[j]              = DQIntern::rdCostInit >> 1;
+    state.ctx.sig[j]             = j;
+    state.ctx.cff[j]             = 1 + j;
+    state.numSig[j]              = j & 1;
+    state.refSbbCtxId[j]         = -1;
+    state.remRegBins[j]          = 4;
+    state.m_goRicePar[j]         = 0;
+    state.m_goRiceZero[j]        = 0;
+    state.sbbBits0[j]            = g20();
+    state.sbbBits1[j]            = g20();
+    state.m_sigFracBitsArray[j]  = sigBuf[j];
+    for( int k = 0; k < DQIntern::RateEstimator::sm_maxNumSigCtx; ++k )
+    {
+      sigBuf[j][k].intBits[0] = g20();
+      sigBuf[j][k].intBits[1] = g20();
+    }
+  }
+  state.cffBitsCtxOffset = 1;
+  std::generate( state.cffBits1, state.cffBits1 + DQIntern::RateEstimator::sm_maxNumGtxCtx + 3, g20 );
+
+  for( DQIntern::ScanPosType spt : { DQIntern::SCAN_ISCSBB, DQIntern::SCAN_SOCSBB, DQIntern::SCAN_EOCSBB } )
+  {
+    const char* sptStr = spt == DQIntern::SCAN_ISCSBB ? "ISC_SBB" : spt == DQIntern::SCAN_SOCSBB ? "SOC_SBB" : "EOC_SBB";
+    bench_kernel( "checkAllRdCostsOdd1", std::string( "scanPosType=" ) + sptStr, [&]
+    {
+      for( int j = 0; j < 4; ++j )
+      {
+        decisions.rdCost[j] = DQIntern::rdCostInit >> 2;
+      }
+      opt.m_checkAllRdCostsOdd1( spt, 4711, 815, decisions, state );
+    } );
+  }
+
+  DQIntern::Rom rom;
+  rom.init();
+  std::vector<TCoeff> tCoeff( 8192 );
+  std::generate( tCoeff.begin(), tCoeff.end(), g12 );
+
+  for( int size : { 4, 8, 16, 32 } )
+  {
+    DQIntern::TUParameters tuPars( rom, size, size, CH_L );
+    bench_kernel( "xFindFirstTestPos", bench_size( size, size ), [&]
+    {
+      int pos = size * size - 1;
+      opt.m_findFirstPos( pos, tCoeff.data(), tuPars, 1 << 10, false, 32, 32 );
+    } );
+  }
+}
+#endif // ENABLE_SIMD_OPT_QUANT
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+static void bench_IntraPred()
+{
+  IntraPrediction opt{ /*enableOpt=*/true };
+
+  ClpRng clpRng{ 10 };
+  InputGenerator<Pel> refGen{ 10, /*is_signed=*/false };
+
+  std::vector<Pel> refMain( 2 * MAX_CU_SIZE + 3 + 33 * MAX_REF_LINE_IDX );
+  std::vector<Pel> dstBuf( MAX_CU_SIZE * MAX_CU_SIZE );
+  std::generate( refMain.begin(), refMain.end(), refGen );
+
+  for( int size : { 4, 8, 16, 32, 64 } )
+  {
+    bench_kernel( "IntraPredAngleLuma", bench_size( size, size ) + " useCubic=true", [&]
+    {
+      opt.IntraPredAngleLuma( dstBuf.data(), MAX_CU_SIZE, refMain.data(), size, size, 29, 29, nullptr, true, clpRng );
+    } );
+  }
+}
+#endif // ENABLE_SIMD_OPT_INTRAPRED
+
+#if ENABLE_SIMD_TRAFO
+static void bench_TCoeffOps()
+{
+  TCoeffOps opt;
+  opt.initTCoeffOps( /*enableOpt=*/true );
+
+  static constexpr size_t bufSize = MAX_CU_SIZE * MAX_CU_SIZE;
+
+  Pel          *src  = ( Pel* )          xMalloc( Pel,          bufSize );
+  TCoeff       *coef = ( TCoeff* )       xMalloc( TCoeff,       bufSize );
+  TCoeff       *dst  = ( TCoeff* )       xMalloc( TCoeff,       bufSize );
+  TMatrixCoeff *mat  = ( TMatrixCoeff* ) xMalloc( TMatrixCoeff, bufSize );
+
+  InputGenerator<Pel>          resiGen{ 11 };
+  InputGenerator<TCoeff>       coefGen{ 16 };
+  TrafoGenerator<TMatrixCoeff> trafoGen{ 8 };
+  std::generate_n( src,  bufSize, resiGen );
+  std::generate_n( coef, bufSize, coefGen );
+  std::generate_n( mat,  bufSize, trafoGen );
+
+  for( int size : { 8, 16, 32, 64 } )
+  {
+    bench_kernel( "cpyCoeff8", bench_size( size, size ), [&] { opt.cpyCoeff8( src, MAX_CU_SIZE, dst, size, size ); } );
+    bench_kernel( "roundClip8", bench_size( size, size ), [&]
+    {
+      opt.roundClip8( dst, size, size, size, INT16_MIN, INT16_MAX, 1 << 10, 11 );
+    } );
+  }
+
+  for( unsigned idx = 0; idx < 5; idx++ )
+  {
+    const unsigned trSize = 4 << idx;
+    const unsigned lines  = std::min( 32u, trSize );
+    bench_kernel( "fastInvCore", "trSize=" + std::to_string( trSize ), [&]
+    {
+      opt.fastInvCore[idx]( mat, coef, dst, lines, lines, trSize );
+    } );
+    bench_kernel( "fastFwdCore_2D", "trSize=" + std::to_string( trSize ), [&]
+    {
+      opt.fastFwdCore_2D[idx]( mat, coef, dst, lines, lines, trSize, 9 );
+    } );
+  }
+
+  xFree( src );
+  xFree( coef );
+  xFree( dst );
+  xFree( mat );
+}
+#endif // ENABLE_SIMD_TRAFO
+
+#if ENABLE_SIMD_OPT_MCTF
+static void bench_MCTF()
+{
+  MCTF opt{ /*enableOpt=*/true };
+
+  static constexpr int bitDepth = 10;
+  static constexpr int stride   = 128;
+  InputGenerator<Pel> gen{ bitDepth, /*is_signed=*/false };
+
+  std::vector<Pel> org( stride * 80 );
+  std::vector<Pel> buf( stride * 80 );
+  std::generate( org.begin(), org.end(), gen );
+  std::generate( buf.begin(), buf.end(), gen );
+  const Pel* bufOff = buf.data() + 3 * stride + 3;
+
+  for( int size : { 8, 16, 32, 64 } )
+  {
+    bench_kernel( "motionErrorLumaInt8", bench_size( size, size ), [&]
+    {
+      opt.m_motionErrorLumaInt8( org.data(), stride, buf.data(), stride, size, size, INT_MAX );
+    } );
+    bench_kernel( "motionErrorLumaFrac8", bench_size( size, size ), [&]
+    {
+      opt.m_motionErrorLumaFrac8[0]( org.data(), stride, bufOff, stride, size, size, MCTF::m_interpolationFilter8[5],
+                                     MCTF::m_interpolationFilter8[11], bitDepth, INT_MAX );
+    } );
+    bench_kernel( "motionErrorLumaFrac8 lowRes", bench_size( size, size ), [&]
+    {
+      opt.m_motionErrorLumaFrac8[1]( org.data(), stride, bufOff, stride, size, size, MCTF::m_interpolationFilter4[5],
+                                     MCTF::m_interpolationFilter4[11], bitDepth, INT_MAX );
+    } );
+  }
+
+  static constexpr int numRefs = 4;
+  const double refStr[2 * VVENC_MCTF_RANGE] = { 0.84375, 0.6, 0.4286, 0.3333, 0.2727, 0.2308,
+                                                0.84375, 0.6, 0.4286, 0.3333, 0.2727, 0.2308 };
+  std::vector<int> verror( 2 * VVENC_MCTF_RANGE, 1 << 6 );
+  std::vector<Pel> corrected( numRefs * 64 * 64 + 64 );
+  std::generate( corrected.begin(), corrected.end(), gen );
+  std::vector<const Pel*> correctedPics( 2 * VVENC_MCTF_RANGE );
+  std::vector<Pel> dstBuf( stride * 66 );
+  const ClpRng clpRng{ bitDepth };
+
+  for( int size : { 8, 16 } )
+  {
+    for( int i = 0; i < numRefs; i++ )
+    {
+      correctedPics[i] = corrected.data() + i * size * size;
+    }
+    const CompArea blk( COMP_Y, VVENC_CHROMA_420, Area( 0, 0, size, size ) );
+    CPelBuf src( org.data() + stride, stride, size, size );
+    PelBuf  dst( dstBuf.data() + stride, stride, size, size );
+    bench_kernel( "applyBlock", bench_size( size, size ), [&]
+    {
+      opt.m_applyBlock( src, dst, blk, clpRng, correctedPics.data(), numRefs, verror.data(), refStr, 0.4, 2275.0 );
+    } );
+  }
+}
+#endif // ENABLE_SIMD_OPT_MCTF
+
+#if ENABLE_SIMD_OPT_BDOF
+static void bench_InterPred()
+{
+  InterPredInterpolation opt;
+  opt.init( /*enableOpt=*/true );
+
+  static constexpr int bitDepth = 10;
+  InputGenerator<Pel> gen{ bitDepth };
+  InputGenerator<Pel> gen14{ 14 };
+
+  const int shift  = IF_INTERNAL_PREC + 1 - bitDepth;
+  const int offset = ( 1 << ( shift - 1 ) ) + 2 * IF_INTERNAL_OFFS;
+  const ClpRng clpRng{ bitDepth };
+
+  for( int size : { 8, 16 } )
+  {
+    const int srcStride  = size + 2 * BDOF_EXTEND_SIZE + 2;
+    const int gradStride = size + 2 * BDOF_EXTEND_SIZE;
+
+    std::vector<Pel> srcY0 ( srcStride  * ( size + 2 ) + 2 );
+    std::vector<Pel> srcY1 ( srcStride  * ( size + 2 ) + 2 );
+    std::vector<Pel> gradX0( gradStride * ( size + 2 ) + 2 );
+    std::vector<Pel> gradX1( gradStride * ( size + 2 ) + 2 );
+    std::vector<Pel> gradY0( gradStride * ( size + 2 ) + 2 );
+    std::vector<Pel> gradY1( gradStride * ( size + 2 ) + 2 );
+    std::vector<Pel> dstY  ( size * size );
+
+    std::generate( srcY0.begin(),  srcY0.end(),  gen );
+    std::generate( srcY1.begin(),  srcY1.end(),  gen );
+    std::generate( gradX0.begin(), gradX0.end(), gen );
+    std::generate( gradX1.begin(), gradX1.end(), gen );
+    std::generate( gradY0.begin(), gradY0.end(), gen );
+    std::generate( gradY1.begin(), gradY1.end(), gen );
+
+    bench_kernel( "xFpBiDirOptFlow", bench_size( size, size ), [&]
+    {
+      opt.xFpBiDirOptFlow( srcY0.data(), srcY1.data(), gradX0.data(), gradX1.data(), gradY0.data(), gradY1.data(),
+                           size, size, dstY.data(), size, shift, offset, 15, clpRng, bitDepth );
+    } );
+  }
+
+  for( int size : { 8, 16, 32 } )
+  {
+    const int stride = size + 2;
+    std::vector<Pel> src  ( stride * ( size + 2 ) );
+    std::vector<Pel> gradX( stride * ( size + 2 ) );
+    std::vector<Pel> gradY( stride * ( size + 2 ) );
+    std::generate( src.begin(), src.end(), gen14 );
+
+    bench_kernel( "xFpBDOFGradFilter", bench_size( size, size ), [&]
+    {
+      opt.xFpBDOFGradFilter( src.data(), stride, size + 2, size + 2, stride, gradX.data(), gradY.data(), bitDepth );
+    } );
+    bench_kernel( "xFpProfGradFilter", bench_size( size, size ), [&]
+    {
+      opt.xFpProfGradFilter( src.data(), stride, size + 2, size + 2, stride, gradX.data(), gradY.data(), bitDepth );
+    } );
+  }
+}
+#endif // ENABLE_SIMD_OPT_BDOF
+
+// Returns the SIMD levels supported by the current CPU, in ascending order, ending with the default (maximum) level.
+static std::vector<std::string> bench_isa_levels()
+{
+  const std::string maxIsa = vvenc_set_SIMD_extension( "" );
+
+#if ENABLE_SIMD_OPT && defined( TARGET_SIMD_ARM )
+  const std::vector<std::string> candidates = { "SCALAR", "NEON", "SVE", "SVE2" };
+#elif ENABLE_SIMD_OPT && defined( TARGET_SIMD_X86 )
+  const std::vector<std::string> candidates = { "SCALAR", "SSE41", "SSE42", "AVX", "AVX2", "AVX512" };
+#else
+  const std::vector<std::string> candidates = { "SCALAR" };
+#endif
+
+  std::vector<std::string> levels;
+  for( const auto& isa : candidates )
+  {
+    levels.push_back( isa );
+    if( isa == maxIsa )
+    {
+      return levels;
+    }
+  }
+
+  // unknown maximum level (e.g. SIMD-everywhere), only compare against scalar
+  return { "SCALAR", maxIsa };
+}
+
+static void bench_write_text( std::ostream& os )
+{
+  os << std::left << std::setw( 8 ) << "ISA" << std::setw( 12 ) << "suite" << std::setw( 30 ) << "kernel"
+     << std::setw( 26 ) << "params" << std::right << std::setw( 12 ) << "median[ns]" << std::setw( 12 ) << "p99[ns]"
+     << std::setw( 12 ) << "min[ns]" << std::setw( 10 ) << "speedup" << "\n";
+
+  for( const auto& res : g_benchResults )
+  {
+    // speed-up relative to the scalar run of the same kernel
+    double speedup = 0.0;
+    for( const auto& base : g_benchResults )
+    {
+      if( base.isa == "SCALAR" && base.suite == res.suite && base.kernel == res.kernel && base.params == res.params )
+      {
+        speedup = res.medianNs > 0.0 ? base.medianNs / res.medianNs : 0.0;
+        break;
+      }
+    }
+
+    os << std::left << std::setw( 8 ) << res.isa << std::setw( 12 ) << res.suite << std::setw( 30 ) << res.kernel
+       << std::setw( 26 ) << res.params << std::right << std::fixed << std::setprecision( 1 ) << std::setw( 12 )
+       << res.medianNs << std::setw( 12 ) << res.p99Ns << std::setw( 12 ) << res.minNs << std::setprecision( 2 )
+       << std::setw( 10 ) << speedup << "\n";
+  }
+}
+
+static void bench_write_csv( std::ostream& os )
+{
+  os << "isa,suite,kernel,params,median_ns,p99_ns,min_ns,batch\n";
+  for( const auto& res : g_benchResults )
+  {
+    os << res.isa << "," << res.suite << "," << res.kernel << ",\"" << res.params << "\"," << res.medianNs << ","
+       << res.p99Ns << "," << res.minNs << "," << res.batch << "\n";
+  }
+}
+
+static void bench_write_json( std::ostream& os )
+{
+  os << "{\n  \"warmup\": " << g_benchSettings.warmup << ",\n  \"runs\": " << g_benchSettings.runs
+     << ",\n  \"results\": [\n";
+  for( size_t i = 0; i < g_benchResults.size(); i++ )
+  {
+    const auto& res = g_benchResults[i];
+    os << "    { \"isa\": \"" << res.isa << "\", \"suite\": \"" << res.suite << "\", \"kernel\": \"" << res.kernel
+       << "\", \"params\": \"" << res.params << "\", \"median_ns\": " << res.medianNs << ", \"p99_ns\": " << res.p99Ns
+       << ", \"min_ns\": " << res.minNs << ", \"batch\": " << res.batch << " }"
+       << ( i + 1 < g_benchResults.size() ? ",\n" : "\n" );
+  }
+  os << "  ]\n}\n";
+}
+
 struct UnitTestEntry
 {
   std::string name;
@@ -3675,6 +4303,30 @@ static const UnitTestEntry test_suites[] = {
 #endif
 };
 
+struct BenchEntry
+{
+  std::string name;
+  void ( *fn )();
+};
+
+static const BenchEntry bench_suites[] = {
+#if ENABLE_SIMD_OPT_QUANT
+    { "DepQuant", bench_DepQuant },
+#endif
+#if ENABLE_SIMD_OPT_INTRAPRED
+    { "IntraPred", bench_IntraPred },
+#endif
+#if ENABLE_SIMD_TRAFO
+    { "TCoeffOps", bench_TCoeffOps },
+#endif
+#if ENABLE_SIMD_OPT_MCTF
+    { "MCTF", bench_MCTF },
+#endif
+#if ENABLE_SIMD_OPT_BDOF
+    { "InterPred", bench_InterPred },
+#endif
+};
+
 struct UnitTestArgs
 {
   bool isFast = false;
@@ -3682,6 +4334,9 @@ struct UnitTestArgs
   int seed;
   std::string simd;
   std::string testcase;
+  bool bench = false;
+  std::string benchFormat = "text";
+  std::string benchOutput;
 };
 
 static inline std::string get_testcase_help_text()
@@ -3712,7 +4367,12 @@ UnitTestArgs parse_args( int argc, char* argv[] )
     ( "seed", args.seed, "Set random seed for running tests" )
     ( "testcase,t", args.testcase, get_testcase_help_text(), false )
     ( "fast", args.isFast, "Run a fast but less real-world accurate version of the tests", false )
-    ( "SIMD", args.simd, "Test a specific SIMD extension.", false );
+    ( "SIMD", args.simd, "Test a specific SIMD extension.", false )
+    ( "bench", args.bench, "Run kernel micro-benchmarks for all available SIMD extensions instead of the tests", true )
+    ( "bench-warmup", g_benchSettings.warmup, "Number of untimed warmup batches per benchmarked kernel" )
+    ( "bench-runs", g_benchSettings.runs, "Number of timed batches per benchmarked kernel" )
+    ( "bench-format", args.benchFormat, "Benchmark report format: text, csv or json" )
+    ( "bench-output", args.benchOutput, "Write the benchmark report to the given file instead of stdout" );
 
   po::SilentReporter err;
   po::scanArgv( opts, argc, ( const char** )argv, err );
@@ -3730,10 +4390,78 @@ UnitTestArgs parse_args( int argc, char* argv[] )
   return args;
 }
 
+static int run_bench( const UnitTestArgs& args )
+{
+  if( args.benchFormat != "text" && args.benchFormat != "csv" && args.benchFormat != "json" )
+  {
+    std::cout << "unknown benchmark format " << args.benchFormat << "\n\n";
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<std::string> levels = args.simd.empty() ? bench_isa_levels() : std::vector<std::string>{ args.simd };
+
+  for( const auto& isa : levels )
+  {
+    const char* simd = vvenc_set_SIMD_extension( isa.c_str() );
+    if( !simd )
+    {
+      std::cout << isa << " is not supported!\n\n";
+      return EXIT_FAILURE;
+    }
+
+    g_benchIsa = simd;
+    for( const auto& entry : bench_suites )
+    {
+      if( args.testcase == "" || args.testcase == entry.name )
+      {
+        std::cerr << "Benchmarking " << entry.name << " SIMD=" << simd << "\n";
+        g_benchSuite = entry.name;
+        srand( args.seed );
+        entry.fn();
+      }
+    }
+  }
+
+  // restore the default SIMD level
+  vvenc_set_SIMD_extension( levels.back().c_str() );
+
+  std::ofstream file;
+  if( !args.benchOutput.empty() )
+  {
+    file.open( args.benchOutput );
+    if( !file.is_open() )
+    {
+      std::cout << "cannot open " << args.benchOutput << " for writing\n\n";
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream& os = file.is_open() ? file : std::cout;
+
+  if( args.benchFormat == "csv" )
+  {
+    bench_write_csv( os );
+  }
+  else if( args.benchFormat == "json" )
+  {
+    bench_write_json( os );
+  }
+  else
+  {
+    bench_write_text( os );
+  }
+
+  return EXIT_SUCCESS;
+}
+
 int main( int argc, char* argv[] )
 {
   UnitTestArgs args = parse_args( argc, argv );
 
+  if( args.bench )
+  {
+    return run_bench( args );
+  }
+
   const char* simd = vvenc_set_SIMD_extension( args.simd.c_str() );
   if( !simd )
   {
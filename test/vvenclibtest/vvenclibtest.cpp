@@ -55,6 +55,11 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include <tuple>
 #include <unordered_set>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 #include "vvenc/version.h"
 #include "vvenc/vvenc.h"
@@ -73,6 +78,11 @@ int testInvalidInputParams();  // input Buffer does not match
 int testSDKDefaultBehaviour(); // check default behaviour when using in sdk
 int testStringApiInterface();  // check behaviour when using in sdk by using string api
 int testTimestamps();          // check behaviour when using in sdk by using string api
+int testLentInputBuffers();    // check zero-copy input with caller owned buffers
+int testSegmentEncoding();     // check segment parallel encoding
+int testReconfig();            // check reconfiguration while encoding
+int testAsyncEncode();         // check asynchronous encoding with access unit callback
+int testCpuBudget();           // check limiting the worker threads at runtime
 
 int main( int argc, char* argv[] )
 {
@@ -87,12 +97,12 @@ int main( int argc, char* argv[] )
     else
     {
       testId = atoi(argv[1]);
-      printHelp = ( testId < 1 || testId > 6 );
+      printHelp = ( testId < 1 || testId > 11 );
     }
 
     if( printHelp )
     {
-      printf( "venclibtest <test> [1..5]\n");
+      printf( "venclibtest <test> [1..11]\n");
       return -1;
     }
   }
@@ -133,6 +143,32 @@ int main( int argc, char* argv[] )
     testTimestamps();
     break;
   }
+  case 7:
+  {
+    testLentInputBuffers();
+    break;
+  }
+  case 8:
+  {
+    testSegmentEncoding();
+    break;
+  }
+  case 9:
+  {
+    testReconfig();
+    testAsyncEncode();
+    break;
+  }
+  case 10:
+  {
+    testAsyncEncode();
+    break;
+  }
+  case 11:
+  {
+    testCpuBudget();
+    break;
+  }
   default:
     testLibParameterRanges();
     testLibCallingOrder();
@@ -140,6 +176,10 @@ int main( int argc, char* argv[] )
     testSDKDefaultBehaviour();
     testStringApiInterface();
     testTimestamps();
+    testLentInputBuffers();
+    testSegmentEncoding();
+    testReconfig();
+    testCpuBudget();
     break;
   }
 
@@ -1193,6 +1233,711 @@ int testTimestamps()
   return 0;
 }
 
+struct LentBufferPool
+{
+  std::vector<vvencYUVBuffer*>            freeBufs;
+  std::unordered_set<const int16_t*>      lentBufs;
+  std::vector<vvencYUVBuffer*>            allBufs;
+  int                                     numInvalidReleases = 0;
+};
+
+static void releaseLentBuffer( void* ctx, vvencYUVBuffer* yuvBuffer )
+{
+  LentBufferPool* pool = static_cast<LentBufferPool*>( ctx );
+  if( pool->lentBufs.erase( yuvBuffer->planes[0].ptr ) != 1 )
+  {
+    pool->numInvalidReleases++;
+    return;
+  }
+  for( auto buf : pool->allBufs )
+  {
+    if( buf->planes[0].ptr == yuvBuffer->planes[0].ptr )
+    {
+      pool->freeBufs.push_back( buf );
+    }
+  }
+}
+
+static void fillMovingPic( vvencYUVBuffer* pcYuvBuffer, int frame )
+{
+  for( int n = 0; n < VVENC_MAX_NUM_COMP; n++ )
+  {
+    const vvencYUVPlane& plane = pcYuvBuffer->planes[n];
+    for( int y = 0; y < plane.height; y++ )
+    {
+      for( int x = 0; x < plane.width; x++ )
+      {
+        plane.ptr[ y * plane.stride + x ] = ( ( x + 2 * frame ) * 5 + ( y + frame ) * 3 + n * 64 ) & 255;
+      }
+    }
+  }
+}
+
+// encode a moving pattern, either copied from one buffer or lent from a pool of padded buffers, and return the bitstream
+static int encodeLentOrCopied( vvenc_config& c, int framesToEncode, bool lendBuffers, bool padded, std::vector<uint8_t>& bitstream )
+{
+  vvencEncoder *enc = vvenc_encoder_create();
+  if( nullptr == enc )
+    return -1;
+
+  if( 0 != vvenc_encoder_open( enc, &c ) )
+  {
+    vvenc_encoder_close( enc );
+    return -1;
+  }
+
+  LentBufferPool pool;
+  const int poolSize = 64;
+  for( int i = 0; i < poolSize; i++ )
+  {
+    vvencYUVBuffer* yuvBuf = vvenc_YUVBuffer_alloc();
+    if( padded )
+      vvenc_YUVBuffer_alloc_padded_buffer( yuvBuf, c.m_internChromaFormat, c.m_SourceWidth, c.m_SourceHeight );
+    else
+      vvenc_YUVBuffer_alloc_buffer( yuvBuf, c.m_internChromaFormat, c.m_SourceWidth, c.m_SourceHeight );
+    pool.allBufs.push_back( yuvBuf );
+    pool.freeBufs.push_back( yuvBuf );
+  }
+
+  int ret = 0;
+  if( lendBuffers && 0 != vvenc_encoder_set_YUVBufferReleaseCallback( enc, &pool, &releaseLentBuffer ) )
+  {
+    ret = -1;
+  }
+
+  vvencAccessUnit* AU = vvenc_accessUnit_alloc();
+  vvenc_accessUnit_alloc_payload( AU, c.m_SourceWidth*c.m_SourceHeight );
+
+  bool encodeDone = false;
+  int  framesRcvd = 0;
+  while( 0 == ret && !encodeDone )
+  {
+    vvencYUVBuffer* inputPtr = nullptr;
+    if( framesRcvd < framesToEncode )
+    {
+      if( pool.freeBufs.empty() )
+      {
+        // all buffers still referenced by the encoder
+        ret = -1;
+        break;
+      }
+      inputPtr = pool.freeBufs.back();
+      fillMovingPic( inputPtr, framesRcvd );
+      inputPtr->cts      = framesRcvd;
+      inputPtr->ctsValid = true;
+      if( lendBuffers )
+      {
+        pool.freeBufs.pop_back();
+        pool.lentBufs.insert( inputPtr->planes[0].ptr );
+      }
+      framesRcvd++;
+    }
+
+    if( 0 != vvenc_encode( enc, inputPtr, AU, &encodeDone ) )
+    {
+      ret = -1;
+    }
+    else if( AU->payloadUsedSize > 0 )
+    {
+      bitstream.insert( bitstream.end(), AU->payload, AU->payload + AU->payloadUsedSize );
+    }
+  }
+
+  if( 0 == ret && ( !pool.lentBufs.empty() || pool.numInvalidReleases ) )
+  {
+    // all lent buffers have to be returned exactly once after flushing
+    ret = -1;
+  }
+
+  vvenc_encoder_close( enc );
+  vvenc_accessUnit_free( AU, true );
+  for( auto yuvBuf : pool.allBufs )
+  {
+    if( padded )
+      vvenc_YUVBuffer_free_padded_buffer( yuvBuf );
+    else
+      vvenc_YUVBuffer_free_buffer( yuvBuf );
+    vvenc_YUVBuffer_free( yuvBuf, false );
+  }
+  return ret;
+}
+
+int checkLentInputBuffers()
+{
+  for( int usePerceptQPA = 0; usePerceptQPA < 2; usePerceptQPA++ )
+  {
+    vvenc_config c;
+    vvenc_init_default( &c, 176,144, 60, VVENC_RC_OFF, 32, vvencPresetMode::VVENC_FASTER );
+    c.m_internChromaFormat = VVENC_CHROMA_420;
+    c.m_usePerceptQPA      = usePerceptQPA;
+
+    std::vector<uint8_t> copied, lent, lentUnpadded;
+    if( 0 != encodeLentOrCopied( c, 24, false, false, copied )
+     || 0 != encodeLentOrCopied( c, 24, true,  true,  lent )
+     || 0 != encodeLentOrCopied( c, 24, true,  false, lentUnpadded ) )
+    {
+      return -1;
+    }
+
+    // lending must not change the encoding result
+    if( copied.empty() || copied != lent || copied != lentUnpadded )
+    {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int testLentInputBuffers()
+{
+  testfunc( "checkLentInputBuffers", &checkLentInputBuffers, false );
+
+  return 0;
+}
+
+struct SegmentOutput
+{
+  std::vector<uint8_t> bitstream;
+  std::vector<int64_t> cts;
+};
+
+static int readSegmentInput( void*, int frameIdx, vvencYUVBuffer* yuvBuffer )
+{
+  fillMovingPic( yuvBuffer, frameIdx );
+  return 0;
+}
+
+static int writeSegmentOutput( void* ctx, vvencAccessUnit* au )
+{
+  SegmentOutput* out = static_cast<SegmentOutput*>( ctx );
+  out->bitstream.insert( out->bitstream.end(), au->payload, au->payload + au->payloadUsedSize );
+  out->cts.push_back( au->cts );
+  return 0;
+}
+
+// check that all frames are delivered once and that the stitched bitstream does not depend on the number of concurrent segments
+static int checkSegmentOutput( const vvenc_config& c, int totalFrames, int numSegments, SegmentOutput& out )
+{
+  SegmentOutput outParallel;
+  if( 0 != vvenc_encode_segments( &c, totalFrames, numSegments, 1,           &out,         &readSegmentInput, &writeSegmentOutput )
+   || 0 != vvenc_encode_segments( &c, totalFrames, numSegments, numSegments, &outParallel, &readSegmentInput, &writeSegmentOutput ) )
+  {
+    return -1;
+  }
+
+  if( out.bitstream.empty() || out.bitstream != outParallel.bitstream || (int)out.cts.size() != totalFrames )
+  {
+    return -1;
+  }
+
+  std::vector<int64_t> cts = out.cts;
+  std::sort( cts.begin(), cts.end() );
+  const int64_t ticksPerFrame = (int64_t)c.m_TicksPerSecond * c.m_FrameScale / c.m_FrameRate;
+  for( int i = 0; i < totalFrames; i++ )
+  {
+    if( cts[ i ] != i * ticksPerFrame )
+    {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int checkSegmentEncoding()
+{
+  vvenc_config c;
+  vvenc_init_default( &c, 176,144, 60, VVENC_RC_OFF, 32, vvencPresetMode::VVENC_FASTER );
+  c.m_IntraPeriod = 32;
+
+  // 72 frames are split into segments of 32, 32 and 8 frames
+  vvenc_config segCfg;
+  vvencSegmentInfo info;
+  if( 0 != vvenc_get_segment_config( &c, 72, 3, 1, -1, &segCfg, &info )
+      || info.numSegments != 3 || info.segmentMode != VVENC_SEG_MID || info.firstFrame != 32 || info.numFrames != 32
+      || info.firstInputFrame >= info.firstFrame || info.firstInputFrame + info.numInputFrames <= info.firstFrame + info.numFrames )
+  {
+    return -1;
+  }
+  if( 0 == vvenc_get_segment_config( &c, 72, 3, 3, -1, &segCfg, &info ) || 0 == vvenc_get_segment_config( &c, 72, 0, 0, -1, &segCfg, &info ) )
+  {
+    return -1;
+  }
+
+  SegmentOutput out;
+  if( 0 != checkSegmentOutput( c, 72, 3, out ) )
+  {
+    return -1;
+  }
+
+  // with rate control a common QP is derived from a first pass over all segments
+  vvenc_config rc;
+  vvenc_init_default( &rc, 176,144, 60, 200000, VVENC_AUTO_QP, vvencPresetMode::VVENC_FASTER );
+  rc.m_IntraPeriod = 32;
+  if( vvenc_get_segment_qp( &rc, 60, 32, 200000 ) != 32 || vvenc_get_segment_qp( &rc, 60, 32, 400000 ) <= 32 || vvenc_get_segment_qp( &c, 60, 32, 200000 ) >= 0 )
+  {
+    return -1;
+  }
+  SegmentOutput outRC;
+  return checkSegmentOutput( rc, 64, 2, outRC );
+}
+
+int testSegmentEncoding()
+{
+  testfunc( "checkSegmentEncoding", &checkSegmentEncoding, false );
+
+  return 0;
+}
+
+// encode a moving pattern and apply the given changes after reconfigFrame frames, returns the bitstream size or a negative value on error
+static int encodeWithReconfig( const vvenc_config& c, int framesToEncode, int reconfigFrame, const std::function<void( vvenc_config& )>& change )
+{
+  vvencEncoder *enc = vvenc_encoder_create();
+  if( nullptr == enc )
+    return -1;
+
+  vvenc_config initCfg = c;
+  if( 0 != vvenc_encoder_open( enc, &initCfg ) )
+  {
+    vvenc_encoder_close( enc );
+    return -1;
+  }
+
+  vvencYUVBuffer* yuvBuf = vvenc_YUVBuffer_alloc();
+  vvenc_YUVBuffer_alloc_buffer( yuvBuf, c.m_internChromaFormat, c.m_SourceWidth, c.m_SourceHeight );
+  vvencAccessUnit* AU = vvenc_accessUnit_alloc();
+  vvenc_accessUnit_alloc_payload( AU, c.m_SourceWidth*c.m_SourceHeight );
+
+  int  ret        = 0;
+  int  numBytes   = 0;
+  bool encodeDone = false;
+  for( int frame = 0; 0 == ret && !encodeDone; frame++ )
+  {
+    if( frame == reconfigFrame )
+    {
+      vvenc_config newCfg;
+      if( 0 != vvenc_get_config( enc, &newCfg ) )
+      {
+        ret = -1;
+        break;
+      }
+      change( newCfg );
+      if( 0 != vvenc_reconfig( enc, &newCfg ) )
+      {
+        ret = -1;
+        break;
+      }
+      vvenc_config curCfg;
+      if( 0 != vvenc_get_config( enc, &curCfg ) || curCfg.m_QP != newCfg.m_QP || curCfg.m_RCTargetBitrate != newCfg.m_RCTargetBitrate )
+      {
+        ret = -1;
+        break;
+      }
+    }
+
+    vvencYUVBuffer* inputPtr = nullptr;
+    if( frame < framesToEncode )
+    {
+      fillMovingPic( yuvBuf, frame );
+      yuvBuf->cts      = frame;
+      yuvBuf->ctsValid = true;
+      inputPtr = yuvBuf;
+    }
+    if( 0 != vvenc_encode( enc, inputPtr, AU, &encodeDone ) )
+    {
+      ret = -1;
+    }
+    numBytes += AU->payloadUsedSize;
+  }
+
+  vvenc_encoder_close( enc );
+  vvenc_accessUnit_free( AU, true );
+  vvenc_YUVBuffer_free( yuvBuf, true );
+  return ret < 0 ? ret : numBytes;
+}
+
+int checkReconfigQP()
+{
+  for( int numThreads : { 0, 2 } )
+  {
+    vvenc_config c;
+    vvenc_init_default( &c, 176,144, 60, VVENC_RC_OFF, 27, vvencPresetMode::VVENC_FASTER );
+    c.m_internChromaFormat = VVENC_CHROMA_420;
+    c.m_IntraPeriod        = 16;
+    c.m_numThreads         = numThreads;
+
+    const int bytesNone  = encodeWithReconfig( c, 48, -1, []( vvenc_config& ) {} );
+    const int bytesFixed = encodeWithReconfig( c, 48, 16, []( vvenc_config& ) {} );
+    const int bytesQP    = encodeWithReconfig( c, 48, 16, []( vvenc_config& cfg ) { cfg.m_QP = 42; cfg.m_SearchRange = 32; cfg.m_fastInterSearchMode = VVENC_FASTINTERSEARCH_OFF; } );
+    c.m_maxMTTDepth = 2;
+    const int bytesMTT   = encodeWithReconfig( c, 48, 16, []( vvenc_config& cfg ) { cfg.m_maxMTTDepth = 1; } );
+
+    // reconfiguring the same parameters must not change the result, a higher QP for the last two thirds of the sequence has to reduce the rate
+    if( bytesFixed <= 0 || bytesQP <= 0 || bytesMTT <= 0 || bytesNone != bytesFixed || bytesQP >= bytesFixed )
+    {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int checkReconfigRC()
+{
+  vvenc_config c;
+  vvenc_init_default( &c, 176,144, 60, 400000, VVENC_AUTO_QP, vvencPresetMode::VVENC_FASTER );
+  c.m_internChromaFormat = VVENC_CHROMA_420;
+  c.m_IntraPeriod        = 16;
+
+  const int bytesFixed = encodeWithReconfig( c, 64, 16, []( vvenc_config& ) {} );
+  const int bytesLow   = encodeWithReconfig( c, 64, 16, []( vvenc_config& cfg ) { cfg.m_RCTargetBitrate = 100000; cfg.m_RCMaxBitrate = 0; } );
+  if( bytesFixed <= 0 || bytesLow <= 0 || bytesLow >= bytesFixed )
+  {
+    return -1;
+  }
+  return 0;
+}
+
+int checkReconfigInvalid()
+{
+  vvenc_config c;
+  vvenc_init_default( &c, 176,144, 60, VVENC_RC_OFF, 32, vvencPresetMode::VVENC_FASTER );
+  c.m_internChromaFormat = VVENC_CHROMA_420;
+
+  // each of the changes has to be rejected
+  const std::vector<std::function<void( vvenc_config& )>> changes = {
+    []( vvenc_config& cfg ) { cfg.m_numThreads      = 3; },
+    []( vvenc_config& cfg ) { cfg.m_SourceWidth     = 320; },
+    []( vvenc_config& cfg ) { cfg.m_RCTargetBitrate = 100000; },
+    []( vvenc_config& cfg ) { cfg.m_QP              = 64; },
+    []( vvenc_config& cfg ) { cfg.m_maxMTTDepth     = 4; },
+  };
+  for( auto& change : changes )
+  {
+    if( encodeWithReconfig( c, 8, 4, change ) >= 0 )
+    {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int testReconfig()
+{
+  testfunc( "checkReconfigQP",      &checkReconfigQP,      false );
+  testfunc( "checkReconfigRC",      &checkReconfigRC,      false );
+  testfunc( "checkReconfigInvalid", &checkReconfigInvalid, false );
+
+  return 0;
+}
+
+struct AsyncOutput
+{
+  std::mutex              mutex;
+  std::condition_variable cond;
+  std::vector<uint8_t>    bitstream;
+  bool                    done = false;
+  LentBufferPool          pool;
+};
+
+static void receiveAsyncAu( void* ctx, vvencAccessUnit* au )
+{
+  AsyncOutput* out = static_cast<AsyncOutput*>( ctx );
+  std::unique_lock<std::mutex> lock( out->mutex );
+  if( au )
+  {
+    out->bitstream.insert( out->bitstream.end(), au->payload, au->payload + au->payloadUsedSize );
+  }
+  else
+  {
+    out->done = true;
+  }
+  out->cond.notify_all();
+}
+
+static void releaseAsyncLentBuffer( void* ctx, vvencYUVBuffer* yuvBuffer )
+{
+  AsyncOutput* out = static_cast<AsyncOutput*>( ctx );
+  std::unique_lock<std::mutex> lock( out->mutex );
+  releaseLentBuffer( &out->pool, yuvBuffer );
+  out->cond.notify_all();
+}
+
+// encode a moving pattern by pushing the pictures to the asynchronous encoder and return the bitstream collected by the callback
+static int encodeAsync( vvenc_config& c, int framesToEncode, bool lendBuffers, std::vector<uint8_t>& bitstream )
+{
+  vvencEncoder *enc = vvenc_encoder_create();
+  if( nullptr == enc )
+    return -1;
+
+  if( 0 != vvenc_encoder_open( enc, &c ) )
+  {
+    vvenc_encoder_close( enc );
+    return -1;
+  }
+
+  AsyncOutput out;
+  const int poolSize = lendBuffers ? 64 : 1;
+  for( int i = 0; i < poolSize; i++ )
+  {
+    vvencYUVBuffer* yuvBuf = vvenc_YUVBuffer_alloc();
+    vvenc_YUVBuffer_alloc_padded_buffer( yuvBuf, c.m_internChromaFormat, c.m_SourceWidth, c.m_SourceHeight );
+    out.pool.allBufs.push_back( yuvBuf );
+    out.pool.freeBufs.push_back( yuvBuf );
+  }
+
+  int ret = 0;
+  if( VVENC_ERR_NOT_SUPPORTED != vvenc_push_frame( enc, out.pool.allBufs[0] ) )
+  {
+    // not available without access unit callback
+    ret = -1;
+  }
+  if( lendBuffers && 0 != vvenc_encoder_set_YUVBufferReleaseCallback( enc, &out, &releaseAsyncLentBuffer ) )
+  {
+    ret = -1;
+  }
+  if( 0 != vvenc_encoder_set_AccessUnitCallback( enc, &out, &receiveAsyncAu ) )
+  {
+    ret = -1;
+  }
+  bool encodeDone = false;
+  if( VVENC_ERR_NOT_SUPPORTED != vvenc_encode( enc, nullptr, nullptr, &encodeDone ) )
+  {
+    // synchronous encoding not available in asynchronous mode
+    ret = -1;
+  }
+
+  const auto timeout = std::chrono::seconds( 60 );
+  for( int frame = 0; 0 == ret && frame <= framesToEncode; frame++ )
+  {
+    vvencYUVBuffer* inputPtr = nullptr;
+    if( frame < framesToEncode )
+    {
+      std::unique_lock<std::mutex> lock( out.mutex );
+      if( !out.cond.wait_for( lock, timeout, [&]{ return !out.pool.freeBufs.empty(); } ) )
+      {
+        ret = -1;
+        break;
+      }
+      inputPtr = out.pool.freeBufs.back();
+      if( lendBuffers )
+      {
+        out.pool.freeBufs.pop_back();
+        out.pool.lentBufs.insert( inputPtr->planes[0].ptr );
+      }
+    }
+    if( inputPtr )
+    {
+      fillMovingPic( inputPtr, frame );
+      inputPtr->cts      = frame;
+      inputPtr->ctsValid = true;
+    }
+
+    int pushRet = vvenc_push_frame( enc, inputPtr );
+    while( VVENC_QUEUE_FULL == pushRet )
+    {
+      {
+        std::unique_lock<std::mutex> lock( out.mutex );
+        out.cond.wait_for( lock, std::chrono::milliseconds( 10 ) );
+      }
+      pushRet = vvenc_push_frame( enc, inputPtr );
+    }
+    if( 0 != pushRet )
+    {
+      ret = -1;
+    }
+  }
+
+  if( 0 == ret )
+  {
+    std::unique_lock<std::mutex> lock( out.mutex );
+    if( !out.cond.wait_for( lock, timeout, [&]{ return out.done; } ) )
+    {
+      ret = -1;
+    }
+  }
+
+  if( 0 == ret && VVENC_ERR_RESTART_REQUIRED != vvenc_push_frame( enc, out.pool.allBufs[0] ) )
+  {
+    // no input accepted after flushing
+    ret = -1;
+  }
+
+  vvenc_encoder_close( enc );
+
+  if( 0 == ret && ( !out.pool.lentBufs.empty() || out.pool.numInvalidReleases ) )
+  {
+    // all lent buffers have to be returned exactly once
+    ret = -1;
+  }
+
+  bitstream.swap( out.bitstream );
+  for( auto yuvBuf : out.pool.allBufs )
+  {
+    vvenc_YUVBuffer_free_padded_buffer( yuvBuf );
+    vvenc_YUVBuffer_free( yuvBuf, false );
+  }
+  return ret;
+}
+
+int checkAsyncEncode()
+{
+  for( int numThreads : { 0, 2 } )
+  {
+    vvenc_config c;
+    vvenc_init_default( &c, 176,144, 60, VVENC_RC_OFF, 32, vvencPresetMode::VVENC_FASTER );
+    c.m_internChromaFormat = VVENC_CHROMA_420;
+    c.m_numThreads         = numThreads;
+
+    std::vector<uint8_t> sync, async, asyncLent;
+    if( 0 != encodeLentOrCopied( c, 24, false, false, sync )
+     || 0 != encodeAsync( c, 24, false, async )
+     || 0 != encodeAsync( c, 24, true,  asyncLent ) )
+    {
+      return -1;
+    }
+
+    // the asynchronous mode must not change the encoding result
+    if( sync.empty() || sync != async || sync != asyncLent )
+    {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int testAsyncEncode()
+{
+  testfunc( "checkAsyncEncode", &checkAsyncEncode, false );
+
+  return 0;
+}
+
+// encode a moving pattern, changing the cpu budget to budgets[i] before frame i * budgetInterval
+static int encodeWithCpuBudget( const vvenc_config& c, int framesToEncode, int budgetInterval, const std::vector<int>& budgets, std::vector<uint8_t>& bitstream )
+{
+  vvencEncoder *enc = vvenc_encoder_create();
+  if( nullptr == enc )
+    return -1;
+
+  vvenc_config initCfg = c;
+  if( 0 != vvenc_encoder_open( enc, &initCfg ) )
+  {
+    vvenc_encoder_close( enc );
+    return -1;
+  }
+
+  vvencYUVBuffer* yuvBuf = vvenc_YUVBuffer_alloc();
+  vvenc_YUVBuffer_alloc_buffer( yuvBuf, c.m_internChromaFormat, c.m_SourceWidth, c.m_SourceHeight );
+  vvencAccessUnit* AU = vvenc_accessUnit_alloc();
+  vvenc_accessUnit_alloc_payload( AU, c.m_SourceWidth*c.m_SourceHeight );
+
+  int  ret        = 0;
+  bool encodeDone = false;
+  bitstream.clear();
+  for( int frame = 0; 0 == ret && !encodeDone; frame++ )
+  {
+    const int budgetIdx = budgetInterval > 0 && frame % budgetInterval == 0 ? frame / budgetInterval : -1;
+    if( budgetIdx >= 0 && budgetIdx < (int)budgets.size() && 0 != vvenc_set_cpu_budget( enc, budgets[ budgetIdx ] ) )
+    {
+      ret = -1;
+      break;
+    }
+
+    vvencYUVBuffer* inputPtr = nullptr;
+    if( frame < framesToEncode )
+    {
+      fillMovingPic( yuvBuf, frame );
+      yuvBuf->cts      = frame;
+      yuvBuf->ctsValid = true;
+      inputPtr = yuvBuf;
+    }
+    if( 0 != vvenc_encode( enc, inputPtr, AU, &encodeDone ) )
+    {
+      ret = -1;
+    }
+    bitstream.insert( bitstream.end(), AU->payload, AU->payload + AU->payloadUsedSize );
+  }
+
+  vvenc_encoder_close( enc );
+  vvenc_accessUnit_free( AU, true );
+  vvenc_YUVBuffer_free( yuvBuf, true );
+  return ret;
+}
+
+int checkCpuBudget()
+{
+  vvenc_config c;
+  vvenc_init_default( &c, 176,144, 60, VVENC_RC_OFF, 32, vvencPresetMode::VVENC_FASTER );
+  c.m_internChromaFormat = VVENC_CHROMA_420;
+  c.m_numThreads         = 4;
+
+  std::vector<uint8_t> full, limited, adaptive;
+  if( 0 != encodeWithCpuBudget( c, 32, 0, {}, full )
+   || 0 != encodeWithCpuBudget( c, 32, 8, { 4, 1, 3, 0 }, limited ) )
+  {
+    return -1;
+  }
+  c.m_adaptiveThreads = true;
+  if( 0 != encodeWithCpuBudget( c, 32, 8, { 2, 0 }, adaptive ) )
+  {
+    return -1;
+  }
+
+  // without rate control the number of active threads must not change the encoding result
+  if( full.empty() || full != limited || full != adaptive )
+  {
+    return -1;
+  }
+  return 0;
+}
+
+int checkCpuBudgetInvalid()
+{
+  vvenc_config c;
+  vvenc_init_default( &c, 176,144, 60, VVENC_RC_OFF, 32, vvencPresetMode::VVENC_FASTER );
+  c.m_internChromaFormat = VVENC_CHROMA_420;
+  c.m_numThreads         = 2;
+
+  vvencEncoder *enc = vvenc_encoder_create();
+  if( nullptr == enc )
+    return -1;
+
+  int ret = 0;
+  if( VVENC_ERR_INITIALIZE != vvenc_set_cpu_budget( enc, 1 ) )
+  {
+    ret = -1;
+  }
+  if( 0 == ret && 0 == vvenc_encoder_open( enc, &c ) )
+  {
+    if( VVENC_ERR_PARAMETER != vvenc_set_cpu_budget( enc, -1 ) || 0 != vvenc_set_cpu_budget( enc, 8 ) )
+    {
+      ret = -1;
+    }
+  }
+  else
+  {
+    ret = -1;
+  }
+  vvenc_encoder_close( enc );
+
+  // the budget requires multi-threading
+  c.m_numThreads = 0;
+  enc = vvenc_encoder_create();
+  if( nullptr == enc || 0 != vvenc_encoder_open( enc, &c ) || VVENC_ERR_NOT_SUPPORTED != vvenc_set_cpu_budget( enc, 1 ) )
+  {
+    ret = -1;
+  }
+  vvenc_encoder_close( enc );
+  return ret;
+}
+
+int testCpuBudget()
+{
+  testfunc( "checkCpuBudget",        &checkCpuBudget,        false );
+  testfunc( "checkCpuBudgetInvalid", &checkCpuBudgetInvalid, false );
+
+  return 0;
+}
+
 int inputBufTest( vvencYUVBuffer* pcYuvPicture )
 {
   vvenc_config vvencParams;